@@ -0,0 +1,93 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef EIGEN_DIRECT_SOLVER_H
+#define EIGEN_DIRECT_SOLVER_H
+
+#include <algorithm>
+#include <vector>
+
+#include "Eigen/SparseLU"
+
+#include "matrix_class.h"
+
+namespace Math_Group
+{
+/**************************************************************************
+   Task: Sparse direct solver (Eigen::SparseLU) of a Linear_EQS.
+      The column ordering and the symbolic analysis are computed once for
+      the sparsity pattern of the matrix (sparse table and DOF). The
+      numerical factorization is only redone if the matrix entries differ
+      from the ones of the last factorization, e.g. not for a linear
+      problem with constant time step size.
+**************************************************************************/
+class EigenDirectSolver
+{
+public:
+	EigenDirectSolver() : _dof(0), _factorized(false), _n_factorizations(0), _n_solutions(0) {}
+
+	// Solve A x = b. Returns false if the factorization failed.
+	bool solve(const CSparseMatrix& A, const double* b, double* x)
+	{
+		if (A.Dof() != _dof)
+			analyze(A);
+		// Refactorize only if the entries have changed
+		A.GetCCSValues(_entry_index, _A.valuePtr());
+		const double* values = _A.valuePtr();
+		if (!_factorized || !std::equal(values, values + _values.size(), _values.begin()))
+		{
+			_lu.factorize(_A);
+			_factorized = (_lu.info() == Eigen::Success);
+			if (!_factorized)
+				return false;
+			_values.assign(values, values + _values.size());
+			_n_factorizations++;
+		}
+		const long dim = _A.rows();
+		Eigen::Map<const Eigen::VectorXd> bb(b, dim);
+		Eigen::Map<Eigen::VectorXd> xx(x, dim);
+		xx = _lu.solve(bb);
+		_n_solutions++;
+		return true;
+	}
+
+	long numberOfFactorizations() const { return _n_factorizations; }
+	long numberOfSolutions() const { return _n_solutions; }
+
+private:
+	// Ordering and symbolic analysis of the sparsity pattern
+	void analyze(const CSparseMatrix& A)
+	{
+		std::vector<int> col_ptr, row_idx;
+		A.GetCCSPattern(col_ptr, row_idx, _entry_index);
+		const long dim = A.Dim();
+		_A.resize(dim, dim);
+		_A.resizeNonZeros((long)row_idx.size());
+		std::copy(col_ptr.begin(), col_ptr.end(), _A.outerIndexPtr());
+		std::copy(row_idx.begin(), row_idx.end(), _A.innerIndexPtr());
+		std::fill(_A.valuePtr(), _A.valuePtr() + row_idx.size(), 0.0);
+		_lu.analyzePattern(_A);
+		_values.assign(row_idx.size(), 0.0);
+		_dof = A.Dof();
+		_factorized = false;
+	}
+
+	int _dof;
+	std::vector<long> _entry_index;
+	// Entries of the last factorized matrix
+	std::vector<double> _values;
+	bool _factorized;
+	long _n_factorizations;
+	long _n_solutions;
+	Eigen::SparseMatrix<double, Eigen::ColMajor, int> _A;
+	Eigen::SparseLU<Eigen::SparseMatrix<double, Eigen::ColMajor, int>, Eigen::COLAMDOrdering<int> > _lu;
+};
+}
+
+#endif
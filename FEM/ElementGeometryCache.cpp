@@ -0,0 +1,127 @@
+/*! \file ElementGeometryCache.cpp
+    \brief Store the element geometry at the integration points
+
+     \copyright
+      Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+             Distributed under a Modified BSD License.
+             See accompanying file LICENSE.txt or
+             http://www.opengeosys.org/project/license
+*/
+
+#include "ElementGeometryCache.h"
+
+#include <limits>
+
+#include "msh_elem.h"
+
+namespace
+{
+const std::size_t no_entry = std::numeric_limits<std::size_t>::max();
+
+template <typename T>
+void append(std::vector<T>& values, const double* src, const std::size_t n)
+{
+	for (std::size_t i = 0; i < n; i++)
+		values.push_back(static_cast<T>(src[i]));
+}
+
+template <typename T>
+const T* copy(const T* src, double* dest, const std::size_t n)
+{
+	for (std::size_t i = 0; i < n; i++)
+		dest[i] = static_cast<double>(src[i]);
+	return src + n;
+}
+}
+
+namespace FiniteElement
+{
+ElementGeometryCache::ElementGeometryCache(const std::size_t n_elements, const bool single_precision,
+                                           const double max_megabytes)
+    : _single_precision(single_precision), _max_values(std::numeric_limits<std::size_t>::max()), _n_entries(0)
+{
+	Slot empty;
+	empty.elem = NULL;
+	empty.offset[0] = empty.offset[1] = no_entry;
+	empty.n_gp[0] = empty.n_gp[1] = 0;
+	_slots.resize(n_elements, empty);
+
+	if (max_megabytes > 0.0)
+	{
+		const std::size_t value_size = single_precision ? sizeof(float) : sizeof(double);
+		_max_values = static_cast<std::size_t>(max_megabytes * 1024.0 * 1024.0 / value_size);
+	}
+}
+
+bool ElementGeometryCache::restore(const MeshLib::CElem* elem, const int order, const int n_gp, double* determinants,
+                                   double* inv_jacobians, const std::size_t n_inv_jacobians,
+                                   double* grad_shape_functions, const std::size_t n_grad_shape_functions) const
+{
+	const std::size_t id = elem->GetIndex();
+	const int order_id = (order == 2) ? 1 : 0;
+	if (id >= _slots.size())
+		return false;
+	const Slot& slot = _slots[id];
+	if (slot.elem != elem || slot.offset[order_id] == no_entry || slot.n_gp[order_id] != n_gp)
+		return false;
+
+	if (_single_precision)
+	{
+		const float* v = &_values_sp[slot.offset[order_id]];
+		v = copy(v, determinants, n_gp);
+		v = copy(v, inv_jacobians, n_inv_jacobians);
+		copy(v, grad_shape_functions, n_grad_shape_functions);
+	}
+	else
+	{
+		const double* v = &_values[slot.offset[order_id]];
+		v = copy(v, determinants, n_gp);
+		v = copy(v, inv_jacobians, n_inv_jacobians);
+		copy(v, grad_shape_functions, n_grad_shape_functions);
+	}
+	return true;
+}
+
+void ElementGeometryCache::store(const MeshLib::CElem* elem, const int order, const int n_gp,
+                                 const double* determinants, const double* inv_jacobians,
+                                 const std::size_t n_inv_jacobians, const double* grad_shape_functions,
+                                 const std::size_t n_grad_shape_functions)
+{
+	const std::size_t id = elem->GetIndex();
+	const int order_id = (order == 2) ? 1 : 0;
+	if (id >= _slots.size())
+		return;
+	Slot& slot = _slots[id];
+	if (slot.elem != NULL && slot.elem != elem) // another mesh
+		return;
+	if (slot.offset[order_id] != no_entry)
+		return;
+
+	const std::size_t n_values = n_gp + n_inv_jacobians + n_grad_shape_functions;
+	const std::size_t size = _single_precision ? _values_sp.size() : _values.size();
+	if (size + n_values > _max_values)
+		return;
+
+	slot.elem = elem;
+	slot.offset[order_id] = size;
+	slot.n_gp[order_id] = n_gp;
+	if (_single_precision)
+	{
+		append(_values_sp, determinants, n_gp);
+		append(_values_sp, inv_jacobians, n_inv_jacobians);
+		append(_values_sp, grad_shape_functions, n_grad_shape_functions);
+	}
+	else
+	{
+		append(_values, determinants, n_gp);
+		append(_values, inv_jacobians, n_inv_jacobians);
+		append(_values, grad_shape_functions, n_grad_shape_functions);
+	}
+	_n_entries++;
+}
+
+std::size_t ElementGeometryCache::getMemorySize() const
+{
+	return _values.size() * sizeof(double) + _values_sp.size() * sizeof(float) + _slots.size() * sizeof(Slot);
+}
+} // end namespace
@@ -0,0 +1,85 @@
+/*! \file ElementGeometryCache.h
+    \brief Store the element geometry at the integration points, i.e. the
+     determinants and inverses of the Jacobians and the gradients of the shape
+     functions with respect to the global coordinates, to skip their
+     computation in later assemblies.
+
+     \copyright
+      Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+             Distributed under a Modified BSD License.
+             See accompanying file LICENSE.txt or
+             http://www.opengeosys.org/project/license
+*/
+#ifndef OGS_ELEMENTGEOMETRYCACHE_H
+#define OGS_ELEMENTGEOMETRYCACHE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace MeshLib
+{
+class CElem;
+}
+
+namespace FiniteElement
+{
+/*!
+   The geometry of an element does not change during a simulation, so the
+   results of CElement::ComputeGradShapefctInElement can be kept once per
+   element and shape function order. The values of all integration points of
+   an entry are stored contiguously in the order of the work arrays of
+   CElement: determinants, inverse Jacobians, global shape function gradients.
+
+   The determinants are stored without the integration weights and without
+   the element area factor, which are applied by GetGaussData and
+   SetMaterial as before.
+
+   The memory can be limited by storing in single precision and by a maximum
+   size. Elements that do not fit any more are computed as before.
+*/
+class ElementGeometryCache
+{
+public:
+	/*!
+	    \param n_elements        Number of elements of the mesh.
+	    \param single_precision  Store the values as float.
+	    \param max_megabytes     Maximum size of the stored values, unlimited if <= 0.
+	*/
+	ElementGeometryCache(const std::size_t n_elements, const bool single_precision, const double max_megabytes);
+
+	/// Copy the stored values of an element to the given arrays.
+	/// Returns false if the element has not been stored.
+	bool restore(const MeshLib::CElem* elem, const int order, const int n_gp, double* determinants,
+	             double* inv_jacobians, const std::size_t n_inv_jacobians, double* grad_shape_functions,
+	             const std::size_t n_grad_shape_functions) const;
+
+	/// Store the values of an element if the memory limit allows it.
+	void store(const MeshLib::CElem* elem, const int order, const int n_gp, const double* determinants,
+	           const double* inv_jacobians, const std::size_t n_inv_jacobians, const double* grad_shape_functions,
+	           const std::size_t n_grad_shape_functions);
+
+	/// Number of stored element entries
+	std::size_t getNumberOfEntries() const { return _n_entries; }
+	/// Size of the stored values in bytes
+	std::size_t getMemorySize() const;
+
+private:
+	struct Slot
+	{
+		const MeshLib::CElem* elem;
+		/// Offset of the entry for linear [0] and quadratic [1] shape functions
+		std::size_t offset[2];
+		int n_gp[2];
+	};
+	std::vector<Slot> _slots;
+
+	const bool _single_precision;
+	std::size_t _max_values;
+	std::size_t _n_entries;
+
+	std::vector<double> _values;
+	std::vector<float> _values_sp;
+};
+} // end namespace
+
+#endif
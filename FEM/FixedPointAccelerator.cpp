@@ -0,0 +1,233 @@
+/*! \file FixedPointAccelerator.cpp
+    \brief Anderson and Aitken acceleration of fixed point iterations
+
+     \copyright
+      Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+             Distributed under a Modified BSD License.
+             See accompanying file LICENSE.txt or
+             http://www.opengeosys.org/project/license
+*/
+
+#include "FixedPointAccelerator.h"
+
+#if defined(USE_PETSC)
+#include <mpi.h>
+#endif
+
+#include <cmath>
+#include <istream>
+#include <string>
+
+namespace FiniteElement
+{
+FixedPointAccelerator::FixedPointAccelerator(Type type, std::size_t depth, double relaxation)
+    : _type(type), _depth((depth > 0) ? depth : 1), _relaxation(relaxation), _has_old(false), _omega(relaxation)
+{
+}
+
+void FixedPointAccelerator::reset()
+{
+	_has_old = false;
+	_omega = _relaxation;
+	_df.clear();
+	_dg.clear();
+}
+
+bool FixedPointAccelerator::readType(std::istream& in, Type& type, std::size_t& depth)
+{
+	std::string name;
+	in >> name;
+	type = NONE;
+	depth = 1;
+	if (name.find("ANDERSON") != std::string::npos)
+	{
+		long m = 0;
+		in >> m;
+		if (m < 1)
+			return false;
+		type = ANDERSON;
+		depth = static_cast<std::size_t>(m);
+		return true;
+	}
+	if (name.find("AITKEN") != std::string::npos)
+	{
+		type = AITKEN;
+		return true;
+	}
+	return name.empty() || name.find("NONE") != std::string::npos;
+}
+
+/// Inner product over all partitions, so that every partition computes the same weights.
+double FixedPointAccelerator::dot(std::vector<double> const& a, std::vector<double> const& b) const
+{
+	double val = 0.0;
+	for (std::size_t i = 0; i < a.size(); i++)
+		val += a[i] * b[i];
+#if defined(USE_PETSC)
+	double val_global = 0.0;
+	MPI_Allreduce(&val, &val_global, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+	val = val_global;
+#endif
+	return val;
+}
+
+void FixedPointAccelerator::update(std::vector<double> const& x, std::vector<double>& g)
+{
+	if (_has_old && _f_old.size() != x.size())
+		reset();
+	// Safeguard: if the residual grows, the stored iterates are no longer
+	// representative (e.g. a moving saturation front). Restart with a plain relaxed step.
+	if (_has_old && _type != NONE)
+	{
+		double f_norm2 = 0.0;
+		for (std::size_t i = 0; i < x.size(); i++)
+			f_norm2 += (g[i] - x[i]) * (g[i] - x[i]);
+#if defined(USE_PETSC)
+		double f_norm2_global = 0.0;
+		MPI_Allreduce(&f_norm2, &f_norm2_global, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+		f_norm2 = f_norm2_global;
+#endif
+		if (f_norm2 > dot(_f_old, _f_old))
+			reset();
+	}
+	switch (_type)
+	{
+		case AITKEN:
+			updateAitken(x, g);
+			break;
+		case ANDERSON:
+			updateAnderson(x, g);
+			break;
+		default:
+			for (std::size_t i = 0; i < g.size(); i++)
+				g[i] = x[i] + _relaxation * (g[i] - x[i]);
+			break;
+	}
+}
+
+/**************************************************************************
+   Task: Aitken dynamic relaxation (Irons and Tuck)
+         w_k = -w_{k-1} (f_{k-1}, f_k - f_{k-1}) / |f_k - f_{k-1}|^2
+         x_{k+1} = x_k + w_k f_k
+**************************************************************************/
+void FixedPointAccelerator::updateAitken(std::vector<double> const& x, std::vector<double>& g)
+{
+	const std::size_t n = x.size();
+	std::vector<double> f(n);
+	for (std::size_t i = 0; i < n; i++)
+		f[i] = g[i] - x[i];
+
+	if (_has_old)
+	{
+		std::vector<double> df(n);
+		for (std::size_t i = 0; i < n; i++)
+			df[i] = f[i] - _f_old[i];
+		const double df_norm2 = dot(df, df);
+		if (df_norm2 > 0.0)
+			_omega = -_omega * dot(_f_old, df) / df_norm2;
+	}
+	_f_old = f;
+	_has_old = true;
+
+	for (std::size_t i = 0; i < n; i++)
+		g[i] = x[i] + _omega * f[i];
+}
+
+/**************************************************************************
+   Task: Anderson mixing (type II, Walker and Ni, 2011)
+         gamma = argmin |f_k - DF gamma|
+         x_{k+1} = G(x_k) - DG gamma - (1 - beta) (f_k - DF gamma)
+         DF and DG hold the differences of the last residuals f = G(x) - x
+         and of G(x). The least squares problem is solved by a modified
+         Gram-Schmidt QR of DF. The oldest columns are dropped if DF gets
+         rank deficient.
+**************************************************************************/
+void FixedPointAccelerator::updateAnderson(std::vector<double> const& x, std::vector<double>& g)
+{
+	const std::size_t n = x.size();
+	std::vector<double> f(n);
+	for (std::size_t i = 0; i < n; i++)
+		f[i] = g[i] - x[i];
+
+	if (_has_old)
+	{
+		_df.push_back(std::vector<double>(n));
+		_dg.push_back(std::vector<double>(n));
+		std::vector<double>& df = _df.back();
+		std::vector<double>& dg = _dg.back();
+		for (std::size_t i = 0; i < n; i++)
+		{
+			df[i] = f[i] - _f_old[i];
+			dg[i] = g[i] - _g_old[i];
+		}
+		if (_df.size() > _depth)
+		{
+			_df.pop_front();
+			_dg.pop_front();
+		}
+	}
+	_f_old = f;
+	_g_old = g;
+	_has_old = true;
+
+	// QR decomposition of DF
+	std::vector<std::vector<double> > q;
+	std::vector<double> r;
+	std::size_t m = 0;
+	while (!_df.empty())
+	{
+		m = _df.size();
+		q.assign(_df.begin(), _df.end());
+		r.assign(m * m, 0.0);
+		bool rank_deficient = false;
+		for (std::size_t j = 0; j < m; j++)
+		{
+			const double col_norm = std::sqrt(dot(q[j], q[j]));
+			for (std::size_t l = 0; l < j; l++)
+			{
+				const double rlj = dot(q[l], q[j]);
+				r[l * m + j] = rlj;
+				for (std::size_t i = 0; i < n; i++)
+					q[j][i] -= rlj * q[l][i];
+			}
+			const double rjj = std::sqrt(dot(q[j], q[j]));
+			if (!(rjj > 1.0e-10 * col_norm))
+			{
+				rank_deficient = true;
+				break;
+			}
+			r[j * m + j] = rjj;
+			for (std::size_t i = 0; i < n; i++)
+				q[j][i] /= rjj;
+		}
+		if (!rank_deficient)
+			break;
+		_df.pop_front();
+		_dg.pop_front();
+		m = 0;
+	}
+
+	// gamma = R^-1 Q^T f
+	std::vector<double> gamma(m);
+	for (std::size_t j = 0; j < m; j++)
+		gamma[j] = dot(q[j], f);
+	for (std::size_t j = m; j-- > 0;)
+	{
+		for (std::size_t l = j + 1; l < m; l++)
+			gamma[j] -= r[j * m + l] * gamma[l];
+		gamma[j] /= r[j * m + j];
+	}
+
+	for (std::size_t i = 0; i < n; i++)
+	{
+		double f_i = f[i];
+		double g_i = g[i];
+		for (std::size_t j = 0; j < m; j++)
+		{
+			f_i -= _df[j][i] * gamma[j];
+			g_i -= _dg[j][i] * gamma[j];
+		}
+		g[i] = g_i - (1.0 - _relaxation) * f_i;
+	}
+}
+}
@@ -0,0 +1,86 @@
+/*! \file FixedPointAccelerator.h
+    \brief Anderson and Aitken acceleration of fixed point iterations
+     x_{k+1} = G(x_k), used for the Picard iterations of a process and
+     for the staggered coupling of processes.
+
+     \copyright
+      Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+             Distributed under a Modified BSD License.
+             See accompanying file LICENSE.txt or
+             http://www.opengeosys.org/project/license
+*/
+#ifndef OGS_FIXEDPOINTACCELERATOR_H
+#define OGS_FIXEDPOINTACCELERATOR_H
+
+#include <cstddef>
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace FiniteElement
+{
+class FixedPointAccelerator
+{
+public:
+	enum Type
+	{
+		NONE = 0,
+		/// Dynamic relaxation x_{k+1} = x_k + w_k (G(x_k) - x_k) with the Aitken (Irons-Tuck) update of w_k
+		AITKEN,
+		/// Anderson mixing over the last depth iterates
+		ANDERSON
+	};
+
+	/*!
+	    \param type        Acceleration method
+	    \param depth       Number of stored iterates for ANDERSON
+	    \param relaxation  Mixing parameter. It is the relaxation of the first
+	                       step, for ANDERSON it also weights the mixing of
+	                       G(x) and x in every step.
+	*/
+	FixedPointAccelerator(Type type, std::size_t depth, double relaxation);
+	~FixedPointAccelerator() {}
+
+	/// Forget the iteration history, e.g. at the start of a new time step.
+	void reset();
+
+	/*!
+	    Compute the next iterate.
+	    \param x  Current iterate x_k
+	    \param g  Input: G(x_k). Output: the accelerated iterate x_{k+1}.
+	*/
+	void update(std::vector<double> const& x, std::vector<double>& g);
+
+	Type getType() const { return _type; }
+	std::size_t getDepth() const { return _depth; }
+
+	/// Read "NONE", "AITKEN" or "ANDERSON depth" from a keyword line. An
+	/// empty line is NONE. Returns false for an unknown method or a depth
+	/// less than 1.
+	static bool readType(std::istream& in, Type& type, std::size_t& depth);
+
+private:
+	double dot(std::vector<double> const& a, std::vector<double> const& b) const;
+	void updateAitken(std::vector<double> const& x, std::vector<double>& g);
+	void updateAnderson(std::vector<double> const& x, std::vector<double>& g);
+
+	const Type _type;
+	const std::size_t _depth;
+	const double _relaxation;
+
+	/// Residual f = G(x) - x and G(x) of the previous iteration
+	std::vector<double> _f_old;
+	std::vector<double> _g_old;
+	bool _has_old;
+
+	/// Aitken relaxation factor of the previous iteration
+	double _omega;
+
+	/// Differences of residuals and of G(x) of the last iterations (ANDERSON)
+	std::deque<std::vector<double> > _df;
+	std::deque<std::vector<double> > _dg;
+};
+}
+
+#endif
@@ -0,0 +1,194 @@
+/*! \file LocalAssemblyKernels.h
+    \brief Dense kernels for the Gauss point contributions to the local
+     matrices of CFiniteElementStd, with compile time sizes for the common
+     linear elements.
+
+     \copyright
+      Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+             Distributed under a Modified BSD License.
+             See accompanying file LICENSE.txt or
+             http://www.opengeosys.org/project/license
+*/
+#ifndef OGS_LOCALASSEMBLYKERNELS_H
+#define OGS_LOCALASSEMBLYKERNELS_H
+
+#include <cstddef>
+
+namespace FiniteElement
+{
+/*!
+   The local matrices are row major blocks of n x n entries inside a matrix
+   with leading dimension ld. The shape function gradients are stored as in
+   CElement, i.e. d rows of n values.
+
+   The kernels with template arguments N (nodes) and D (dimension) let the
+   compiler unroll and vectorise the loops. The dispatch functions below
+   select them at run time and fall back to the loops with variable sizes
+   for all other elements.
+*/
+namespace LocalAssemblyKernels
+{
+/// Largest number of nodes of an element
+const int max_nodes = 20;
+
+/// A += fac * dN^T K dN, with the d x d material matrix K
+template <int N, int D>
+inline void addGradKGrad(const double fac, const double* dN, const double* K, double* A, const std::size_t ld)
+{
+	double KdN[D * N];
+	for (int k = 0; k < D; k++)
+		for (int j = 0; j < N; j++)
+		{
+			double v = 0.0;
+			for (int l = 0; l < D; l++)
+				v += K[k * D + l] * dN[l * N + j];
+			KdN[k * N + j] = v;
+		}
+	for (int i = 0; i < N; i++)
+	{
+		double* A_i = A + i * ld;
+		for (int k = 0; k < D; k++)
+		{
+			const double b = fac * dN[k * N + i];
+			for (int j = 0; j < N; j++)
+				A_i[j] += b * KdN[k * N + j];
+		}
+	}
+}
+
+inline void addGradKGrad(const int n, const int d, const double fac, const double* dN, const double* K, double* A,
+                         const std::size_t ld)
+{
+	double KdN[3 * max_nodes];
+	for (int k = 0; k < d; k++)
+		for (int j = 0; j < n; j++)
+		{
+			double v = 0.0;
+			for (int l = 0; l < d; l++)
+				v += K[k * d + l] * dN[l * n + j];
+			KdN[k * n + j] = v;
+		}
+	for (int i = 0; i < n; i++)
+	{
+		double* A_i = A + i * ld;
+		for (int k = 0; k < d; k++)
+		{
+			const double b = fac * dN[k * n + i];
+			for (int j = 0; j < n; j++)
+				A_i[j] += b * KdN[k * n + j];
+		}
+	}
+}
+
+/// A += fac * a b^T
+template <int N>
+inline void addOuterProduct(const double fac, const double* a, const double* b, double* A, const std::size_t ld)
+{
+	for (int i = 0; i < N; i++)
+	{
+		double* A_i = A + i * ld;
+		const double fa = fac * a[i];
+		for (int j = 0; j < N; j++)
+			A_i[j] += fa * b[j];
+	}
+}
+
+inline void addOuterProduct(const int n, const double fac, const double* a, const double* b, double* A,
+                            const std::size_t ld)
+{
+	for (int i = 0; i < n; i++)
+	{
+		double* A_i = A + i * ld;
+		const double fa = fac * a[i];
+		for (int j = 0; j < n; j++)
+			A_i[j] += fa * b[j];
+	}
+}
+
+/// A += fac * N (v^T dN), the advection term with the velocity v
+template <int N, int D>
+inline void addShapeVelocityGrad(const double fac, const double* shape, const double* v, const double* dN, double* A,
+                                 const std::size_t ld)
+{
+	double vdN[N];
+	for (int j = 0; j < N; j++)
+	{
+		double s = 0.0;
+		for (int k = 0; k < D; k++)
+			s += v[k] * dN[k * N + j];
+		vdN[j] = s;
+	}
+	addOuterProduct<N>(fac, shape, vdN, A, ld);
+}
+
+inline void addShapeVelocityGrad(const int n, const int d, const double fac, const double* shape, const double* v,
+                                 const double* dN, double* A, const std::size_t ld)
+{
+	double vdN[max_nodes];
+	for (int j = 0; j < n; j++)
+	{
+		double s = 0.0;
+		for (int k = 0; k < d; k++)
+			s += v[k] * dN[k * n + j];
+		vdN[j] = s;
+	}
+	addOuterProduct(n, fac, shape, vdN, A, ld);
+}
+
+//------------------------------------------------------------------------
+// Run time dispatch: lines, triangles, quadrilaterals, tetrahedra, prisms
+// and hexahedra with linear shape functions in 1, 2 or 3 dimensions.
+
+inline void gradKGrad(const int n, const int d, const double fac, const double* dN, const double* K, double* A,
+                      const std::size_t ld)
+{
+	switch (d * 100 + n)
+	{
+		case 102: addGradKGrad<2, 1>(fac, dN, K, A, ld); return;
+		case 202: addGradKGrad<2, 2>(fac, dN, K, A, ld); return;
+		case 203: addGradKGrad<3, 2>(fac, dN, K, A, ld); return;
+		case 204: addGradKGrad<4, 2>(fac, dN, K, A, ld); return;
+		case 302: addGradKGrad<2, 3>(fac, dN, K, A, ld); return;
+		case 303: addGradKGrad<3, 3>(fac, dN, K, A, ld); return;
+		case 304: addGradKGrad<4, 3>(fac, dN, K, A, ld); return;
+		case 306: addGradKGrad<6, 3>(fac, dN, K, A, ld); return;
+		case 308: addGradKGrad<8, 3>(fac, dN, K, A, ld); return;
+		default: addGradKGrad(n, d, fac, dN, K, A, ld);
+	}
+}
+
+inline void outerProduct(const int n, const double fac, const double* a, const double* b, double* A,
+                         const std::size_t ld)
+{
+	switch (n)
+	{
+		case 2: addOuterProduct<2>(fac, a, b, A, ld); return;
+		case 3: addOuterProduct<3>(fac, a, b, A, ld); return;
+		case 4: addOuterProduct<4>(fac, a, b, A, ld); return;
+		case 6: addOuterProduct<6>(fac, a, b, A, ld); return;
+		case 8: addOuterProduct<8>(fac, a, b, A, ld); return;
+		default: addOuterProduct(n, fac, a, b, A, ld);
+	}
+}
+
+inline void shapeVelocityGrad(const int n, const int d, const double fac, const double* shape, const double* v,
+                              const double* dN, double* A, const std::size_t ld)
+{
+	switch (d * 100 + n)
+	{
+		case 102: addShapeVelocityGrad<2, 1>(fac, shape, v, dN, A, ld); return;
+		case 202: addShapeVelocityGrad<2, 2>(fac, shape, v, dN, A, ld); return;
+		case 203: addShapeVelocityGrad<3, 2>(fac, shape, v, dN, A, ld); return;
+		case 204: addShapeVelocityGrad<4, 2>(fac, shape, v, dN, A, ld); return;
+		case 302: addShapeVelocityGrad<2, 3>(fac, shape, v, dN, A, ld); return;
+		case 303: addShapeVelocityGrad<3, 3>(fac, shape, v, dN, A, ld); return;
+		case 304: addShapeVelocityGrad<4, 3>(fac, shape, v, dN, A, ld); return;
+		case 306: addShapeVelocityGrad<6, 3>(fac, shape, v, dN, A, ld); return;
+		case 308: addShapeVelocityGrad<8, 3>(fac, shape, v, dN, A, ld); return;
+		default: addShapeVelocityGrad(n, d, fac, shape, v, dN, A, ld);
+	}
+}
+} // end namespace LocalAssemblyKernels
+} // end namespace FiniteElement
+
+#endif
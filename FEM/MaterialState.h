@@ -0,0 +1,54 @@
+/*! \file MaterialState.h
+    \brief Explicit state for the re-entrant material property functions
+
+     \copyright
+      Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+             Distributed under a Modified BSD License.
+             See accompanying file LICENSE.txt or
+             http://www.opengeosys.org/project/license
+*/
+#ifndef OGS_MATERIALSTATE_H
+#define OGS_MATERIALSTATE_H
+
+/*!
+   The state at which a material property is evaluated.
+
+   The classic property functions take their arguments from the members
+   primary_variable, mode and Fem_Ele_Std of the material objects, which
+   are set before each call. The const overloads taking a MaterialState
+   read only this argument and the material parameters, so that several
+   threads can evaluate the same material object concurrently if its
+   isReentrant() is true.
+
+   The order of the primary variables is the one of the double* variables
+   argument of the classic function, e.g. pressure, temperature and
+   concentration for CFluidProperties.
+*/
+struct MaterialState
+{
+	enum
+	{
+		max_variables = 10
+	};
+
+	MaterialState() : element(-1), gauss_point(-1)
+	{
+		for (int i = 0; i < max_variables; i++)
+			primary_variable[i] = 0.0;
+	}
+
+	/// State with the first n primary variables copied from values
+	explicit MaterialState(const double* values, const int n = 3) : element(-1), gauss_point(-1)
+	{
+		for (int i = 0; i < max_variables; i++)
+			primary_variable[i] = (i < n) ? values[i] : 0.0;
+	}
+
+	double primary_variable[max_variables];
+	/// Element index, -1 if not related to an element
+	long element;
+	/// Gauss point index within the element, -1 for element or node values
+	int gauss_point;
+};
+
+#endif
@@ -15,6 +15,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <set>
 #include <string>
 
 #include <cfloat> // DBL_EPSILON
@@ -74,7 +75,7 @@ using namespace std;
 
 COutput::COutput()
     : GeoInfo(GEOLIB::GEODOMAIN), ProcessInfo(), _id(0), out_amplifier(0.0), m_msh(NULL), nSteps(-1),
-      _new_file_opened(false), dat_type_name("TECPLOT")
+      _new_file_opened(false), _pnt_msh_node(-2), dat_type_name("TECPLOT")
 {
 	tim_type_name = "TIMES";
 	m_pcs = NULL;
@@ -90,7 +91,7 @@ COutput::COutput()
 
 COutput::COutput(size_t id)
     : GeoInfo(GEOLIB::GEODOMAIN), ProcessInfo(), _id(id), out_amplifier(0.0), m_msh(NULL), nSteps(-1),
-      _new_file_opened(false), dat_type_name("TECPLOT")
+      _new_file_opened(false), _pnt_msh_node(-2), dat_type_name("TECPLOT")
 {
 	tim_type_name = "TIMES";
 	m_pcs = NULL;
@@ -1797,7 +1798,9 @@ double COutput::NODWritePLYDataTEC(int number)
 **************************************************************************/
 void COutput::NODWritePNTDataTEC(double time_current, int time_step_number)
 {
-	long msh_node_number(m_msh->GetNODOnPNT(static_cast<const GEOLIB::Point*>(getGeoObj())));
+	if (_pnt_msh_node == -2)
+		_pnt_msh_node = m_msh->GetNODOnPNT(static_cast<const GEOLIB::Point*>(getGeoObj()));
+	const long msh_node_number(_pnt_msh_node);
 	if (msh_node_number < 0) // 11.06.2012. WW
 		return;
 
@@ -3905,6 +3908,109 @@ void COutput::NODWritePointsCombined(double time_current)
 	tec_file.close();
 }
 
+/**************************************************************************
+ FEMLib-Method:
+ Task:   Observation points written column-wise into a single file
+ Use:    Specify $DAT_TYPE as POINTS_CSV
+ **************************************************************************/
+COutputPointGroup::COutputPointGroup(COutput* out, const std::string& file_name)
+    : _file_name(file_name), _file(NULL), _initialised(false)
+{
+	_outputs.push_back(out);
+}
+
+COutputPointGroup::~COutputPointGroup()
+{
+	delete _file;
+}
+
+bool COutputPointGroup::accepts(const COutput& out) const
+{
+	const COutput& first(*_outputs[0]);
+	return out.getProcessType() == first.getProcessType() && out.getFileBaseName() == first.getFileBaseName()
+	       && out._nod_value_vector == first._nod_value_vector;
+}
+
+/**************************************************************************
+ Task: resolve the points to mesh nodes and the variables to processes
+       and value indices, open the file and write the header
+ **************************************************************************/
+bool COutputPointGroup::init()
+{
+	_initialised = true;
+	COutput* first(_outputs[0]);
+	CFEMesh* msh(first->getMesh());
+	if (!msh)
+	{
+		cout << "Warning in COutputPointGroup::init - no MSH data"
+		     << "\n";
+		return false;
+	}
+
+	const std::vector<std::string>& var_names(first->_nod_value_vector);
+	_value_index.resize(var_names.size());
+	first->GetNodeIndexVector(_value_index);
+	for (size_t k = 0; k < var_names.size(); k++)
+	{
+		CRFProcess* pcs;
+		if (first->getProcessType() == FiniteElement::MASS_TRANSPORT)
+			pcs = PCSGet(FiniteElement::MASS_TRANSPORT, var_names[k]);
+		else
+			pcs = first->GetPCS(var_names[k]);
+		if (!pcs || _value_index[k] < 0)
+		{
+			cout << "Warning in COutputPointGroup::init - no PCS data: " << var_names[k] << "\n";
+			return false;
+		}
+		_pcs.push_back(pcs);
+	}
+
+	for (size_t i = 0; i < _outputs.size(); i++)
+		_node_ids.push_back(msh->GetNODOnPNT(static_cast<const GEOLIB::Point*>(_outputs[i]->getGeoObj())));
+
+	_file = new std::ofstream(_file_name.c_str(), ios::out | ios::trunc);
+	if (!_file->good())
+	{
+		cout << "Warning in COutputPointGroup::init - could not open " << _file_name << "\n";
+		return false;
+	}
+	_file->setf(ios::scientific, ios::floatfield);
+	_file->precision(12);
+	*_file << "TIME";
+	for (size_t i = 0; i < _outputs.size(); i++)
+		for (size_t k = 0; k < var_names.size(); k++)
+			*_file << "," << _outputs[i]->getGeoName() << ":" << var_names[k];
+	*_file << "\n";
+	return true;
+}
+
+void COutputPointGroup::write(double time)
+{
+	if (!_initialised)
+		init();
+	if (!_file || !_file->good())
+		return;
+
+	const std::vector<std::string>& var_names(_outputs[0]->_nod_value_vector);
+	*_file << time;
+	for (size_t i = 0; i < _node_ids.size(); i++)
+	{
+		const long node(_node_ids[i]);
+		for (size_t k = 0; k < _pcs.size(); k++)
+		{
+			*_file << ",";
+			if (node < 0) // point outside of the (local) mesh
+				continue;
+			if (var_names[k].find("DELTA") == 0)
+				*_file << _pcs[k]->GetNodeValue(node, 1) - _pcs[k]->GetNodeValue(node, _value_index[k]);
+			else
+				*_file << _pcs[k]->GetNodeValue(node, _value_index[k]);
+		}
+	}
+	*_file << "\n";
+	_file->flush();
+}
+
 /**************************************************************************
 FEMLib-Method:
 Task:
@@ -16,7 +16,9 @@
 #include "GeoInfo.h"
 #include "ProcessInfo.h"
 
+#include <fstream>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #if defined(USE_PETSC) || defined(USE_MPI) //|| defined(other parallel libs)//03.3012. WW
@@ -229,6 +231,9 @@ private:
 	// File status
 	bool _new_file_opened; // WW
 
+	/// mesh node of a POINT output, resolved at the first output (-2: not yet resolved)
+	long _pnt_msh_node;
+
 	// DAT
 	/**
 	 * this attribute stores the output format
@@ -260,4 +265,34 @@ private:
 	void setDataArrayDisp();
 #endif
 };
+
+/**
+ * Observation points with $DAT_TYPE POINTS_CSV that write the same nodal
+ * values of the same process. The points are resolved to mesh nodes once,
+ * and every output call appends one row holding all points to a single CSV
+ * file, which stays open for the whole run.
+ */
+class COutputPointGroup
+{
+public:
+	COutputPointGroup(COutput* out, const std::string& file_name);
+	~COutputPointGroup();
+
+	/// true if out writes the same nodal values of the same process as the group
+	bool accepts(const COutput& out) const;
+	void add(COutput* out) { _outputs.push_back(out); }
+	void write(double time);
+	const std::string& getFileName() const { return _file_name; }
+
+private:
+	bool init();
+
+	std::vector<COutput*> _outputs;
+	std::vector<long> _node_ids; // one per point
+	std::vector<CRFProcess*> _pcs; // one per variable
+	std::vector<int> _value_index; // one per variable
+	std::string _file_name;
+	std::ofstream* _file;
+	bool _initialised;
+};
 #endif // OUTPUT_H
@@ -0,0 +1,207 @@
+/*
+ * SparseMatrixCSR.cpp
+ *
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+
+#include "SparseMatrixCSR.h"
+
+namespace Math_Group
+{
+SparseMatrixCSR::SparseMatrixCSR(std::vector<std::vector<size_t> >& row_columns)
+{
+	const size_t n_rows = row_columns.size();
+	row_ptr.resize(n_rows + 1);
+	row_ptr[0] = 0;
+	for (size_t i = 0; i < n_rows; i++)
+	{
+		std::vector<size_t>& cols = row_columns[i];
+		std::sort(cols.begin(), cols.end());
+		cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+		row_ptr[i + 1] = row_ptr[i] + cols.size();
+	}
+
+	col_idx.resize(row_ptr[n_rows]);
+	for (size_t i = 0; i < n_rows; i++)
+	{
+		std::copy(row_columns[i].begin(), row_columns[i].end(), col_idx.begin() + row_ptr[i]);
+		std::vector<size_t>().swap(row_columns[i]);
+	}
+	row_columns.clear();
+
+	transposed_idx.resize(col_idx.size());
+	for (size_t i = 0; i < n_rows; i++)
+	{
+		for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; k++)
+		{
+			const long kt = (col_idx[k] < n_rows) ? Find(col_idx[k], i) : -1;
+			if (kt < 0)
+			{
+				std::cout << "Error in SparseMatrixCSR: the sparsity pattern is not symmetric at (" << i << ","
+				          << col_idx[k] << ")"
+				          << "\n";
+				abort();
+			}
+			transposed_idx[k] = static_cast<size_t>(kt);
+		}
+	}
+
+	values.assign(col_idx.size(), 0.0);
+}
+
+long SparseMatrixCSR::Find(size_t i, size_t j) const
+{
+	const std::vector<size_t>::const_iterator first = col_idx.begin() + row_ptr[i];
+	const std::vector<size_t>::const_iterator last = col_idx.begin() + row_ptr[i + 1];
+	const std::vector<size_t>::const_iterator it = std::lower_bound(first, last, j);
+	if (it == last || *it != j)
+		return -1;
+	return static_cast<long>(it - col_idx.begin());
+}
+
+double& SparseMatrixCSR::operator()(size_t i, size_t j)
+{
+	const long k = Find(i, j);
+	if (k < 0)
+	{
+		std::cout << "Error in SparseMatrixCSR: entry (" << i << "," << j << ") is not in the sparsity pattern"
+		          << "\n";
+		abort();
+	}
+	return values[k];
+}
+
+double SparseMatrixCSR::operator()(size_t i, size_t j) const
+{
+	const long k = Find(i, j);
+	return (k < 0) ? 0.0 : values[k];
+}
+
+SparseMatrixCSR& SparseMatrixCSR::operator=(double a)
+{
+	std::fill(values.begin(), values.end(), a);
+	return *this;
+}
+
+void SparseMatrixCSR::multiVec(const double* vec_s, double* vec_r, int n_vec) const
+{
+	const long n = static_cast<long>(Rows());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (long i = 0; i < n; i++)
+	{
+		for (int c = 0; c < n_vec; c++)
+			vec_r[c * n + i] = 0.0;
+		for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; k++)
+		{
+			const double a_ij = values[k];
+			const size_t j = col_idx[k];
+			for (int c = 0; c < n_vec; c++)
+				vec_r[c * n + i] += a_ij * vec_s[c * n + j];
+		}
+	}
+}
+
+void SparseMatrixCSR::RowSums(std::vector<double>& sums) const
+{
+	sums.assign(Rows(), 0.0);
+	for (size_t i = 0; i < Rows(); i++)
+		for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; k++)
+			sums[i] += values[k];
+}
+
+void SparseMatrixCSR::Write(std::ostream& os) const
+{
+	os << "*** Non-zero entries of matrix:  "
+	   << "\n";
+	os.setf(std::ios_base::scientific, std::ios_base::floatfield);
+	os.precision(20);
+	for (size_t i = 0; i < Rows(); i++)
+		for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; k++)
+			os << std::setw(10) << i + 1 << " " << std::setw(10) << col_idx[k] + 1 << " " << std::setw(15)
+			   << values[k] << "\n";
+	os.unsetf(std::ios_base::scientific);
+}
+
+int solvePCGMultiRHS(const SparseMatrixCSR& M, int n_rhs, const std::vector<double>& b, std::vector<double>& x,
+                     double tol, int max_iterations)
+{
+	const size_t n = M.Rows();
+	const size_t nn = n_rhs * n;
+	std::vector<double> diag_inv(n, 0.0);
+	for (size_t i = 0; i < n; i++)
+	{
+		const double m_ii = M(i, i);
+		if (m_ii > 0.0) // rows of nodes without marked elements stay zero
+			diag_inv[i] = 1.0 / m_ii;
+	}
+
+	x.assign(nn, 0.0);
+	std::vector<double> r(b), z(nn), p(nn), q(nn);
+	std::vector<double> rz(n_rhs, 0.0), r_max(n_rhs, 0.0);
+	std::vector<bool> active(n_rhs, true);
+	int n_active = 0;
+	for (int c = 0; c < n_rhs; c++)
+	{
+		double bb = 0.0;
+		for (size_t i = c * n; i < (c + 1) * n; i++)
+		{
+			z[i] = p[i] = diag_inv[i - c * n] * r[i];
+			rz[c] += r[i] * z[i];
+			bb += b[i] * b[i];
+		}
+		r_max[c] = tol * tol * bb;
+		active[c] = (bb > 0.0);
+		if (active[c])
+			n_active++;
+	}
+
+	int k = 0;
+	for (; k < max_iterations && n_active > 0; k++)
+	{
+		// q = M p
+		M.multiVec(&p[0], &q[0], n_rhs);
+
+		for (int c = 0; c < n_rhs; c++)
+		{
+			if (!active[c])
+				continue;
+			const size_t i0 = c * n, i1 = (c + 1) * n;
+			double pq = 0.0;
+			for (size_t i = i0; i < i1; i++)
+				pq += p[i] * q[i];
+			const double alpha = rz[c] / pq;
+			double rr = 0.0, rz_new = 0.0;
+			for (size_t i = i0; i < i1; i++)
+			{
+				x[i] += alpha * p[i];
+				r[i] -= alpha * q[i];
+				z[i] = diag_inv[i - i0] * r[i];
+				rr += r[i] * r[i];
+				rz_new += r[i] * z[i];
+			}
+			if (rr <= r_max[c])
+			{
+				active[c] = false;
+				n_active--;
+				continue;
+			}
+			const double beta = rz_new / rz[c];
+			rz[c] = rz_new;
+			for (size_t i = i0; i < i1; i++)
+				p[i] = z[i] + beta * p[i];
+		}
+	}
+	return (n_active > 0) ? -1 : k;
+}
+
+} // end namespace Math_Group
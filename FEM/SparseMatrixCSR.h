@@ -0,0 +1,100 @@
+/*
+ * SparseMatrixCSR.h
+ *
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#ifndef SPARSEMATRIXCSR_H_
+#define SPARSEMATRIXCSR_H_
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace Math_Group
+{
+/**
+ * Sparse matrix in compressed row storage with a fixed, structurally
+ * symmetric sparsity pattern, e.g. the node-to-node connectivity of a mesh.
+ *
+ * The pattern is given once at construction, the values are kept in one flat
+ * array. Besides the usual (i,j) access by a binary search within the row,
+ * the entries can be addressed directly: row i covers the entry indices
+ * [RowBegin(i), RowEnd(i)), and Transposed(k) is the index of the entry (j,i)
+ * mirroring the entry k = (i,j). A loop over the entries with j > i is thus a
+ * loop over the edges of the pattern. Rows are independent, so loops over rows
+ * that only write to entries of their own row, or to the mirror of their own
+ * upper triangle entries, can run in parallel.
+ */
+class SparseMatrixCSR
+{
+public:
+	/**
+	 * @param row_columns column indices per row, duplicates allowed. The
+	 * vector is cleared. The pattern must be structurally symmetric.
+	 */
+	explicit SparseMatrixCSR(std::vector<std::vector<size_t> >& row_columns);
+
+	size_t Rows() const { return row_ptr.size() - 1; }
+	/// number of stored entries
+	size_t Size() const { return col_idx.size(); }
+
+	size_t RowBegin(size_t i) const { return row_ptr[i]; }
+	size_t RowEnd(size_t i) const { return row_ptr[i + 1]; }
+	size_t Column(size_t k) const { return col_idx[k]; }
+	/// entry index of (j,i) for the entry k = (i,j)
+	size_t Transposed(size_t k) const { return transposed_idx[k]; }
+	double& Value(size_t k) { return values[k]; }
+	double Value(size_t k) const { return values[k]; }
+
+	/// entry index of (i,j), or -1 if (i,j) is not in the pattern
+	long Find(size_t i, size_t j) const;
+
+	/// Aborts if (i,j) is not in the pattern
+	double& operator()(size_t i, size_t j);
+	/// Entries outside the pattern read as zero
+	double operator()(size_t i, size_t j) const;
+
+	SparseMatrixCSR& operator=(double a);
+
+	/**
+	 * vec_r = A vec_s for n_vec vectors stored one after the other, i.e. the
+	 * c-th vector starts at c * Rows(). All vectors are done in one sweep
+	 * over the matrix.
+	 */
+	void multiVec(const double* vec_s, double* vec_r, int n_vec = 1) const;
+
+	/// Sums of the rows, e.g. the lumped mass matrix of a mass matrix
+	void RowSums(std::vector<double>& sums) const;
+
+	void Write(std::ostream& os = std::cout) const;
+
+private:
+	std::vector<size_t> row_ptr;
+	std::vector<size_t> col_idx;
+	std::vector<size_t> transposed_idx;
+	std::vector<double> values;
+
+	SparseMatrixCSR(const SparseMatrixCSR&);
+	void operator=(const SparseMatrixCSR&);
+};
+
+/**
+ * Jacobi preconditioned CG for the n_rhs systems M x_c = b_c with the same
+ * symmetric positive definite matrix M. The vectors of all systems are stored
+ * one after the other, x[c * n + i]. The products with M are done for all
+ * systems in one sweep over the matrix. A system is converged if its residual
+ * norm is below tol times the norm of its RHS. Systems with a zero RHS get
+ * the zero solution. Returns the iteration count, or -1 if not all systems
+ * converged within max_iterations.
+ */
+int solvePCGMultiRHS(const SparseMatrixCSR& M, int n_rhs, const std::vector<double>& b, std::vector<double>& x,
+                     double tol, int max_iterations);
+
+} // end namespace Math_Group
+
+#endif /* SPARSEMATRIXCSR_H_ */
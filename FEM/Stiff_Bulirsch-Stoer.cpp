@@ -9,110 +9,654 @@
 
 #include "Stiff_Bulirsch-Stoer.h"
 #include "stdlib.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <vector>
+
+#ifdef OGS_USE_CVODE
+extern "C" {
+#include <cvode/cvode.h> /* prototypes for CVODE fcts., consts. */
+#include <nvector/nvector_serial.h> /* serial N_Vector types, fcts., macros */
+#include <cvode/cvode_dense.h> /* prototype for CVDense */
+#include <sundials/sundials_dense.h> /* definitions DlsMat DENSE_ELEM */
+#include <sundials/sundials_types.h> /* definition of type realtype */
+}
+#endif
+
+typedef void (*OdeDerivs)(double, double[], double[], int, long, double);
 
 /* interne Deklarationen */
 double* dvector(long nl, long nh);
 void free_dvector(double* v, long nl, long nh);
-void stifbs(double y[], double dydx[], int nv, double* xx, double htry, double eps, double yscal[], double* hdid,
-            double* hnext, void (*derivs)(double, double[], double[], int, long, double));
-void odeint(double ystart[], int nvar, double x1, double x2, double eps, double h1, double hmin, double* hnext,
-            int* nok, int* nbad, void (*derivs)(double, double[], double[], int, long, double),
-            bool (*stifbs)(double[], double[], int, double*, double, double, double[], double*, double*,
-                           void (*)(double, double[], double[], int, long, double)),
-            bool (*rkqs)(double[], double[], int, double*, double, double, double[], double*, double*,
-                         void (*)(double, double[], double[], int, long, double), long),
-            long, int);
+bool stifbs(double y[], double dydx[], int nv, double* xx, double htry, double eps, double yscal[], double* hdid,
+            double* hnext, OdeDerivs derivs, long node);
+bool rkqs(double y[], double dydx[], int n, double* x, double htry, double eps, double yscal[], double* hdid,
+          double* hnext, OdeDerivs derivs, long node);
+
+namespace
+{
+/* Semi-implicit extrapolation (Bader & Deuflhard 1983) */
+const int KMAXX = 7; // Maximum row number of the extrapolation tableau
+const int IMAXX = KMAXX + 1;
+const int nseq[IMAXX] = {2, 6, 10, 14, 22, 34, 50, 70}; // Number of midpoint substeps per row
+const double SAFE1 = 0.94;
+const double SAFE2 = 0.65; // Target error of the next step
+const double SCALMX = 4.0; // Maximum step size increase
+const double SCALMN = 0.1; // Maximum step size reduction
+const double ERRMIN = 1.0e-10;
+
+/* Embedded Runge-Kutta (Cash & Karp 1990) */
+const double SAFETY = 0.9;
+const double PGROW = -0.2;
+const double PSHRNK = -0.25;
+const double ERRCON = 1.89e-4; // (5/SAFETY)^(1/PGROW)
+
+#ifdef OGS_USE_CVODE
+const double CVODE_ABSTOL = 1.0e-20;
+#endif
+
+/**
+ * Work arrays of the ODE integrators. The kinetic reactions are integrated
+ * node by node with the same number of components, so the arrays are kept
+ * from one call to the next and are only reallocated if the number of
+ * equations changes. As in the callers, vectors are indexed 1..n.
+ */
+class OdeWorkspace
+{
+public:
+	OdeWorkspace() : n(0)
+#ifdef OGS_USE_CVODE
+	                 ,
+	                 cvode_mem(NULL), cvode_y(NULL), cvode_n(0)
+#endif
+	{
+	}
+	~OdeWorkspace()
+	{
+#ifdef OGS_USE_CVODE
+		releaseCVode();
+#endif
+	}
+
+	void resize(int nv)
+	{
+		if (nv == n)
+			return;
+		n = nv;
+		const std::size_t n1 = n + 1;
+		y.resize(n1);
+		dydx.resize(n1);
+		yscal.resize(n1);
+		ytemp.resize(n1);
+		yerr.resize(n1);
+		ysav.resize(n1);
+		yseq.resize(n1);
+		del.resize(n1);
+		for (int k = 0; k < 5; k++)
+			ak[k].resize(n1);
+		dfdx.resize(n1);
+		jacobian.resize(n1 * n1);
+		dfdy.resize(n1);
+		for (std::size_t i = 0; i < n1; i++)
+			dfdy[i] = &jacobian[i * n1];
+		lu.resize(n * n);
+		pivot.resize(n);
+		tableau.resize(IMAXX * n);
+		tableau_old.resize(IMAXX * n);
+	}
+
+	int n;
+	std::vector<double> y, dydx, yscal; // Solution of the odeint driver
+	std::vector<double> ytemp, yerr, ysav, yseq, del;
+	std::vector<double> ak[5]; // Runge-Kutta stages
+	std::vector<double> dfdx, jacobian;
+	std::vector<double*> dfdy; // Row pointers into jacobian for jacobn()
+	std::vector<double> lu; // Factorized iteration matrix (0-based)
+	std::vector<int> pivot;
+	std::vector<double> tableau, tableau_old; // Current and previous row of the extrapolation
+
+#ifdef OGS_USE_CVODE
+	void releaseCVode()
+	{
+		if (cvode_mem)
+			CVodeFree(&cvode_mem);
+		if (cvode_y)
+			N_VDestroy_Serial(cvode_y);
+		cvode_mem = NULL;
+		cvode_y = NULL;
+		cvode_n = 0;
+	}
+
+	void* cvode_mem;
+	N_Vector cvode_y;
+	int cvode_n;
+	OdeDerivs cvode_derivs;
+	long cvode_node;
+#endif
+
+private:
+	OdeWorkspace(const OdeWorkspace&);
+	OdeWorkspace& operator=(const OdeWorkspace&);
+};
+
+#ifdef _OPENMP
+OdeWorkspace* thread_workspace = NULL;
+#pragma omp threadprivate(thread_workspace)
+#endif
+
+/**
+ * Work arrays of the calling thread, so that the integrators themselves do
+ * not share any state between threads. With OpenMP the workspace of a
+ * thread is created on first use and kept until the program ends. Note that
+ * derivs() and jacobn() of the kinetic reactions still use buffers of the
+ * shared reaction data, e.g. CKinReactData::ode_rates, so the node loop in
+ * CKinReactData::ExecuteKinReact is not run in parallel.
+ */
+OdeWorkspace& getWorkspace()
+{
+#ifdef _OPENMP
+	if (!thread_workspace)
+		thread_workspace = new OdeWorkspace();
+	return *thread_workspace;
+#else
+	static OdeWorkspace workspace;
+	return workspace;
+#endif
+}
+
+/// LU factorization with partial pivoting of the row-major n x n matrix a
+bool luDecompose(double* a, int* pivot, int n)
+{
+	for (int k = 0; k < n; k++)
+	{
+		int p = k;
+		double amax = fabs(a[k * n + k]);
+		for (int i = k + 1; i < n; i++)
+		{
+			if (fabs(a[i * n + k]) > amax)
+			{
+				amax = fabs(a[i * n + k]);
+				p = i;
+			}
+		}
+		if (amax == 0.0)
+			return false;
+		pivot[k] = p;
+		if (p != k)
+			for (int j = 0; j < n; j++)
+				std::swap(a[k * n + j], a[p * n + j]);
+
+		const double inv_diag = 1.0 / a[k * n + k];
+		for (int i = k + 1; i < n; i++)
+		{
+			const double l = (a[i * n + k] *= inv_diag);
+			if (l == 0.0)
+				continue;
+			for (int j = k + 1; j < n; j++)
+				a[i * n + j] -= l * a[k * n + j];
+		}
+	}
+	return true;
+}
+
+/// Solves LU x = b in place, b indexed 0..n-1
+void luSolve(const double* a, const int* pivot, int n, double* b)
+{
+	for (int k = 0; k < n; k++)
+		if (pivot[k] != k)
+			std::swap(b[k], b[pivot[k]]);
+	for (int i = 1; i < n; i++)
+	{
+		double s = b[i];
+		for (int j = 0; j < i; j++)
+			s -= a[i * n + j] * b[j];
+		b[i] = s;
+	}
+	for (int i = n - 1; i >= 0; i--)
+	{
+		double s = b[i];
+		for (int j = i + 1; j < n; j++)
+			s -= a[i * n + j] * b[j];
+		b[i] = s / a[i * n + i];
+	}
+}
+
+/**
+ * Semi-implicit midpoint rule over htot with nstep substeps. The iteration
+ * matrix (I - h df/dy) is factorized once for all substeps.
+ */
+bool simpr(const double* y, const double* dydx, int n, double xs, double htot, int nstep, double* yout,
+           OdeDerivs derivs, long node)
+{
+	OdeWorkspace& ws = getWorkspace();
+	const double h = htot / nstep;
+	double* a = &ws.lu[0];
+	for (int i = 0; i < n; i++)
+	{
+		for (int j = 0; j < n; j++)
+			a[i * n + j] = -h * ws.dfdy[i + 1][j + 1];
+		a[i * n + i] += 1.0;
+	}
+	if (!luDecompose(a, &ws.pivot[0], n))
+		return false;
+
+	double* del = &ws.del[0];
+	double* ytemp = &ws.ytemp[0];
+	for (int i = 1; i <= n; i++)
+		yout[i] = h * (dydx[i] + h * ws.dfdx[i]);
+	luSolve(a, &ws.pivot[0], n, yout + 1);
+	for (int i = 1; i <= n; i++)
+	{
+		del[i] = yout[i];
+		ytemp[i] = y[i] + del[i];
+	}
+	double x = xs + h;
+	derivs(x, ytemp, yout, n, node, h);
+	for (int nn = 2; nn <= nstep; nn++)
+	{
+		for (int i = 1; i <= n; i++)
+			yout[i] = h * yout[i] - del[i];
+		luSolve(a, &ws.pivot[0], n, yout + 1);
+		for (int i = 1; i <= n; i++)
+		{
+			del[i] += 2.0 * yout[i];
+			ytemp[i] += del[i];
+		}
+		x += h;
+		derivs(x, ytemp, yout, n, node, h);
+	}
+	for (int i = 1; i <= n; i++)
+		yout[i] = h * yout[i] - del[i];
+	luSolve(a, &ws.pivot[0], n, yout + 1);
+	for (int i = 1; i <= n; i++)
+		yout[i] += ytemp[i];
+	return true;
+}
+
+/**
+ * Adds row k to the extrapolation tableau (Aitken-Neville in (h/nseq)^2
+ * towards zero). Returns the extrapolated value in yest and, for k > 0,
+ * the difference to the previous column in yerr.
+ */
+void extrapolate(int k, const double* yseq, double* yest, double* yerr, int n)
+{
+	OdeWorkspace& ws = getWorkspace();
+	double* cur = &ws.tableau[0];
+	const double* old = &ws.tableau_old[0];
+	for (int i = 0; i < n; i++)
+		cur[i] = yseq[i + 1];
+	for (int j = 1; j <= k; j++)
+	{
+		const double ratio = static_cast<double>(nseq[k]) / nseq[k - j];
+		const double factor = 1.0 / (ratio * ratio - 1.0);
+		double* col = cur + j * n;
+		const double* col_left = cur + (j - 1) * n;
+		const double* col_old = old + (j - 1) * n;
+		for (int i = 0; i < n; i++)
+			col[i] = col_left[i] + (col_left[i] - col_old[i]) * factor;
+	}
+	const double* best = cur + k * n;
+	for (int i = 0; i < n; i++)
+		yest[i + 1] = best[i];
+	if (k > 0)
+	{
+		const double* second = cur + (k - 1) * n;
+		for (int i = 0; i < n; i++)
+			yerr[i + 1] = best[i] - second[i];
+	}
+	ws.tableau.swap(ws.tableau_old);
+}
+
+/// One Cash-Karp step of size h, fifth order solution in yout, error estimate in yerr
+void rkck(const double* y, const double* dydx, int n, double x, double h, double* yout, double* yerr,
+          OdeDerivs derivs, long node)
+{
+	static const double a2 = 0.2, a3 = 0.3, a4 = 0.6, a5 = 1.0, a6 = 0.875;
+	static const double b21 = 0.2, b31 = 3.0 / 40.0, b32 = 9.0 / 40.0, b41 = 0.3, b42 = -0.9, b43 = 1.2,
+	                    b51 = -11.0 / 54.0, b52 = 2.5, b53 = -70.0 / 27.0, b54 = 35.0 / 27.0, b61 = 1631.0 / 55296.0,
+	                    b62 = 175.0 / 512.0, b63 = 575.0 / 13824.0, b64 = 44275.0 / 110592.0, b65 = 253.0 / 4096.0;
+	static const double c1 = 37.0 / 378.0, c3 = 250.0 / 621.0, c4 = 125.0 / 594.0, c6 = 512.0 / 1771.0;
+	static const double dc1 = c1 - 2825.0 / 27648.0, dc3 = c3 - 18575.0 / 48384.0, dc4 = c4 - 13525.0 / 55296.0,
+	                    dc5 = -277.0 / 14336.0, dc6 = c6 - 0.25;
+
+	OdeWorkspace& ws = getWorkspace();
+	double* ak2 = &ws.ak[0][0];
+	double* ak3 = &ws.ak[1][0];
+	double* ak4 = &ws.ak[2][0];
+	double* ak5 = &ws.ak[3][0];
+	double* ak6 = &ws.ak[4][0];
+	double* ytemp = &ws.ytemp[0];
+	int i;
+
+	for (i = 1; i <= n; i++)
+		ytemp[i] = y[i] + b21 * h * dydx[i];
+	derivs(x + a2 * h, ytemp, ak2, n, node, h);
+	for (i = 1; i <= n; i++)
+		ytemp[i] = y[i] + h * (b31 * dydx[i] + b32 * ak2[i]);
+	derivs(x + a3 * h, ytemp, ak3, n, node, h);
+	for (i = 1; i <= n; i++)
+		ytemp[i] = y[i] + h * (b41 * dydx[i] + b42 * ak2[i] + b43 * ak3[i]);
+	derivs(x + a4 * h, ytemp, ak4, n, node, h);
+	for (i = 1; i <= n; i++)
+		ytemp[i] = y[i] + h * (b51 * dydx[i] + b52 * ak2[i] + b53 * ak3[i] + b54 * ak4[i]);
+	derivs(x + a5 * h, ytemp, ak5, n, node, h);
+	for (i = 1; i <= n; i++)
+		ytemp[i] = y[i] + h * (b61 * dydx[i] + b62 * ak2[i] + b63 * ak3[i] + b64 * ak4[i] + b65 * ak5[i]);
+	derivs(x + a6 * h, ytemp, ak6, n, node, h);
+	for (i = 1; i <= n; i++)
+	{
+		yout[i] = y[i] + h * (c1 * dydx[i] + c3 * ak3[i] + c4 * ak4[i] + c6 * ak6[i]);
+		yerr[i] = h * (dc1 * dydx[i] + dc3 * ak3[i] + dc4 * ak4[i] + dc5 * ak5[i] + dc6 * ak6[i]);
+	}
+}
+
+/// Scaled maximum error norm, NaN if any scaled error is NaN
+double errorNorm(const double* yerr, const double* yscal, int n, double eps)
+{
+	double errmax = 0.0;
+	for (int i = 1; i <= n; i++)
+	{
+		const double e = fabs(yerr[i] / yscal[i]);
+		if (e != e) // a later component must not hide the NaN
+			return std::numeric_limits<double>::quiet_NaN();
+		if (e > errmax)
+			errmax = e;
+	}
+	return errmax / eps;
+}
+
+#ifdef OGS_USE_CVODE
+int cvRhsFn_kinreact(realtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+	OdeWorkspace& ws = *static_cast<OdeWorkspace*>(user_data);
+	const double* yv = NV_DATA_S(y);
+	for (int i = 0; i < ws.n; i++)
+		ws.ytemp[i + 1] = yv[i];
+	ws.cvode_derivs(t, &ws.ytemp[0], &ws.dydx[0], ws.n, ws.cvode_node, 0.0);
+	double* f = NV_DATA_S(ydot);
+	for (int i = 0; i < ws.n; i++)
+		f[i] = ws.dydx[i + 1];
+	return 0;
+}
+
+int cvJacFn_kinreact(long int N, realtype t, N_Vector y, N_Vector /*fy*/, DlsMat J, void* user_data,
+                     N_Vector /*tmp1*/, N_Vector /*tmp2*/, N_Vector /*tmp3*/)
+{
+	OdeWorkspace& ws = *static_cast<OdeWorkspace*>(user_data);
+	const double* yv = NV_DATA_S(y);
+	for (long i = 0; i < N; i++)
+		ws.ytemp[i + 1] = yv[i];
+	jacobn(t, &ws.ytemp[0], &ws.dfdx[0], &ws.dfdy[0], ws.n, ws.cvode_node);
+	for (long i = 0; i < N; i++)
+		for (long j = 0; j < N; j++)
+			DENSE_ELEM(J, i, j) = ws.dfdy[i + 1][j + 1];
+	return 0;
+}
+
+/**
+ * Integrates with the BDF methods of CVODE and the analytical Jacobian of
+ * jacobn(). The integrator memory is created once and re-initialized for
+ * every node.
+ */
+bool cvodeIntegrate(double ystart[], int nvar, double x1, double x2, double eps, double h1, double hmin,
+                    double* nexth, int* nok, int* nbad, OdeDerivs derivs, long node)
+{
+	OdeWorkspace& ws = getWorkspace();
+	ws.resize(nvar);
+	ws.cvode_derivs = derivs;
+	ws.cvode_node = node;
+
+	int flag;
+	if (ws.cvode_n != nvar)
+	{
+		ws.releaseCVode();
+		ws.cvode_y = N_VNew_Serial(nvar);
+		for (int i = 0; i < nvar; i++)
+			NV_Ith_S(ws.cvode_y, i) = ystart[i + 1];
+		ws.cvode_mem = CVodeCreate(CV_BDF, CV_NEWTON);
+		flag = CVodeInit(ws.cvode_mem, cvRhsFn_kinreact, x1, ws.cvode_y);
+		if (flag == CV_SUCCESS)
+			flag = CVodeSetUserData(ws.cvode_mem, &ws);
+		if (flag == CV_SUCCESS)
+			flag = CVDense(ws.cvode_mem, nvar);
+		if (flag == CV_SUCCESS)
+			flag = CVDlsSetDenseJacFn(ws.cvode_mem, cvJacFn_kinreact);
+		if (flag == CV_SUCCESS)
+			flag = CVodeSetMaxNumSteps(ws.cvode_mem, MAXSTEP);
+		if (flag != CV_SUCCESS)
+		{
+			std::cout << "Error: CVODE initialization failed in odeint" << std::endl;
+			ws.releaseCVode();
+			return false;
+		}
+		ws.cvode_n = nvar;
+	}
+	else
+	{
+		for (int i = 0; i < nvar; i++)
+			NV_Ith_S(ws.cvode_y, i) = ystart[i + 1];
+		CVodeReInit(ws.cvode_mem, x1, ws.cvode_y);
+	}
+	CVodeSStolerances(ws.cvode_mem, eps, CVODE_ABSTOL);
+	CVodeSetInitStep(ws.cvode_mem, h1);
+	CVodeSetMinStep(ws.cvode_mem, hmin);
+	CVodeSetStopTime(ws.cvode_mem, x2);
+
+	realtype t = x1;
+	flag = CVode(ws.cvode_mem, x2, ws.cvode_y, &t, CV_NORMAL);
 
-double* dvector(long /*nl*/, long /*nh*/)
+	long int nsteps = 0, nfails = 0;
+	realtype hcur = h1;
+	CVodeGetNumSteps(ws.cvode_mem, &nsteps);
+	CVodeGetNumErrTestFails(ws.cvode_mem, &nfails);
+	CVodeGetCurrentStep(ws.cvode_mem, &hcur);
+	*nok = static_cast<int>(nsteps - nfails);
+	*nbad = static_cast<int>(nfails);
+	*nexth = hcur;
+	if (flag < 0)
+		return false;
+	for (int i = 0; i < nvar; i++)
+		ystart[i + 1] = NV_Ith_S(ws.cvode_y, i);
+	return true;
+}
+#endif
+} // end namespace
+
+/* Vector with index range nl..nh, nl >= 0 */
+double* dvector(long /*nl*/, long nh)
 {
-	// Removed
-	std::cout << "Error: dvector not implemented!" << std::endl;
-	return NULL;
+	return new double[nh + 1];
 }
 
-void free_dvector(double* /*v*/, long /*nl*/, long /*nh*/)
+void free_dvector(double* v, long /*nl*/, long /*nh*/)
 {
-	// Removed
-	std::cout << "Error: free_dvector not implemented!" << std::endl;
+	delete[] v;
 }
 
 /* Input: y=current_conc, dydx=their_derivs, xx=current_time, htry=suggested_stepsize     */
 /* Ouput: y=updated_conc,  xx=end_time, hdid=achieved_stepsize , hnext= estimated_next_ss */
 bool stifbs(double y[], double dydx[], int nv, double* xx, double htry, double eps, double yscal[], double* hdid,
-            double* hnext, void (*derivs)(double, double[], double[], int, long, double), long node)
-{
-	// The following void type casting is just to supress warnings
-	// Once this function is filled with using these arguments, these casting
-	// should be removed.
-	(void)y;
-	(void)dydx;
-	(void)nv;
-	(void)xx;
-	(void)htry;
-	(void)eps;
-	(void)yscal;
-	(void)hdid;
-	(void)hnext;
-	(void)derivs;
-	(void)node;
-
-	// Removed
-	std::cout << "Error: stifbs not implemented!" << std::endl;
-	return false;
+            double* hnext, OdeDerivs derivs, long node)
+{
+	OdeWorkspace& ws = getWorkspace();
+	ws.resize(nv);
+	double* ysav = &ws.ysav[0];
+	double* yseq = &ws.yseq[0];
+	double* yerr = &ws.yerr[0];
+
+	const double x0 = *xx;
+	for (int i = 1; i <= nv; i++)
+		ysav[i] = y[i];
+	jacobn(x0, ysav, &ws.dfdx[0], &ws.dfdy[0], nv, node);
+
+	double h = htry;
+	for (;;)
+	{
+		double err = 0.0;
+		double hopt[IMAXX]; // Step size for convergence in row k
+		int k;
+		bool converged = false;
+		for (k = 0; k < IMAXX; k++)
+		{
+			if (!simpr(ysav, dydx, nv, x0, h, nseq[k], yseq, derivs, node))
+			{
+				err = -1.0; // singular iteration matrix
+				break;
+			}
+			extrapolate(k, yseq, y, yerr, nv);
+			if (k == 0)
+				continue;
+			err = errorNorm(yerr, yscal, nv, eps);
+			if (!(err == err)) // NaN
+				break;
+			const double fac = SAFE1 * pow(std::max(err, ERRMIN) / SAFE2, -1.0 / (2 * k + 1));
+			hopt[k] = h * std::min(SCALMX, std::max(SCALMN, fac));
+			if (err <= 1.0)
+			{
+				converged = true;
+				break;
+			}
+		}
+
+		if (converged)
+		{
+			*xx = x0 + h;
+			*hdid = h;
+			// Row with the least work per unit step: cost = derivative evaluations up to row j
+			int kopt = 1;
+			double cost = nseq[0] + nseq[1] + 2.0;
+			double work_min = cost / hopt[1];
+			for (int j = 2; j <= k; j++)
+			{
+				cost += nseq[j] + 1.0;
+				if (cost / hopt[j] < work_min)
+				{
+					work_min = cost / hopt[j];
+					kopt = j;
+				}
+			}
+			*hnext = hopt[kopt];
+			// Converged in the optimal row: try one more row with a larger step
+			if (kopt == k && k < KMAXX)
+				*hnext = std::min(SCALMX * h, hopt[k] * (cost + nseq[k + 1] + 1.0) / cost);
+			return true;
+		}
+
+		// Reduce the step size and start again with the first row
+		double red = 0.25;
+		if (err > 1.0)
+			red = std::max(SCALMN, std::min(0.5, SAFE1 * pow(err, -1.0 / (2 * KMAXX + 1))));
+		h *= red;
+		if (x0 + h == x0)
+		{
+			for (int i = 1; i <= nv; i++)
+				y[i] = ysav[i];
+			std::cout << "Error: step size underflow in stifbs" << std::endl;
+			return false;
+		}
+	}
 }
 
 bool rkqs(double y[], double dydx[], int n, double* x, double htry, double eps, double yscal[], double* hdid,
-          double* hnext, void (*derivs)(double, double[], double[], int, long, double), long node)
-{
-	// The following void type casting is just to supress warnings
-	// Once this function is filled with using these arguments, these casting
-	// should be removed.
-	(void)y;
-	(void)dydx;
-	(void)n;
-	(void)x;
-	(void)htry;
-	(void)eps;
-	(void)yscal;
-	(void)hdid;
-	(void)hnext;
-	(void)derivs;
-	(void)node;
-
-	// Removed
-	std::cout << "Error: rkqs not implemented!" << std::endl;
-	return false;
+          double* hnext, OdeDerivs derivs, long node)
+{
+	OdeWorkspace& ws = getWorkspace();
+	ws.resize(n);
+	double* ysav = &ws.ysav[0];
+	double* yerr = &ws.yerr[0];
+	for (int i = 1; i <= n; i++)
+		ysav[i] = y[i];
+
+	double h = htry;
+	double errmax;
+	for (;;)
+	{
+		rkck(ysav, dydx, n, *x, h, y, yerr, derivs, node);
+		errmax = errorNorm(yerr, yscal, n, eps);
+		if (errmax <= 1.0)
+			break;
+		double htemp = (errmax == errmax) ? SAFETY * h * pow(errmax, PSHRNK) : 0.1 * h;
+		h = (h >= 0.0) ? std::max(htemp, 0.1 * h) : std::min(htemp, 0.1 * h);
+		if (*x + h == *x)
+		{
+			for (int i = 1; i <= n; i++)
+				y[i] = ysav[i];
+			std::cout << "Error: step size underflow in rkqs" << std::endl;
+			return false;
+		}
+	}
+	if (errmax > ERRCON)
+		*hnext = SAFETY * h * pow(errmax, PGROW);
+	else
+		*hnext = 5.0 * h;
+	*x += (*hdid = h);
+	return true;
 }
 
+/* Driver with adaptive step size control. SolverType 1: stiff semi-implicit
+   extrapolation (stifbs), 2: Runge-Kutta (rkqs), 3: CVODE BDF */
 bool odeint(double ystart[], int nvar, double x1, double x2, double eps, double h1, double hmin, double* nexth,
-            int* nok, int* nbad, void (*derivs)(double, double[], double[], int, long, double),
-            bool (*stifbs)(double[], double[], int, double*, double, double, double[], double*, double*,
-                           void (*)(double, double[], double[], int, long, double), long),
-            bool (*rkqs)(double[], double[], int, double*, double, double, double[], double*, double*,
-                         void (*)(double, double[], double[], int, long, double), long),
+            int* nok, int* nbad, OdeDerivs derivs,
+            bool (*stifbs)(double[], double[], int, double*, double, double, double[], double*, double*, OdeDerivs,
+                           long),
+            bool (*rkqs)(double[], double[], int, double*, double, double, double[], double*, double*, OdeDerivs,
+                         long),
             long node, int SolverType)
 {
-	// The following void type casting is just to supress warnings
-	// Once this function is filled with using these arguments, these casting
-	// should be removed.
-	(void)ystart;
-	(void)nvar;
-	(void)x1;
-	(void)x2;
-	(void)eps;
-	(void)h1;
-	(void)hmin;
-	(void)nexth;
-	(void)nok;
-	(void)nbad;
-	(void)derivs;
-	(void)stifbs;
-	(void)rkqs;
-	(void)node;
-	(void)SolverType;
-
-	// Removed
-	std::cout << "Error: odeint not implemented!" << std::endl;
+	*nok = *nbad = 0;
+	if (SolverType == 3)
+	{
+#ifdef OGS_USE_CVODE
+		return cvodeIntegrate(ystart, nvar, x1, x2, eps, h1, hmin, nexth, nok, nbad, derivs, node);
+#else
+		std::cout << "Error: CMake option OGS_USE_CVODE needs to be set for $SOLVER_TYPE 3!" << std::endl;
+		return false;
+#endif
+	}
+	bool (*stepper)(double[], double[], int, double*, double, double, double[], double*, double*, OdeDerivs, long)
+	    = (SolverType == 2) ? rkqs : stifbs;
+
+	OdeWorkspace& ws = getWorkspace();
+	ws.resize(nvar);
+	double* y = &ws.y[0];
+	double* dydx = &ws.dydx[0];
+	double* yscal = &ws.yscal[0];
+
+	double x = x1;
+	double h = (x2 >= x1) ? fabs(h1) : -fabs(h1);
+	double hdid, hnext;
+	for (int i = 1; i <= nvar; i++)
+		y[i] = ystart[i];
+
+	for (int nstp = 0; nstp < MAXSTEP; nstp++)
+	{
+		derivs(x, y, dydx, nvar, node, h);
+		for (int i = 1; i <= nvar; i++)
+			yscal[i] = fabs(y[i]) + fabs(dydx[i] * h) + TINY;
+		if ((x + h - x2) * (x + h - x1) > 0.0)
+			h = x2 - x;
+		if (!stepper(y, dydx, nvar, &x, h, eps, yscal, &hdid, &hnext, derivs, node))
+			return false;
+		if (hdid == h)
+			++(*nok);
+		else
+			++(*nbad);
+		if ((x - x2) * (x2 - x1) >= 0.0)
+		{
+			for (int i = 1; i <= nvar; i++)
+				ystart[i] = y[i];
+			*nexth = hnext;
+			return true;
+		}
+		if (fabs(hnext) <= hmin)
+		{
+			std::cout << "Error: step size smaller than minimum in odeint" << std::endl;
+			return false;
+		}
+		h = hnext;
+	}
+	std::cout << "Error: too many steps in odeint" << std::endl;
 	return false;
 }
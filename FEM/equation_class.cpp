@@ -70,6 +70,9 @@ extern int PARDISO(int*, int*, int*, int*, int*, int*, double*, int*, int*, int*
 #ifdef JFNK_H2M
 #include "rf_pcs.h"
 #endif
+#if !defined(USE_MPI)
+#include "EigenDirectSolver.h"
+#endif
 
 std::vector<Math_Group::Linear_EQS*> EQS_Vector;
 using namespace std;
@@ -121,6 +124,7 @@ Linear_EQS::Linear_EQS(const SparseTable& sparse_table,
 	border_buffer1 = NULL;
 #else
 	x = new double[size_A];
+	direct_solver = NULL;
 #endif
 	b = new double[size_A];
 	//
@@ -178,6 +182,10 @@ Linear_EQS::~Linear_EQS()
 	A = NULL;
 	x = NULL;
 	b = NULL;
+#if !defined(USE_MPI)
+	delete direct_solver;
+	direct_solver = NULL;
+#endif
 
 	/// GMRES. 30.06.2010. WW
 	if (solver_type == 13)
@@ -197,7 +205,12 @@ void Linear_EQS::ConfigNumerics(CNumerics* m_num, const long n)
 	switch (solver_type)
 	{
 		case 1:
+#if defined(USE_MPI)
 			solver_name = "Gauss";
+#else
+			solver_name = "SparseLU";
+			nbuffer = 1;
+#endif
 			break;
 		case 2:
 			solver_name = "BiCGSTab";
@@ -247,6 +260,10 @@ void Linear_EQS::ConfigNumerics(CNumerics* m_num, const long n)
 			H.resize(m_gmres + 1, m_gmres + 1);
 			nbuffer = m_gmres + 4;
 			break;
+		case 14:
+			solver_name = "PipeCG";
+			nbuffer = 5;
+			break;
 	}
 	// Buffer
 	/*
@@ -878,6 +895,8 @@ int Linear_EQS::Solver()
 		case 13:
 			return GMRES();
 			break;
+		case 14:
+			return PipeCG();
 	}
 	return -1;
 }
@@ -976,11 +995,63 @@ double Linear_EQS::dot(const double* xx, const double* yy)
 	//
 	MPI_Allreduce(&val_i, &val, 1, MPI_DOUBLE, MPI_SUM, comm_DDC);
 #else
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : val)
+#endif
 	for (long i = 0; i < size_A; i++)
 		val += xx[i] * yy[i];
 #endif
 	return val;
 }
+/*\!
+ ********************************************************************
+   Two dot products, x1*y1 and x2*y2, with one pass over the vectors,
+   and with one global reduction for domain decomposition
+ ********************************************************************/
+void Linear_EQS::dot2(const double* x1, const double* y1, const double* x2, const double* y2, double& d1, double& d2)
+{
+#if defined(USE_MPI)
+	double val_i[2], val[2];
+	val_i[0] = dom->Dot_Interior(x1, y1) + dom->Dot_Border_Vec(x1, y1);
+	val_i[1] = dom->Dot_Interior(x2, y2) + dom->Dot_Border_Vec(x2, y2);
+	//
+	MPI_Allreduce(val_i, val, 2, MPI_DOUBLE, MPI_SUM, comm_DDC);
+	d1 = val[0];
+	d2 = val[1];
+#else
+	double val1 = 0., val2 = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : val1, val2)
+#endif
+	for (long i = 0; i < size_A; i++)
+	{
+		val1 += x1[i] * y1[i];
+		val2 += x2[i] * y2[i];
+	}
+	d1 = val1;
+	d2 = val2;
+#endif
+}
+#if !defined(USE_MPI)
+/*\!
+ ********************************************************************
+   Fused axpy and dot product: yy += a*xx, returns yy*zz of the
+   updated yy. zz may be yy.
+ ********************************************************************/
+double Linear_EQS::axpy_dot(double* yy, const double a, const double* xx, const double* zz)
+{
+	double val = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : val)
+#endif
+	for (long i = 0; i < size_A; i++)
+	{
+		yy[i] += a * xx[i];
+		val += yy[i] * zz[i];
+	}
+	return val;
+}
+#endif
 /*\!
  ********************************************************************
    Dot production of two vectors
@@ -1107,6 +1178,43 @@ inline bool Linear_EQS::CheckNormRHS(const double normb_new)
 	return false;
 }
 #ifndef USE_MPI
+/**************************************************************************
+   Task: Linear equation::Gauss
+      Sparse direct solver. The factorization is kept in direct_solver and
+      reused as long as the matrix does not change.
+**************************************************************************/
+int Linear_EQS::Gauss()
+{
+	const long size = A->Dim();
+	//
+	double bNorm_new = Norm(b);
+	if (CheckNormRHS(bNorm_new))
+		return 0;
+	//
+	if (!direct_solver)
+		direct_solver = new EigenDirectSolver();
+	const long n_factorizations = direct_solver->numberOfFactorizations();
+	if (!direct_solver->solve(*A, b, x))
+	{
+		cout << "Error in Linear_EQS::Gauss: factorization of the matrix failed"
+		     << "\n";
+		return -1;
+	}
+	// Relative residual r = b-Ax for the message
+	double* r = f_buffer[0];
+	A->multiVec(x, r);
+	for (long i = 0; i < size; i++)
+		r[i] = b[i] - r[i];
+	error = Norm(r) / bNorm;
+	iter = 1;
+	if (message)
+		cout << "      Direct solver: "
+		     << ((direct_solver->numberOfFactorizations() > n_factorizations) ? "new factorization"
+		                                                                    : "factorization reused")
+		     << "\n";
+	Message();
+	return 1;
+}
 /**************************************************************************
    Task: Linear equation::CG
    Programing:
@@ -1127,33 +1235,44 @@ int Linear_EQS::CG()
 	//
 	// r0 = b-Ax
 	A->multiVec(x, s);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 	for (long i = 0; i < size; i++)
 		r[i] = b[i] - s[i];
 	//
 	// Preconditioning: M^{-1}r
 	Precond(r, s);
-	for (long i = 0; i < size; i++)
-		p[i] = s[i];
 	// Check the convergence
-	if ((error = Norm(r) / bNorm) < tol)
+	double rr, rr_r;
+	dot2(r, s, r, r, rr, rr_r);
+	if ((error = sqrt(rr_r) / bNorm) < tol)
 	{
 		Message();
 		return 1;
 	}
-	//
-	double rr = dot(r, s);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (long i = 0; i < size; i++)
+		p[i] = s[i];
 	//
 	for (iter = 1; iter <= max_iter; ++iter)
 	{
 		A->multiVec(p, s);
 		const double alpha = rr / dot(p, s);
-		// Update
+		// Update x and r, and |r|^2 in the same pass
+		rr_r = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : rr_r)
+#endif
 		for (long i = 0; i < size; i++)
 		{
 			x[i] += alpha * p[i];
 			r[i] -= alpha * s[i];
+			rr_r += r[i] * r[i];
 		}
-		if ((error = Norm(r) / bNorm) < tol)
+		if ((error = sqrt(rr_r) / bNorm) < tol)
 		{
 			Message();
 			return iter <= max_iter;
@@ -1164,6 +1283,9 @@ int Linear_EQS::CG()
 		const double rrM1 = rr;
 		rr = dot(s, r);
 		const double beta = rr / rrM1;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 		for (long i = 0; i < size; i++)
 			p[i] = s[i] + beta * p[i];
 	}
@@ -1171,6 +1293,91 @@ int Linear_EQS::CG()
 	Message();
 	return iter <= max_iter;
 }
+/**************************************************************************
+   Task: Linear equation::PipeCG
+      Preconditioned CG in the single reduction form of Chronopoulos and
+      Gear: the vector updates of an iteration are done in one pass and
+      the three inner products (r,u), (w,u) and (r,r) in one further
+      pass, i.e. with one synchronisation point per iteration.
+      u = M^{-1}r, w = Au, s = Ap.
+**************************************************************************/
+int Linear_EQS::PipeCG()
+{
+	//
+	const long size = A->Dim();
+	double* p = f_buffer[0];
+	double* r = f_buffer[1];
+	double* s = f_buffer[2];
+	double* u = f_buffer[3];
+	double* w = f_buffer[4];
+	//
+	double bNorm_new = Norm(b);
+	// Check if the norm of b is samll enough for convengence
+	if (CheckNormRHS(bNorm_new))
+		return 0;
+	//
+	// r0 = b-Ax
+	A->multiVec(x, w);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (long i = 0; i < size; i++)
+	{
+		r[i] = b[i] - w[i];
+		p[i] = 0.;
+		s[i] = 0.;
+	}
+	//
+	double gamma = 0., delta = 0., rr_r = 0.;
+	double alpha = 1.0, beta = 0.;
+	for (iter = 0; iter <= max_iter; ++iter)
+	{
+		if (iter > 0)
+		{
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+			for (long i = 0; i < size; i++)
+			{
+				p[i] = u[i] + beta * p[i];
+				s[i] = w[i] + beta * s[i];
+				x[i] += alpha * p[i];
+				r[i] -= alpha * s[i];
+			}
+		}
+		Precond(r, u);
+		A->multiVec(u, w);
+		//
+		double gamma_new = 0.;
+		delta = 0.;
+		rr_r = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : gamma_new, delta, rr_r)
+#endif
+		for (long i = 0; i < size; i++)
+		{
+			gamma_new += r[i] * u[i];
+			delta += w[i] * u[i];
+			rr_r += r[i] * r[i];
+		}
+		if ((error = sqrt(rr_r) / bNorm) < tol)
+		{
+			Message();
+			return 1;
+		}
+		if (iter == 0)
+			alpha = gamma_new / delta;
+		else
+		{
+			beta = gamma_new / gamma;
+			alpha = gamma_new / (delta - beta * gamma_new / alpha);
+		}
+		gamma = gamma_new;
+	}
+	//
+	Message();
+	return iter <= max_iter;
+}
 /**************************************************************************
    Task: Linear equation::BiCG
    Programing:
@@ -1283,7 +1490,7 @@ int Linear_EQS::BiCGStab()
 	double* p = f_buffer[6];
 	double* p_h = f_buffer[7];
 	//
-	double rho_0, rho_1, alpha, beta, omega, tt = 0., norm_r = 0.;
+	double rho_0, rho_1, alpha, beta, omega, tt = 0., ts = 0., norm_r = 0.;
 	rho_0 = alpha = omega = 1.0;
 	//
 	double bNorm_new = Norm(b);
@@ -1309,16 +1516,25 @@ int Linear_EQS::BiCGStab()
 	}
 #else // ifdef JFNK_H2M
 	A->multiVec(x, s); // s as buffer
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 	for (long i = 0; i < size; i++)
 		r0[i] = b[i] - s[i]; // r = b-Ax
+#endif
+	// r = r0, v = p = 0, and |r|^2 = (r0, r) in one pass
+	rho_1 = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : rho_1)
 #endif
 	for (long i = 0; i < size; i++)
 	{
 		r[i] = r0[i];
 		v[i] = 0.;
 		p[i] = 0.;
+		rho_1 += r0[i] * r0[i];
 	}
-	if ((error = Norm(r) / bNorm) < tol)
+	if ((error = sqrt(rho_1) / bNorm) < tol)
 	{
 		Message();
 		return 0;
@@ -1326,18 +1542,26 @@ int Linear_EQS::BiCGStab()
 	//
 	for (iter = 1; iter <= max_iter; iter++)
 	{
-		rho_1 = dot(r0, r);
+		// rho_1 = (r0, r) is computed with the update of r
 		if (fabs(rho_1) < DBL_MIN) // DBL_EPSILON
 		{
 			Message();
 			return 0;
 		}
 		if (iter == 1)
+		{
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 			for (long i = 0; i < size; i++)
 				p[i] = r[i];
+		}
 		else
 		{
 			beta = (rho_1 / rho_0) * (alpha / omega);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 			for (long i = 0; i < size; i++)
 				p[i] = r[i] + beta * (p[i] - omega * v[i]);
 		}
@@ -1353,10 +1577,21 @@ int Linear_EQS::BiCGStab()
 		//
 		alpha = rho_1 / dot(r0, v);
 		//
+		// s = r - alpha v and |s|^2
+		double ss = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : ss)
+#endif
 		for (long i = 0; i < size; i++)
+		{
 			s[i] = r[i] - alpha * v[i];
-		if ((error = Norm(s) / bNorm) < tol)
+			ss += s[i] * s[i];
+		}
+		if ((error = sqrt(ss) / bNorm) < tol)
 		{
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 			for (long i = 0; i < size; i++)
 				x[i] += alpha * p_h[i];
 			Message();
@@ -1372,20 +1607,27 @@ int Linear_EQS::BiCGStab()
 #endif
 			A->multiVec(s_h, t);
 		//
-		tt = dot(t, t);
+		dot2(t, t, t, s, tt, ts);
 		if (tt > DBL_MIN)
-			omega = dot(t, s) / tt;
+			omega = ts / tt;
 		else
 			omega = 1.0;
-		// Update solution
+		rho_0 = rho_1;
+		// Update solution and residual, |r|^2 and (r0, r) of the next iteration
+		double rr = 0.;
+		rho_1 = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : rr, rho_1)
+#endif
 		for (long i = 0; i < size; i++)
 		{
 			x[i] += alpha * p_h[i] + omega * s_h[i];
 			r[i] = s[i] - omega * t[i];
+			rr += r[i] * r[i];
+			rho_1 += r0[i] * r[i];
 		}
-		rho_0 = rho_1;
 		//
-		norm_r = Norm(r);
+		norm_r = sqrt(rr);
 		if ((error = norm_r / bNorm) < tol)
 		{
 			Message();
@@ -1433,32 +1675,47 @@ int Linear_EQS::CGS()
 		return 0;
 	//
 	A->multiVec(x, v); // v as buffer
+	// r0 = r = b-Ax, v = 0, and |r|^2 = (r0, r) in one pass
+	double rr = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : rr)
+#endif
 	for (long i = 0; i < size; i++)
 	{
 		r0[i] = b[i] - v[i]; // r = b-Ax
 		r[i] = r0[i];
 		v[i] = 0.;
+		rr += r[i] * r[i];
 	}
-	if ((error = Norm(r) / bNorm) < tol)
+	if ((error = sqrt(rr) / bNorm) < tol)
 	{
 		Message();
 		return 0;
 	}
+	rho_1 = rr;
 	//
 	for (iter = 1; iter <= max_iter; iter++)
 	{
-		rho_1 = dot(r0, r);
+		// rho_1 = (r0, r) is computed with the update of r
 		if (fabs(rho_1) < DBL_MIN) //  DBL_EPSILON
 		{
 			Message();
 			return 0;
 		}
 		if (iter == 1)
+		{
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 			for (long i = 0; i < size; i++)
 				p[i] = u[i] = r[i];
+		}
 		else
 		{
 			beta = rho_1 / rho_2;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 			for (long i = 0; i < size; i++)
 			{
 				u[i] = r[i] + beta * q[i];
@@ -1472,6 +1729,9 @@ int Linear_EQS::CGS()
 		//
 		alpha = rho_1 / dot(r0, v);
 		//
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 		for (long i = 0; i < size; i++)
 		{
 			q[i] = u[i] - alpha * v[i];
@@ -1479,15 +1739,24 @@ int Linear_EQS::CGS()
 		}
 		// Preconditioner
 		Precond(q_h, u_h);
-		for (long i = 0; i < size; i++)
-			x[i] += alpha * u_h[i];
 		//
 		A->multiVec(u_h, q_h);
 		//
+		// Update x and r, |r|^2 and (r0, r) of the next iteration
+		rho_2 = rho_1;
+		rr = 0.;
+		rho_1 = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : rr, rho_1)
+#endif
 		for (long i = 0; i < size; i++)
+		{
+			x[i] += alpha * u_h[i];
 			r[i] -= alpha * q_h[i];
-		rho_2 = rho_1;
-		if ((error = Norm(r) / bNorm) < tol)
+			rr += r[i] * r[i];
+			rho_1 += r0[i] * r[i];
+		}
+		if ((error = sqrt(rr) / bNorm) < tol)
 		{
 			Message();
 			return iter <= max_iter;
@@ -1641,6 +1910,9 @@ int Linear_EQS::GMRES()
 	while (iter <= max_iter)
 	{
 		v = f_buffer[v_idx0];
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 		for (long l = 0; l < size_A; l++)
 			v[l] = r[l] / beta; //  r/beta
 		for (long l = 0; l < m + 1; l++)
@@ -1658,18 +1930,26 @@ int Linear_EQS::GMRES()
 				A->multiVec(v, t);
 			Precond(t, w);
 
+			// Modified Gram-Schmidt. The subtraction of the k-th projection
+			// and the inner product with v_{k+1} (with w at last) are fused.
+			H(0, i) = dot(w, f_buffer[v_idx0]);
 			for (long k = 0; k <= i; k++)
 			{
 				v_k = f_buffer[v_idx0 + k];
-				H(k, i) = dot(w, v_k);
-
-				for (long l = 0; l < size_A; l++)
-					w[l] -= H(k, i) * v_k[l];
+				const double* next = (k < i) ? f_buffer[v_idx0 + k + 1] : w;
+				const double w_next = axpy_dot(w, -H(k, i), v_k, next);
+				if (k < i)
+					H(k + 1, i) = w_next;
+				else
+					H(i + 1, i) = sqrt(w_next);
 			}
-			H(i + 1, i) = Norm(w);
 			v_k = f_buffer[v_idx0 + i + 1];
+			const double h_inv = 1.0 / H(i + 1, i);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
 			for (long l = 0; l < size_A; l++)
-				v_k[l] = w[l] / H(i + 1, i);
+				v_k[l] = w[l] * h_inv;
 
 			for (long k = 0; k < i; k++)
 				Set_Plane_Rotation(H(k, i), H(k + 1, i), cs[k], sn[k]);
@@ -1854,13 +2134,14 @@ int Linear_EQS::CG(double* xg, const long n)
 			x[i] += alpha * p[i];
 			r[i] -= alpha * s[i];
 		}
-		if ((error = Norm(r) / bNorm) < tol)
-			break;
 		// Preconditioner
 		Precond(r, s);
-		//
-		double rrM1 = rr;
-		rr = dot(s, r);
+		// |r|^2 and (s, r) with one global reduction
+		const double rrM1 = rr;
+		double rr_r;
+		dot2(r, r, s, r, rr_r, rr);
+		if ((error = sqrt(rr_r) / bNorm) < tol)
+			break;
 		//
 		const double beta = rr / rrM1;
 		for (long i = 0; i < size; i++)
@@ -2109,9 +2390,10 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
 	 */
 
 	//
+	double rho_1 = dot(r0, r);
 	for (iter = 1; iter <= max_iter; iter++)
 	{
-		const double rho_1 = dot(r0, r);
+		// rho_1 = (r0, r) is computed together with |r|
 		if (fabs(rho_1) < DBL_MIN)
 			break;
 
@@ -2167,7 +2449,9 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
 		// A* M^{-1}s
 		MatrixMulitVec(s_h, t);
 		//
-		const double tt = dot(t, t);
+		// (t, t) and (t, s) with one global reduction
+		double tt, ts;
+		dot2(t, t, t, s, tt, ts);
 
 #ifdef TEST_MPI
 		// TEST
@@ -2177,7 +2461,7 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
 #endif
 
 		if (tt > DBL_MIN)
-			omega = dot(t, s) / tt;
+			omega = ts / tt;
 		else
 			omega = 1.0;
 		// Update solution
@@ -2187,8 +2471,10 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
 			r[i] = s[i] - omega * t[i];
 		}
 		rho_0 = rho_1;
-		//
-		const double norm_v1 = sqrt(dot(r, r));
+		// |r|^2 and (r0, r) of the next iteration with one global reduction
+		double norm_v1;
+		dot2(r, r, r0, r, norm_v1, rho_1);
+		norm_v1 = sqrt(norm_v1);
 
 #ifdef TEST_MPI
 		// TEST
@@ -52,6 +52,9 @@ namespace Math_Group
 using namespace std;
 
 class SparseTable;
+#if !defined(USE_MPI)
+class EigenDirectSolver;
+#endif
 //
 class Linear_EQS
 {
@@ -94,9 +97,10 @@ public:
 	int Solver();
 #endif
 	int CG();
+	int PipeCG(); // CG with one reduction per iteration
 	int BiCG(); // 02.2010. WW
 	int BiCGStab();
-	int Gauss() { return -1; }
+	int Gauss(); // Sparse direct solver
 	int QMRCGStab() { return -1; }
 	int CGNR() { return -1; }
 	int CGS();
@@ -137,6 +141,10 @@ private: // Dot not remove this!
 	double* b;
 	double* x;
 	double* prec_M;
+#if !defined(USE_MPI)
+	/// Factorization of A for the direct solver, kept between the calls
+	EigenDirectSolver* direct_solver;
+#endif
 //
 #ifdef LIS
 	// lis solver interface starts here
@@ -171,6 +179,10 @@ private: // Dot not remove this!
 	long size_A;
 	// Operators
 	double dot(const double* xx, const double* yy);
+	void dot2(const double* x1, const double* y1, const double* x2, const double* y2, double& d1, double& d2);
+#if !defined(USE_MPI)
+	double axpy_dot(double* yy, const double a, const double* xx, const double* zz);
+#endif
 	inline double Norm(const double* xx) { return sqrt(dot(xx, xx)); }
 	inline bool CheckNormRHS(const double normb_new);
 #ifdef JFNK_H2M
@@ -14,6 +14,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <set>
 
 #include <mpi.h>
 
@@ -216,7 +217,7 @@ void gatherR(const CommunicationTable& ct, Math_Group::Vec& globalR_plus, Math_G
 	}
 }
 
-void gatherK(const CommunicationTable& ct, Math_Group::SparseMatrixDOK& globalK)
+void gatherK(const CommunicationTable& ct, Math_Group::SparseMatrixCSR& globalK)
 {
 	int myrank = 0;
 	MPI_Comm_rank(MPI_COMM_WORLD, &myrank);
@@ -327,31 +328,27 @@ void gatherK(const CommunicationTable& ct, Math_Group::SparseMatrixDOK& globalK)
 	//	}
 }
 
-void computeD(const MeshLib::CFEMesh* m_msh, const Math_Group::SparseMatrixDOK& K, Math_Group::SparseMatrixDOK& d)
+void computeD(const MeshLib::CFEMesh* m_msh, const Math_Group::SparseMatrixCSR& K, Math_Group::SparseMatrixCSR& d)
 {
 	int myrank = 0;
 	MPI_Comm_rank(MPI_COMM_WORLD, &myrank);
 
-	const Math_Group::SparseMatrixDOK::mat_t& fct_f = K.GetRawData();
-	const Math_Group::SparseMatrixDOK::col_t* col;
-	Math_Group::SparseMatrixDOK::mat_t::const_iterator ii;
-	Math_Group::SparseMatrixDOK::col_t::const_iterator jj;
-
+	// d has the pattern of K
 	const size_t node_size = m_msh->NodesInUsage();
 	for (size_t i = 0; i < node_size; i++)
 	{
 		const size_t i_glob = FCT_GLOB_ADDRESS(i);
-		col = &fct_f[i_glob];
-		for (jj = col->begin(); jj != col->end(); jj++)
+		const long ii = K.Find(i_glob, i_glob);
+		for (size_t k = K.RowBegin(i_glob); k < K.RowEnd(i_glob); k++)
 		{
-			const size_t j = (*jj).first;
-			const size_t j_glob = j; // FCT_GLOB_ADDRESS(j);
+			const size_t j_glob = K.Column(k);
 			if (i_glob > j_glob || i_glob == j_glob)
 				continue; // symmetric part, off-diagonal
 
 			// Get artificial diffusion operator D
-			double K_ij = K(i_glob, j_glob);
-			double K_ji = K(j_glob, i_glob);
+			const size_t kt = K.Transposed(k);
+			double K_ij = K.Value(k);
+			double K_ji = K.Value(kt);
 			if (K_ij == 0.0 && K_ji == 0.0)
 				continue;
 			double d1 = GetFCTADiff(K_ij, K_ji);
@@ -359,21 +356,16 @@ void computeD(const MeshLib::CFEMesh* m_msh, const Math_Group::SparseMatrixDOK&
 			// if (list_bc_nodes.find(i)!=list_bc_nodes.end() || list_bc_nodes.find(j)!=list_bc_nodes.end()) {
 			//  d1 = d0 = 0.0;
 			//}
-			d(i_glob, j_glob) += d1;
-			d(j_glob, i_glob) += d1;
-			d(i_glob, i_glob) += -d1;
+			d.Value(k) += d1;
+			d.Value(kt) += d1;
+			d.Value(ii) += -d1;
 			d(j_glob, j_glob) += -d1;
 		}
 	}
 }
 
-void debugADFlux(int myrank, MeshLib::CFEMesh* m_msh, size_t node_size, Math_Group::SparseMatrixDOK::mat_t& fct_f)
+void debugADFlux(int myrank, MeshLib::CFEMesh* m_msh, size_t node_size, const Math_Group::SparseMatrixCSR& fct_f)
 {
-	using Math_Group::SparseMatrixDOK;
-
-	SparseMatrixDOK::col_t* col;
-	SparseMatrixDOK::mat_t::const_iterator ii;
-	SparseMatrixDOK::col_t::const_iterator jj;
 	int n_ranks;
 	MPI_Comm_size(MPI_COMM_WORLD, &n_ranks);
 	MPI_Status status;
@@ -391,12 +383,11 @@ void debugADFlux(int myrank, MeshLib::CFEMesh* m_msh, size_t node_size, Math_Gro
 	for (size_t i = 0; i < node_size; i++)
 	{
 		const size_t i_global = FCT_GLOB_ADDRESS(i);
-		col = &fct_f[i];
-		for (jj = col->begin(); jj != col->end(); jj++)
+		for (size_t k = fct_f.RowBegin(i); k < fct_f.RowEnd(i); k++)
 		{
-			const size_t j = (*jj).first;
+			const size_t j = fct_f.Column(k);
 			const size_t j_global = FCT_GLOB_ADDRESS(j);
-			std::cout << i_global << ", " << j_global << ": " << jj->second << "\n";
+			std::cout << i_global << ", " << j_global << ": " << fct_f.Value(k) << "\n";
 		}
 	}
 	std::cout << std::flush;
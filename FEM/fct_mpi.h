@@ -18,7 +18,7 @@
 
 #include "../MSH/msh_mesh.h"
 
-#include "SparseMatrixDOK.h"
+#include "SparseMatrixCSR.h"
 #include "mathlib.h"
 
 namespace FCT_MPI
@@ -52,13 +52,13 @@ extern FCT_MPI::CommunicationTable ct;
 
 void FCTCommRead(const std::string& file_base_name);
 
-void gatherK(const CommunicationTable& ct, Math_Group::SparseMatrixDOK& globalK);
+void gatherK(const CommunicationTable& ct, Math_Group::SparseMatrixCSR& globalK);
 
 void gatherR(const CommunicationTable& ct, Math_Group::Vec& globalR_plus, Math_Group::Vec& globalR_min);
 
-void computeD(const MeshLib::CFEMesh* m_msh, const Math_Group::SparseMatrixDOK& K, Math_Group::SparseMatrixDOK& d);
+void computeD(const MeshLib::CFEMesh* m_msh, const Math_Group::SparseMatrixCSR& K, Math_Group::SparseMatrixCSR& d);
 
-void debugADFlux(int myrank, MeshLib::CFEMesh* m_msh, size_t node_size, Math_Group::SparseMatrixDOK::mat_t& fct_f);
+void debugADFlux(int myrank, MeshLib::CFEMesh* m_msh, size_t node_size, const Math_Group::SparseMatrixCSR& fct_f);
 
 #endif
 
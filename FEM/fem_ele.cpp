@@ -22,6 +22,7 @@
 #include "femlib.h"
 #include "mathlib.h"
 
+#include "ElementGeometryCache.h"
 #include "ShapeFunctionPool.h"
 
 namespace FiniteElement
@@ -39,7 +40,7 @@ CElement::CElement(int CoordFlag, const int order)
     : MeshElement(NULL), Order(order), ele_dim(1), _ele_global_dim(1),
       nGaussPoints(1), nGauss(2), ShapeFunction(NULL),
       ShapeFunctionHQ(NULL), GradShapeFunction(NULL), GradShapeFunctionHQ(NULL),
-      _is_mixed_order(false), T_Flag(false),
+      _geometry_cache(NULL), _is_mixed_order(false), T_Flag(false),
       C_Flag(false), F_Flag(false), D_Flag(0), RD_Flag(false),
       extrapo_method(ExtrapolationMethod::EXTRAPO_LINEAR)
 {
@@ -132,6 +133,7 @@ CElement::~CElement()
 	delete[] _inv_jacobian_all;
 	delete[] _dshapefct_all;
 	delete[] _dshapefctHQ_all;
+	delete _geometry_cache;
 
 #if defined(USE_PETSC) // || defined(other parallel libs)//03~04.3012. WW
 	if (idxm)
@@ -1130,12 +1132,51 @@ void CElement::getLocalGradShapefunctValues(const int gp, const int order)
 
 void CElement::ComputeGradShapefctInElement(const bool is_face_integration)
 {
+	// Face elements are not part of the cached mesh
+	const bool use_cache = (_geometry_cache && !is_face_integration);
+	if (use_cache)
+	{
+		setOrder(Order);
+		const size_t n_inv = nGaussPoints * ele_dim * ele_dim;
+		const size_t n_dshape = nGaussPoints * nNodes * _ele_global_dim;
+		double* dshp_fct = (Order == 1) ? _dshapefct_all : _dshapefctHQ_all;
+		if (_geometry_cache->restore(MeshElement, Order, nGaussPoints, _determinants_all, _inv_jacobian_all, n_inv,
+		                             dshp_fct, n_dshape))
+		{
+			// Leave the pointers at the last integration point as the computation does
+			const int last_gp = nGaussPoints - 1;
+			getLocalGradShapefunctValues(last_gp, Order);
+			invJacobian = &_inv_jacobian_all[last_gp * ele_dim * ele_dim];
+			if (axisymmetry)
+				calculateRadius(last_gp);
+			return;
+		}
+	}
+
 	for (int gp = 0; gp < nGaussPoints; gp++)
 	{
 		getLocalGradShapefunctValues(gp, Order);
 		computeJacobian(gp, Order);
 		ComputeGradShapefct(gp, Order, is_face_integration);
 	}
+
+	if (use_cache)
+		_geometry_cache->store(MeshElement, Order, nGaussPoints, _determinants_all, _inv_jacobian_all,
+		                       nGaussPoints * ele_dim * ele_dim, (Order == 1) ? _dshapefct_all : _dshapefctHQ_all,
+		                       nGaussPoints * nNodes * _ele_global_dim);
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Create the store of the element geometry at the integration points
+         precision: 0 off, 1 double, 2 single precision
+**************************************************************************/
+void CElement::setGeometryCache(const std::size_t n_elements, const int precision, const double max_megabytes)
+{
+	delete _geometry_cache;
+	_geometry_cache = NULL;
+	if (precision > 0)
+		_geometry_cache = new ElementGeometryCache(n_elements, precision == 2, max_megabytes);
 }
 
 /***************************************************************************
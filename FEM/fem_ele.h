@@ -70,6 +70,7 @@ using MeshLib::CEdge;
 using MeshLib::CElem;
 
 class ShapeFunctionPool;
+class ElementGeometryCache;
 
 class CElement
 {
@@ -96,6 +97,11 @@ public:
 
 	const ShapeFunctionPool* getShapeFunctionPool(int order_id) const { return _shape_function_pool_ptr[order_id]; }
 
+	/// Keep the Jacobians and global shape function gradients of the elements
+	/// (see ElementGeometryCache). 0: off, 1: double, 2: single precision.
+	void setGeometryCache(const std::size_t n_elements, const int precision, const double max_megabytes);
+	const ElementGeometryCache* getGeometryCache() const { return _geometry_cache; }
+
 	// Get Gauss integration information
 	double GetGaussData(int gp, int& gp_r, int& gp_s, int& gp_t);
 
@@ -272,6 +278,9 @@ protected:
 
 	void getGradShapeFunctionPtr(const MshElemType::type elem_type);
 
+	/// Optional store of the geometry results of ComputeGradShapefctInElement
+	ElementGeometryCache* _geometry_cache;
+
 	// Get the values of the local gradient of shape functions at integral point gp
 	void getLocalGradShapefunctValues(const int gp, const int order);
 
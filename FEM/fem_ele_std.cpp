@@ -25,7 +25,8 @@
 #include "rf_mmp_new.h"
 #include "rf_msp_new.h"
 #include "eos.h"
-#include "SparseMatrixDOK.h"
+#include "SparseMatrixCSR.h"
+#include "LocalAssemblyKernels.h"
 
 #include "pcs_dm.h" // displacement coupled
 #include "rfmat_cp.h"
@@ -2204,14 +2205,19 @@ void CFiniteElementStd::CalCoefLaplace(bool Gravity, int ip)
 					for (size_t j = 0; j < dim; j++)
 						tensor[dim * i + j] = global_tensor(i, j);
 			}
-			variables[0] = interpolate(NodalVal1); // OK4709 pressure
-			if (T_Flag)
-				variables[1] = interpolate(NodalValC); // OK4709 temperature
-			else
-				variables[1] = 15; // WX
+			if (gp_viscosity.empty())
+			{
+				variables[0] = interpolate(NodalVal1); // OK4709 pressure
+				if (T_Flag)
+					variables[1] = interpolate(NodalValC); // OK4709 temperature
+				else
+					variables[1] = 15; // WX
 
-			// OK4709
-			mat_fac = FluidProp->Viscosity(variables);
+				// OK4709
+				mat_fac = FluidProp->Viscosity(variables);
+			}
+			else
+				mat_fac = gp_viscosity[ip];
 			// OK4709 mat_fac = FluidProp->Viscosity();
 			if (gravity_constant < MKleinsteZahl) // HEAD version
 				mat_fac = 1.0;
@@ -2514,7 +2520,10 @@ void CFiniteElementStd::CalCoefLaplace(bool Gravity, int ip)
 			// The following line only applies when Fluid Momentum is on
 			PG = interpolate(NodalVal1); // 05.01.07 WW
 			// 05.01.07 WW
-			Sw = MediaProp->SaturationCapillaryPressureFunction(-PG);
+			if (gp_saturation.empty())
+				Sw = MediaProp->SaturationCapillaryPressureFunction(-PG);
+			else
+				Sw = gp_saturation[ip];
 
 			if (MediaProp->permeability_pressure_model > 0) // 12.2012. WX
 				fac_perm = MediaProp->PermeabilityFunctionPressure(Index, PG);
@@ -2526,7 +2535,10 @@ void CFiniteElementStd::CalCoefLaplace(bool Gravity, int ip)
 			if (MediaProp->unconfined_flow_group == 2) // 3D unconfined GW JOD, 5.3.07
 				mat_fac = time_unit_factor * MediaProp->PermeabilitySaturationFunction(-PG, 0) / FluidProp->Viscosity();
 			else
-				mat_fac = time_unit_factor * MediaProp->PermeabilitySaturationFunction(Sw, 0) / FluidProp->Viscosity();
+			{
+				k_rel = gp_rel_perm.empty() ? MediaProp->PermeabilitySaturationFunction(Sw, 0) : gp_rel_perm[ip];
+				mat_fac = time_unit_factor * k_rel / FluidProp->Viscosity();
+			}
 			// Modified LBNL model WW
 			if (MediaProp->permeability_stress_mode > 1)
 			{
@@ -3474,7 +3486,10 @@ double CFiniteElementStd::CalCoefAdvection()
 				dens_arg[0] = interpolate(NodalValC1);
 				dens_arg[1] = interpolate(NodalVal1) + PhysicalConstant::CelsiusZeroInKelvin;
 				dens_arg[2] = Index;
-				val = FluidProp->SpecificHeatCapacity(dens_arg) * FluidProp->Density(dens_arg);
+				if (gp_density.empty())
+					val = FluidProp->SpecificHeatCapacity(dens_arg) * FluidProp->Density(dens_arg);
+				else
+					val = FluidProp->SpecificHeatCapacity(dens_arg) * gp_density[gp];
 			}
 			else
 				val = FluidProp->SpecificHeatCapacity() * FluidProp->Density();
@@ -3677,15 +3692,7 @@ void CFiniteElementStd::CalcMass()
 				}
 			}
 #else
-			for (i = 0; i < nnodes; i++)
-				for (j = 0; j < nnodes; j++)
-				{
-					// NW
-					if (pcs->m_num->ele_supg_method == 0)
-						if (j > i)
-							continue;
-					(*Mass)(i, j) += mat_fac * shapefct[i] * shapefct[j];
-				}
+			LocalAssemblyKernels::outerProduct(nnodes, mat_fac, shapefct, shapefct, Mass->getEntryArray(), Mass->Cols());
 #endif
 			if (pcs->m_num->ele_supg_method > 0) // NW
 			{
@@ -3707,9 +3714,8 @@ void CFiniteElementStd::CalcMass()
 					}
 				}
 #else
-				for (i = 0; i < nnodes; i++)
-					for (j = 0; j < nnodes; j++)
-						(*Mass)(i, j) += mat_fac * tau * weight_func[i] * shapefct[j];
+				LocalAssemblyKernels::outerProduct(nnodes, mat_fac * tau, weight_func, shapefct, Mass->getEntryArray(),
+				                                   Mass->Cols());
 #endif
 			}
 		} // end else
@@ -4691,7 +4697,6 @@ void CFiniteElementStd::CalcStorage()
  **************************************************************************/
 void CFiniteElementStd::CalcContent()
 {
-	int i, j;
 	// ---- Gauss integral
 	int gp_r = 0, gp_s = 0, gp_t = 0;
 	double fkt, mat_fac;
@@ -4715,18 +4720,16 @@ void CFiniteElementStd::CalcContent()
 		fkt *= mat_fac;
 // Calculate mass matrix
 #if defined(USE_PETSC) // || defined(other parallel libs)//03~04.3012. WW
-		for (i = 0; i < act_nodes; i++)
+		for (int i = 0; i < act_nodes; i++)
 		{
 			const int ia = local_idx[i];
-			for (j = 0; j < nnodes; j++)
+			for (int j = 0; j < nnodes; j++)
 			{
 				(*Content)(ia, j) += fkt * shapefct[ia] * shapefct[j];
 			}
 		}
 #else
-		for (i = 0; i < nnodes; i++)
-			for (j = 0; j < nnodes; j++)
-				(*Content)(i, j) += fkt * shapefct[i] * shapefct[j];
+		LocalAssemblyKernels::outerProduct(nnodes, fkt, shapefct, shapefct, Content->getEntryArray(), Content->Cols());
 #endif
 	}
 }
@@ -4764,6 +4767,15 @@ void CFiniteElementStd::CalcLaplace()
 		dof_n = 3;
 	}
 
+#if !defined(USE_PETSC)
+	const std::size_t laplace_cols = Laplace->Cols();
+#endif
+	// The following "if" is done by WW
+	const bool unconfined = (PcsType == EPT_GROUNDWATER_FLOW && MediaProp->unconfined_flow_group == 1
+	                         && MeshElement->ele_dim == 2 && !pcs->m_msh->hasCrossSection());
+	if (dof_n == 1)
+		CalcLaplaceMaterialsAtGaussPoints();
+
 	//----------------------------------------------------------------------
 	// Loop over Gauss points
 	for (gp = 0; gp < nGaussPoints; gp++)
@@ -4778,9 +4790,7 @@ void CFiniteElementStd::CalcLaplace()
 		getGradShapefunctValues(gp, 1);
 		getShapefunctValues(gp, 1); // For thoese used in the material parameter caculation
 		// Calculate mass matrix
-		// The following "if" is done by WW
-		if (PcsType == EPT_GROUNDWATER_FLOW && MediaProp->unconfined_flow_group == 1 && MeshElement->ele_dim == 2
-		    && !pcs->m_msh->hasCrossSection())
+		if (unconfined)
 		{
 			double water_depth = 0.0;
 			for (int i = 0; i < nnodes; i++)
@@ -4834,30 +4844,60 @@ void CFiniteElementStd::CalcLaplace()
 				} // i: nodes
 #else
 				//---------------------------------------------------------
-				for (int i = 0; i < nnodes; i++)
-				{
-					const int iish = i + ish;
-					for (int j = 0; j < nnodes; j++)
-					{
-						const int jjsh = j + jsh;
-						//  if(j>i) continue;
-						for (size_t k = 0; k < dim; k++)
-						{
-							const int ksh = k * nnodes + i;
-							const int km = dim * k;
-							for (size_t l = 0; l < dim; l++)
-							{
-								(*Laplace)(iish, jjsh) += fkt * dshapefct[ksh] * mat[km + l]
-								                          * dshapefct[l * nnodes + j];
-							}
-						}
-					} // j: nodes
-				} // i: nodes
+				LocalAssemblyKernels::gradKGrad(nnodes, dim, fkt, dshapefct, mat,
+				                                Laplace->getEntryArray() + ish * laplace_cols + jsh, laplace_cols);
 #endif
 			}
 		}
 	} //	//TEST OUTPUT
 	// Laplace->Write();
+	gp_saturation.clear();
+	gp_rel_perm.clear();
+	gp_viscosity.clear();
+}
+
+/***************************************************************************
+   FEMLib-Method:
+   Task: Evaluate the material functions of CalCoefLaplace for all Gauss
+         points of the element with one call each, so that the model is
+         selected once per element instead of once per Gauss point:
+         saturation and relative permeability for Richards flow, viscosity
+         for liquid flow.
+ **************************************************************************/
+void CFiniteElementStd::CalcLaplaceMaterialsAtGaussPoints()
+{
+	const int n = nGaussPoints;
+	if (PcsType == EPT_RICHARDS_FLOW)
+	{
+		if (MediaProp->unconfined_flow_group == 2) // k_rel of the pressure head
+			return;
+		std::vector<double> capillary_pressure(n);
+		for (int i = 0; i < n; i++)
+		{
+			getShapefunctValues(i, 1);
+			capillary_pressure[i] = -interpolate(NodalVal1);
+		}
+		gp_saturation.resize(n);
+		gp_rel_perm.resize(n);
+		MediaProp->SaturationCapillaryPressureFunction(&capillary_pressure[0], n, &gp_saturation[0]);
+		MediaProp->PermeabilitySaturationFunction(&gp_saturation[0], n, 0, &gp_rel_perm[0]);
+	}
+	else if (PcsType == EPT_LIQUID_FLOW)
+	{
+		// The viscosity is not used for the head version
+		if (gravity_constant < MKleinsteZahl || HEAD_Flag || !FluidProp->isReentrant())
+			return;
+		std::vector<double> p(n), T(n, 15.0); // WX
+		for (int i = 0; i < n; i++)
+		{
+			getShapefunctValues(i, 1);
+			p[i] = interpolate(NodalVal1);
+			if (T_Flag)
+				T[i] = interpolate(NodalValC);
+		}
+		gp_viscosity.resize(n);
+		FluidProp->Viscosity(&p[0], &T[0], NULL, n, &gp_viscosity[0]);
+	}
 }
 /***************************************************************************
    FEMLib-Method:
@@ -5141,6 +5181,7 @@ void CFiniteElementStd::CalcAdvection()
 	// Initial values
 	gp_t = 0;
 	(*Advection) = 0.0;
+	CalcAdvectionMaterialsAtGaussPoints();
 
 	//----------------------------------------------------------------------
 	// Loop over Gauss points
@@ -5214,10 +5255,8 @@ void CFiniteElementStd::CalcAdvection()
 			}
 		}
 #else
-		for (i = 0; i < nnodes; i++)
-			for (j = 0; j < nnodes; j++)
-				for (size_t k = 0; k < dim; k++)
-					(*Advection)(i, j) += fkt * shapefct[i] * vel[k] * dshapefct[k * nnodes + j];
+		LocalAssemblyKernels::shapeVelocityGrad(nnodes, dim, fkt, shapefct, vel, dshapefct, Advection->getEntryArray(),
+		                                        Advection->Cols());
 #endif
 		if (pcs->m_num->ele_supg_method > 0) // NW
 		{
@@ -5244,6 +5283,32 @@ void CFiniteElementStd::CalcAdvection()
 	}
 	// TEST OUTPUT
 	// cout << "Advection Matrix: " << "\n"; Advection->Write();
+	gp_density.clear();
+}
+
+/***************************************************************************
+   FEMLib-Method:
+   Task: Evaluate the fluid density of CalCoefAdvection for all Gauss points
+         of the element with one call, for heat transport with the
+         exponential density law (model 14), see the batched
+         CFluidProperties::Density.
+ **************************************************************************/
+void CFiniteElementStd::CalcAdvectionMaterialsAtGaussPoints()
+{
+	if (PcsType != EPT_HEAT_TRANSPORT || FluidProp->density_model != 14 || MediaProp->heat_diffusion_model != 1
+	    || !cpl_pcs)
+		return;
+	const int n = nGaussPoints;
+	// The element index takes the place of the concentration as in CalCoefAdvection
+	std::vector<double> p(n), T(n), C(n, static_cast<double>(Index));
+	for (int i = 0; i < n; i++)
+	{
+		getShapefunctValues(i, 1);
+		p[i] = interpolate(NodalValC1);
+		T[i] = interpolate(NodalVal1) + PhysicalConstant::CelsiusZeroInKelvin;
+	}
+	gp_density.resize(n);
+	FluidProp->Density(&p[0], &T[0], &C[0], n, &gp_density[0]);
 }
 
 /***************************************************************************
@@ -7166,6 +7231,35 @@ string CFiniteElementStd::Cal_GP_Velocity_ECLIPSE(string tempstring, bool output
  **************************************************************************/
 // Local assembly
 void CFiniteElementStd::AssembleRHS(int dimension)
+{
+	CalcRHS_FM(dimension, 1, NodalVal);
+
+	// Store the influence into the global vectors.
+	CRFProcess* m_pcs = PCSGet("FLUID_MOMENTUM");
+	for (int i = 0; i < nnodes; i++)
+	{
+#if defined(USE_PETSC) // || defined(other parallel libs)//03~04.3012. WW
+// TODO
+#elif defined(NEW_EQS) // WW
+		m_pcs->eqs_new->b[eqs_number[i]] += NodalVal[i];
+#else
+		m_pcs->eqs->b[eqs_number[i]] += NodalVal[i];
+#endif
+	}
+	// OK. Let's add gravity term that incorporates the density coupling term.
+	// This is convenient. The function is already written in RF.
+	// Assemble_Gravity();
+}
+
+/***************************************************************************
+   Task: Local RHS of the nodal velocity recovery for the velocity components
+         first_dimension, ..., first_dimension + n_dimensions - 1.
+         rhs[d * nnodes + i] receives component first_dimension + d at node i.
+         The Gauss point data are evaluated once for all components.
+   Programming:
+   05/2005   PCH   (AssembleRHS)
+ **************************************************************************/
+void CFiniteElementStd::CalcRHS_FM(int first_dimension, int n_dimensions, double* rhs)
 {
 	// ---- Gauss integral
 	int gp_r = 0, gp_s = 0, gp_t;
@@ -7214,9 +7308,11 @@ void CFiniteElementStd::AssembleRHS(int dimension)
 	}
 
 	for (int i = 0; i < nnodes; ++i)
-	{
-		NodalVal[i] = 0.0;
 		NodalVal1[i] = m_pcs->GetNodeValue(nodes[i], nidx1);
+	// NodalVal2 holds the gravity terms of all components
+	for (int i = 0; i < n_dimensions * nnodes; ++i)
+	{
+		rhs[i] = 0.0;
 		NodalVal2[i] = 0.0;
 	}
 
@@ -7256,22 +7352,28 @@ void CFiniteElementStd::AssembleRHS(int dimension)
 		//wrong.
 
 		fktG *= rho;
-		for (int i = 0; i < nnodes; i++)
-			for (int j = 0; j < nnodes; j++)
-				for (size_t k = 0; k < dim; k++)
-				{
-					NodalVal[i] -= fkt * dshapefct[k * nnodes + j]
-					               // NW  dshapefct[dimension*nnodes+j] -> dshapefct[k*nnodes+j]
-					               * mat[dim * dimension + k] * shapefct[i] * NodalVal1[j];
-					//	*************************************
-					// FS/WW 21.05.2010
-					if (HEAD_Flag)
-						continue;
-					//***************************************
-					NodalVal2[i] += fktG * dshapefct[k * nnodes + j]
-					                // NW  dshapefct[dimension*nnodes+j] -> dshapefct[k*nnodes+j]
-					                * mat[dim * dimension + k] * shapefct[i] * MeshElement->nodes[j]->getData()[2];
-				}
+		for (int d = 0; d < n_dimensions; d++)
+		{
+			const int dimension = first_dimension + d;
+			double* const rhs_d = rhs + d * nnodes;
+			double* const grav_d = NodalVal2 + d * nnodes;
+			for (int i = 0; i < nnodes; i++)
+				for (int j = 0; j < nnodes; j++)
+					for (size_t k = 0; k < dim; k++)
+					{
+						rhs_d[i] -= fkt * dshapefct[k * nnodes + j]
+						            // NW  dshapefct[dimension*nnodes+j] -> dshapefct[k*nnodes+j]
+						            * mat[dim * dimension + k] * shapefct[i] * NodalVal1[j];
+						//	*************************************
+						// FS/WW 21.05.2010
+						if (HEAD_Flag)
+							continue;
+						//***************************************
+						grav_d[i] += fktG * dshapefct[k * nnodes + j]
+						             // NW  dshapefct[dimension*nnodes+j] -> dshapefct[k*nnodes+j]
+						             * mat[dim * dimension + k] * shapefct[i] * MeshElement->nodes[j]->getData()[2];
+					}
+		}
 	}
 
 	// Just influence when it's the gravitational direction in the case of Liquid_Flow
@@ -7289,31 +7391,20 @@ void CFiniteElementStd::AssembleRHS(int dimension)
 	}
 
 	// Checking the coordinateflag for proper solution.
-	int checkZaxis = 0;
-	int coordinateflag = pcs->m_msh->GetCoordinateFlag();
-	if ((coordinateflag == 12) || (coordinateflag == 22 && dimension == 1) || (coordinateflag == 32 && dimension == 2))
-		checkZaxis = 1; // Then, this gotta be z axis.
-
-	// Compansate the gravity term along Z direction
-	if (checkZaxis && IsGroundwaterIntheProcesses == 0)
-		for (int i = 0; i < nnodes; i++)
-			NodalVal[i] -= NodalVal2[i];
-
-	// Store the influence into the global vectors.
-	m_pcs = PCSGet("FLUID_MOMENTUM");
-	for (int i = 0; i < nnodes; i++)
+	const int coordinateflag = pcs->m_msh->GetCoordinateFlag();
+	for (int d = 0; d < n_dimensions; d++)
 	{
-#if defined(USE_PETSC) // || defined(other parallel libs)//03~04.3012. WW
-// TODO
-#elif defined(NEW_EQS) // WW
-		m_pcs->eqs_new->b[eqs_number[i]] += NodalVal[i];
-#else
-		m_pcs->eqs->b[eqs_number[i]] += NodalVal[i];
-#endif
+		const int dimension = first_dimension + d;
+		int checkZaxis = 0;
+		if ((coordinateflag == 12) || (coordinateflag == 22 && dimension == 1)
+		    || (coordinateflag == 32 && dimension == 2))
+			checkZaxis = 1; // Then, this gotta be z axis.
+
+		// Compansate the gravity term along Z direction
+		if (checkZaxis && IsGroundwaterIntheProcesses == 0)
+			for (int i = 0; i < nnodes; i++)
+				rhs[d * nnodes + i] -= NodalVal2[d * nnodes + i];
 	}
-	// OK. Let's add gravity term that incorporates the density coupling term.
-	// This is convenient. The function is already written in RF.
-	// Assemble_Gravity();
 }
 
 /**************************************************************************
@@ -7447,6 +7538,10 @@ void CFiniteElementStd::AssembleParabolicEquation()
 		Assemble_DualTransfer();
 	if (pcs->Tim->time_control_type == TimeControlType::NEUMANN)
 		pcs->timebuffer /= mat[0]; // YD
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	if (pcs->isOperatorRecording())
+		RecordLinearOperator(false);
+#endif
 	//======================================================================
 	// Assemble global matrix
 	//----------------------------------------------------------------------
@@ -7998,7 +8093,7 @@ void CFiniteElementStd::CalcFEM_FCT()
 	//----------------------------------------------------------------------
 	// Initialize FCT flux with consistent mass matrix: f_ij = m_ij
 	//----------------------------------------------------------------------
-	Math_Group::SparseMatrixDOK* FCT_Flux = this->pcs->FCT_AFlux;
+	Math_Group::SparseMatrixCSR* FCT_Flux = this->pcs->FCT_AFlux;
 	for (int i = 0; i < nnodes; i++)
 	{
 		long node_i_id = this->MeshElement->nodes_index[i];
@@ -8183,6 +8278,10 @@ void CFiniteElementStd::AssembleMixedHyperbolicParabolicEquation()
 		Storage = EleMat->GetStorage();
 		Content = EleMat->GetContent();
 	} // pcs->tim_type    //SB-3
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	if (pcs->isOperatorRecording())
+		RecordLinearOperator(true);
+#endif
 	//======================================================================
 	// Assemble global matrix
 	//----------------------------------------------------------------------
@@ -8312,6 +8411,46 @@ void CFiniteElementStd::AssembleMixedHyperbolicParabolicEquation()
 	   }
 	 */
 }
+#if defined(NEW_EQS) && !defined(USE_MPI)
+/**************************************************************************
+   FEMLib-Method:
+   Task: Add the element mass and stiffness matrices to the global
+         matrices which the process keeps for the next time steps
+         ($OPERATOR_REUSE). For transport, the stiffness matrix includes
+         advection and decay. A content matrix (saturation or porosity
+         change) can not be kept, the recording is then cancelled.
+**************************************************************************/
+void CFiniteElementStd::RecordLinearOperator(const bool with_transport_terms)
+{
+	*AuxMatrix = *Laplace;
+	if (with_transport_terms)
+	{
+		const double* content = Content->getEntryArray();
+		for (size_t i = 0; i < Content->Size(); i++)
+		{
+			if (content[i] != 0.0)
+			{
+				pcs->cancelOperatorRecording();
+				return;
+			}
+		}
+		*AuxMatrix += *Advection;
+		*AuxMatrix += *Storage;
+	}
+
+	CSparseMatrix* M = pcs->getOperatorMass();
+	CSparseMatrix* K = pcs->getOperatorStiffness();
+	for (int i = 0; i < nnodes; i++)
+	{
+		for (int j = 0; j < nnodes; j++)
+		{
+			(*M)(eqs_number[i], eqs_number[j]) += (*Mass)(i, j);
+			(*K)(eqs_number[i], eqs_number[j]) += (*AuxMatrix)(i, j);
+		}
+	}
+}
+#endif
+
 /**************************************************************************
    FEMLib-Method:
    Task: Assemble local matrices of parabolic equation to the global system
@@ -8638,29 +8777,18 @@ void CFiniteElementStd::Assemble_strainCPL_Matrix(const double fac, const int ph
 
 /**************************************************************************
    FEMLib-Method:
-   Task: Assemble local mass matrices to the global system
+   Task: Local mass matrix of the nodal velocity recovery (fluid momentum)
+         option 0: consistent, 1: lumped
    Programing:
    05/2005 PCH Implementation
 **************************************************************************/
-void CFiniteElementStd::AssembleMassMatrix(int option)
+void CFiniteElementStd::CalcMassFM(int option)
 {
-	// Calculate matrices
 	// Mass matrix..........................................................
 	// ---- Gauss integral
 	int gp;
 	int gp_r = 0, gp_s = 0, gp_t = 0;
 	double fkt; // WW ,mat_fac;
-// Material
-// WW mat_fac = 1.0;
-
-#if defined(NEW_EQS)
-	CSparseMatrix* A = NULL; // PCH
-	if (m_dom)
-		A = m_dom->eqs->A;
-	else
-		A = pcs->eqs_new->A;
-#endif
-	//----------------------------------------------------------------------
 	//======================================================================
 	// Loop over Gauss points
 	for (gp = 0; gp < nGaussPoints; gp++)
@@ -8689,6 +8817,24 @@ void CFiniteElementStd::AssembleMassMatrix(int option)
 				for (int j = 0; j < nnodes; j++)
 					(*Mass)(i, i) += fkt * shapefct[i] * shapefct[j];
 	}
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Assemble local mass matrices to the global system
+   Programing:
+   05/2005 PCH Implementation
+**************************************************************************/
+void CFiniteElementStd::AssembleMassMatrix(int option)
+{
+#if defined(NEW_EQS)
+	CSparseMatrix* A = NULL; // PCH
+	if (m_dom)
+		A = m_dom->eqs->A;
+	else
+		A = pcs->eqs_new->A;
+#endif
+	CalcMassFM(option);
 
 //----------------------------------------------------------------------
 // Add local matrix to global matrix
@@ -9252,6 +9398,34 @@ void CFiniteElementStd::Assembly(int option, int dimension)
 		(*pcs->matrix_file) << "\n";
 	}
 }
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Local system of the nodal velocity recovery (Fluid Momentum)
+         without adding it to a global equation system.
+         local_mass: nnodes x nnodes, row major, skipped if NULL
+         local_rhs:  nnodes values per velocity component
+   Programing:
+   08/2005 PCH for Fluid_Momentum (Assembly)
+**************************************************************************/
+void CFiniteElementStd::LocalAssembly_VelocityRecovery(int option, int n_dimensions, double* local_mass,
+                                                       double* local_rhs)
+{
+	// Get room in the memory for local matrices
+	SetMemory();
+	// Set material
+	SetMaterial();
+
+	if (local_mass)
+	{
+		(*Mass) = 0.0;
+		CalcMassFM(option);
+		for (int i = 0; i < nnodes; i++)
+			for (int j = 0; j < nnodes; j++)
+				local_mass[i * nnodes + j] = (*Mass)(i, j);
+	}
+	CalcRHS_FM(0, n_dimensions, local_rhs);
+}
 /**************************************************************************
    FEMLib-Method:
    Task:
@@ -120,6 +120,8 @@ public:
 	// 3. Laplace matrix
 	void CalcLaplace();
 	void CalcLaplaceMCF(); // AKS
+	void CalcLaplaceMaterialsAtGaussPoints();
+	void CalcAdvectionMaterialsAtGaussPoints();
 	// 4. Gravity term
 	void CalcGravity();
 	// 5. Strain coupling matrix
@@ -147,6 +149,8 @@ public:
 	// Assembly
 	void Assembly();
 	void Assembly(int option, int dimension); // PCH for Fluid Momentum
+	// Local mass matrix (optional) and RHS of all velocity components for Fluid Momentum
+	void LocalAssembly_VelocityRecovery(int option, int n_dimensions, double* local_mass, double* local_rhs);
 	void Cal_Velocity();
 
 	void CalcSolidDensityRate(); // HS thermal storage application, calculate rho_s
@@ -275,6 +279,12 @@ private:
 	// Gauss point value. Buffers. // Some changes. 27.2.2007 WW
 	double TG, TG0, PG, PG0, PG2, PG20, drho_gw_dT;
 	double Sw, rhow, poro, dSdp;
+	// Material values of all Gauss points of the element, evaluated at once
+	// by CalcLaplaceMaterialsAtGaussPoints. Empty outside of CalcLaplace.
+	std::vector<double> gp_saturation, gp_rel_perm, gp_viscosity;
+	// Fluid density of all Gauss points, evaluated at once by
+	// CalcAdvectionMaterialsAtGaussPoints. Empty outside of CalcAdvection.
+	std::vector<double> gp_density;
 	double rho_gw, rho_ga, rho_g, p_gw, M_g, tort, Xw, eos_arg[5], heat_capacity, heat_conductivity, viscosity;
 
 	//
@@ -376,6 +386,10 @@ protected:
 	// Assembly of parabolic equation
 	void AssembleParabolicEquation(); // OK4104
 	void AssembleMixedHyperbolicParabolicEquation();
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	// Add the element matrices to the operator cache of a linear process
+	void RecordLinearOperator(const bool with_transport_terms);
+#endif
 	void AssembleParabolicEquationNewton();
 	// JOD
 	void AssembleParabolicEquationNewtonJacobian(double** jacob,
@@ -392,6 +406,7 @@ protected:
 	void Assemble_strainCPL_Matrix(const double fac, const int phase = 0);
 
 	void AssembleMassMatrix(int option); // PCH
+	void CalcMassFM(int option);
 	// Assembly of RHS by Darcy's gravity term
 	void Assemble_Gravity();
 	void Assemble_GravityMCF(); // AKS
@@ -408,6 +423,7 @@ protected:
 	void Assemble_RHS_HEAT_TRANSPORT2(); // AKS
 	void Assemble_RHS_T_PSGlobal(); // Assembly of RHS by temperature for PSGlobal
 	void AssembleRHS(int dimension); // PCH
+	void CalcRHS_FM(int first_dimension, int n_dimensions, double* rhs);
 	void Assemble_RHS_LIQUIDFLOW(); // NW
 	void Assemble_DualTransfer();
 	bool check_matrices; // OK4104
@@ -12,6 +12,7 @@
    Designed and programmed by WW, 06/2004
  */
 
+#include <algorithm>
 #include <cfloat>
 //#include "makros.h"
 //#include <iostream>
@@ -847,6 +848,9 @@ void CFiniteElementVec::ComputeMatrix_RHS(const double fkt, const Matrix* p_D)
 	Matrix* tmp_AuxMatrix = AuxMatrix;
 	Matrix* tmp_AuxMatrix2 = AuxMatrix2;
 	Matrix* tmp_Stiffness = Stiffness;
+	// The global stiffness matrix is restored from the last assembly,
+	// only the RHS is needed then
+	const bool stiffness_reused = pcs->isStiffnessReused();
 
 	for (i = 0; i < nnodesHQ; i++)
 	{
@@ -861,6 +865,8 @@ void CFiniteElementVec::ComputeMatrix_RHS(const double fkt, const Matrix* p_D)
 			continue;
 		if (excavation)
 			continue; // WX:08.2011
+		if (stiffness_reused)
+			continue;
 // Local assembly of stiffness matrix, B^T C B
 #ifdef JFNK_H2M
 		/// If JFNK. 18.10.2010. WW
@@ -1271,6 +1277,9 @@ bool CFiniteElementVec::GlobalAssembly()
 	GlobalAssembly_RHS();
 	if (PreLoad == 11)
 		return true;
+	// The global stiffness matrix is restored from the last assembly
+	if (pcs->isStiffnessReused())
+		return true;
 
 	// For excavation simulation. 12.2009. WW
 	if (excavation) // WX: modify
@@ -2433,90 +2442,62 @@ void CFiniteElementVec::GlobalAssembly_RHS()
 
 			if (smat->Creep_mode == 1001) // BURGERS.
 			{
-				// get total strains at time t and current iteration i
-				std::vector<double> strain_t(6), strain_curr(6);
-
-				// get stresses as well as internal variables at time t and current iteration i (equal before local
-				// Newton)
-				std::vector<double> stress_curr(6), eps_K_curr(6), eps_M_curr(6);
-				for (int compnt(0); compnt < ns; compnt++)
-				{
-					strain_t[compnt] = (*eleV_DM->Strain_t_ip)(compnt, gp);
-					strain_curr[compnt] = strain_t[compnt] + dstrain[compnt];
-					stress_curr[compnt] = (*eleV_DM->Stress)(compnt, gp);
-					eps_K_curr[compnt] = (*eleV_DM->Strain_Kel)(compnt, gp);
-					eps_M_curr[compnt] = (*eleV_DM->Strain_Max)(compnt, gp);
-				}
-				// Fill remaining 3D components with 0 if only 2D
-				if (ns == 4)
-					for (int compnt(4); compnt < 6; compnt++)
-					{
-						strain_t[compnt] = 0.0;
-						strain_curr[compnt] = 0.0;
-						stress_curr[compnt] = 0.0;
-						eps_K_curr[compnt] = 0.0;
-						eps_M_curr[compnt] = 0.0;
-					}
+				// Gauss point values are taken directly from column gp of the element storage.
+				// Components beyond ns are zero for 2D and AXI.
+				const int n_gp = eleV_DM->Stress->Cols();
+				// get total strains at current iteration i, and the internal variables at time t
+				SolidMath::KVec strain_curr(
+					SolidMath::Voigt_to_Kelvin_Strain(eleV_DM->Strain_t_ip->getEntryArray() + gp, ns, n_gp)
+					+ SolidMath::Voigt_to_Kelvin_Strain(dstrain, ns));
+				SolidMath::KVec stress_curr;
+				SolidMath::KVec eps_K_curr(
+					SolidMath::Voigt_to_Kelvin_Strain(eleV_DM->Strain_Kel->getEntryArray() + gp, ns, n_gp));
+				SolidMath::KVec eps_M_curr(
+					SolidMath::Voigt_to_Kelvin_Strain(eleV_DM->Strain_Max->getEntryArray() + gp, ns, n_gp));
 
 				// 6x6 tangent
-				Matrix ConsD(6, 6);
+				SolidMath::KMat ConsD;
 				// Pass as 6D vectors, i.e. set stress and strain [4] and [5] to zero for 2D and AXI as well as
 				// strain[3] to zero for 2D (plane strain)
 				double local_res;
-				smat->LocalNewtonBurgers(dt, strain_curr, stress_curr, eps_K_curr, eps_M_curr, ConsD, t1,
-										 local_res);
+				smat->LocalNewtonBurgers(dt, strain_curr, stress_curr, eps_K_curr, eps_M_curr, ConsD, t1, local_res);
 
 				// Then update (and reduce for 2D) stress increment vector and reduce (for 2D) ConsistDep, update
 				// internal variables
-				for (int compnt(0); compnt < ns; compnt++)
+				SolidMath::Kelvin_to_Voigt_Stress(stress_curr, dstress, ns);
+				if (update > 0)
 				{
-					dstress[compnt] = stress_curr[compnt];
-					if (update > 0)
-					{
-						(*eleV_DM->Strain_Kel)(compnt, gp) = eps_K_curr[compnt];
-						(*eleV_DM->Strain_Max)(compnt, gp) = eps_M_curr[compnt];
-						(*eleV_DM->Strain_t_ip)(compnt, gp) = strain_curr[compnt];
-						(*eleV_DM->ev_loc_nr_res)(gp) = local_res;
-					}
-					for (int compnt2(0); compnt2 < ns; compnt2++)
-						(*De)(compnt, compnt2) = ConsD(compnt, compnt2);
-					(*eleV_DM->Strain)(compnt, gp) = strain_curr[compnt];
+					SolidMath::Kelvin_to_Voigt_Strain(eps_K_curr, eleV_DM->Strain_Kel->getEntryArray() + gp, ns, n_gp);
+					SolidMath::Kelvin_to_Voigt_Strain(eps_M_curr, eleV_DM->Strain_Max->getEntryArray() + gp, ns, n_gp);
+					SolidMath::Kelvin_to_Voigt_Strain(strain_curr, eleV_DM->Strain_t_ip->getEntryArray() + gp, ns,
+														  n_gp);
+					(*eleV_DM->ev_loc_nr_res)(gp) = local_res;
 				}
+				SolidMath::Kelvin_to_Voigt_Tangent(ConsD, De->getEntryArray(), ns);
+				SolidMath::Kelvin_to_Voigt_Strain(strain_curr, eleV_DM->Strain->getEntryArray() + gp, ns, n_gp);
 			}
 
 			if (smat->Creep_mode == 1002) // MINKLEY
 			{
-				// get total strains at time t and current iteration i
-				std::vector<double> strain_t(6), strain_curr(6);
-
-				std::vector<double> stress_curr(6), eps_K_curr(6), eps_M_curr(6), eps_pl_curr(6);
-				for (int compnt(0); compnt < ns; compnt++)
-				{
-					stress_curr[compnt] = (*eleV_DM->Stress)(compnt, gp);
-					eps_K_curr[compnt] = (*eleV_DM->Strain_Kel)(compnt, gp);
-					eps_M_curr[compnt] = (*eleV_DM->Strain_Max)(compnt, gp);
-					eps_pl_curr[compnt] = (*eleV_DM->Strain_pl)(compnt, gp);
-					strain_t[compnt] = (*eleV_DM->Strain_t_ip)(compnt, gp);
-					strain_curr[compnt] = strain_t[compnt] + dstrain[compnt];
-				}
-				// Fill remaining 3D components with 0 if only 2D
-				if (ns == 4)
-					for (int compnt(4); compnt < 6; compnt++)
-					{
-						strain_t[compnt] = 0.0;
-						strain_curr[compnt] = 0.0;
-						stress_curr[compnt] = 0.0;
-						eps_K_curr[compnt] = 0.0;
-						eps_M_curr[compnt] = 0.0;
-						eps_pl_curr[compnt] = 0.0;
-					}
+				const int n_gp = eleV_DM->Stress->Cols();
+				// get total strains at current iteration i, and the internal variables at time t
+				SolidMath::KVec strain_curr(
+					SolidMath::Voigt_to_Kelvin_Strain(eleV_DM->Strain_t_ip->getEntryArray() + gp, ns, n_gp)
+					+ SolidMath::Voigt_to_Kelvin_Strain(dstrain, ns));
+				SolidMath::KVec stress_curr;
+				SolidMath::KVec eps_K_curr(
+					SolidMath::Voigt_to_Kelvin_Strain(eleV_DM->Strain_Kel->getEntryArray() + gp, ns, n_gp));
+				SolidMath::KVec eps_M_curr(
+					SolidMath::Voigt_to_Kelvin_Strain(eleV_DM->Strain_Max->getEntryArray() + gp, ns, n_gp));
+				SolidMath::KVec eps_pl_curr(
+					SolidMath::Voigt_to_Kelvin_Strain(eleV_DM->Strain_pl->getEntryArray() + gp, ns, n_gp));
 
 				double e_pl_v = (*eleV_DM->e_pl)(gp);
 				double e_pl_eff = (*eleV_DM->pStrain)(gp);
 				double lam = (*eleV_DM->lambda_pl)(gp);//NOTE: May set starting value to zero in case of trouble with load reversals
 
 				// 6x6 tangent
-				Matrix ConsD(6, 6);
+				SolidMath::KMat ConsD;
 
 				// Pass as 6D vectors, i.e. set stress and strain [4] and [5] to zero for 2D and AXI as well as
 				// strain[3] to zero for 2D (plane strain)
@@ -2526,20 +2507,18 @@ void CFiniteElementVec::GlobalAssembly_RHS()
 
 				// Then update (and reduce for 2D) stress increment vector and reduce (for 2D) ConsistDep, update
 				// internal variables
-				for (int compnt(0); compnt < ns; compnt++)
+				SolidMath::Kelvin_to_Voigt_Stress(stress_curr, dstress, ns);
+				if (update > 0)
 				{
-					dstress[compnt] = stress_curr[compnt];
-					if (update > 0)
-					{
-						(*eleV_DM->Strain_Kel)(compnt, gp) = eps_K_curr[compnt];
-						(*eleV_DM->Strain_Max)(compnt, gp) = eps_M_curr[compnt];
-						(*eleV_DM->Strain_pl)(compnt, gp) = eps_pl_curr[compnt];
-						(*eleV_DM->Strain_t_ip)(compnt, gp) = strain_curr[compnt];
-					}
-					for (int compnt2(0); compnt2 < ns; compnt2++)
-						(*De)(compnt, compnt2) = ConsD(compnt, compnt2);
-					(*eleV_DM->Strain)(compnt, gp) = strain_curr[compnt];
+					SolidMath::Kelvin_to_Voigt_Strain(eps_K_curr, eleV_DM->Strain_Kel->getEntryArray() + gp, ns, n_gp);
+					SolidMath::Kelvin_to_Voigt_Strain(eps_M_curr, eleV_DM->Strain_Max->getEntryArray() + gp, ns, n_gp);
+					SolidMath::Kelvin_to_Voigt_Strain(eps_pl_curr, eleV_DM->Strain_pl->getEntryArray() + gp, ns,
+														  n_gp);
+					SolidMath::Kelvin_to_Voigt_Strain(strain_curr, eleV_DM->Strain_t_ip->getEntryArray() + gp, ns,
+														  n_gp);
 				}
+				SolidMath::Kelvin_to_Voigt_Tangent(ConsD, De->getEntryArray(), ns);
+				SolidMath::Kelvin_to_Voigt_Strain(strain_curr, eleV_DM->Strain->getEntryArray() + gp, ns, n_gp);
 
 				if (update > 0)
 				{
@@ -4026,6 +4005,81 @@ void CFiniteElementVec::GlobalAssembly_RHS()
 		*Stress_i = *Stress0;
 	}
 
+	namespace
+	{
+	void saveMatrix(Matrix const* m, std::vector<double>& buffer)
+	{
+		if (m)
+			buffer.insert(buffer.end(), m->getEntryArray(), m->getEntryArray() + m->Size());
+	}
+
+	void restoreMatrix(Matrix* m, std::vector<double> const& buffer, std::size_t& offset)
+	{
+		if (!m)
+			return;
+		std::copy(buffer.begin() + offset, buffer.begin() + offset + m->Size(), m->getEntryArray());
+		offset += m->Size();
+	}
+	}
+
+	void ElementValue_DM::SaveState(std::vector<double> & buffer) const
+	{
+		saveMatrix(Stress0, buffer);
+		saveMatrix(Stress_i, buffer);
+		saveMatrix(Stress_j, buffer);
+		saveMatrix(pStrain, buffer);
+		saveMatrix(y_surface, buffer);
+		saveMatrix(xi, buffer);
+		saveMatrix(Strain, buffer);
+		saveMatrix(Strain_Kel, buffer);
+		saveMatrix(Strain_Max, buffer);
+		saveMatrix(Strain_pl, buffer);
+		saveMatrix(Strain_t_ip, buffer);
+		saveMatrix(e_pl, buffer);
+		saveMatrix(lambda_pl, buffer);
+		saveMatrix(ev_loc_nr_res, buffer);
+		saveMatrix(MatP, buffer);
+		saveMatrix(prep0, buffer);
+		saveMatrix(e_i, buffer);
+		saveMatrix(NodesOnPath, buffer);
+		if (orientation)
+			buffer.push_back(*orientation);
+		buffer.push_back(disp_j);
+		buffer.push_back(tract_j);
+		buffer.push_back(Localized ? 1.0 : 0.0);
+		// Stress points either to Stress_i or, in the coupling loop, to Stress_j
+		buffer.push_back((Stress == Stress_j) ? 1.0 : 0.0);
+	}
+
+	std::size_t ElementValue_DM::RestoreState(std::vector<double> const& buffer, std::size_t offset)
+	{
+		restoreMatrix(Stress0, buffer, offset);
+		restoreMatrix(Stress_i, buffer, offset);
+		restoreMatrix(Stress_j, buffer, offset);
+		restoreMatrix(pStrain, buffer, offset);
+		restoreMatrix(y_surface, buffer, offset);
+		restoreMatrix(xi, buffer, offset);
+		restoreMatrix(Strain, buffer, offset);
+		restoreMatrix(Strain_Kel, buffer, offset);
+		restoreMatrix(Strain_Max, buffer, offset);
+		restoreMatrix(Strain_pl, buffer, offset);
+		restoreMatrix(Strain_t_ip, buffer, offset);
+		restoreMatrix(e_pl, buffer, offset);
+		restoreMatrix(lambda_pl, buffer, offset);
+		restoreMatrix(ev_loc_nr_res, buffer, offset);
+		restoreMatrix(MatP, buffer, offset);
+		restoreMatrix(prep0, buffer, offset);
+		restoreMatrix(e_i, buffer, offset);
+		restoreMatrix(NodesOnPath, buffer, offset);
+		if (orientation)
+			*orientation = buffer[offset++];
+		disp_j = buffer[offset++];
+		tract_j = buffer[offset++];
+		Localized = (buffer[offset++] > 0.5);
+		Stress = (buffer[offset++] > 0.5) ? Stress_j : Stress_i;
+		return offset;
+	}
+
 	void ElementValue_DM::ResetStress(bool cpl_loop)
 	{
 		if (cpl_loop) // For coupling loop
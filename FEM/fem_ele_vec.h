@@ -59,6 +59,10 @@ public:
 	void Write_BIN(std::fstream& os, const bool last_step = false);
 	void Read_BIN(std::fstream& is);
 	void ReadElementStressASCI(std::fstream& is);
+	/// Append the integration point state to buffer, for the rollback of a rejected time step
+	void SaveState(std::vector<double>& buffer) const;
+	/// Restore the state written by SaveState() starting at offset. Returns the offset of the next element.
+	std::size_t RestoreState(std::vector<double> const& buffer, std::size_t offset);
 	double MeanStress(const int gp) { return (*Stress)(0, gp) + (*Stress)(1, gp) + (*Stress)(2, gp); }
 
 private:
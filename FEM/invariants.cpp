@@ -137,6 +137,79 @@ void Kelvin_to_Voigt_Stress(const KVec& kelvin_stress, std::vector<double>& voig
 	return;
 }
 
+/**************************************************************************
+   Voigt_to_Kelvin_Strain
+   Task: Maps a strain vector in Voigt notation, given by n_comp entries
+   with the distance stride in memory, into one in Kelvin notation.
+   No temporary arrays are needed for Gauss point data.
+**************************************************************************/
+KVec Voigt_to_Kelvin_Strain(const double* voigt_strain, const int n_comp, const int stride)
+{
+	KVec kelvin_strain;
+	kelvin_strain.setZero();
+	for (int i = 0; i < n_comp; i++)
+		kelvin_strain(i) = voigt_strain[i * stride];
+	for (int i = 3; i < n_comp; i++)
+		kelvin_strain(i) /= sqrt(2.);
+	return kelvin_strain;
+}
+
+/**************************************************************************
+   Voigt_to_Kelvin_Stress
+   Task: Maps a stress vector in Voigt notation, given by n_comp entries
+   with the distance stride in memory, into one in Kelvin notation.
+**************************************************************************/
+KVec Voigt_to_Kelvin_Stress(const double* voigt_stress, const int n_comp, const int stride)
+{
+	KVec kelvin_stress;
+	kelvin_stress.setZero();
+	for (int i = 0; i < n_comp; i++)
+		kelvin_stress(i) = voigt_stress[i * stride];
+	for (int i = 3; i < n_comp; i++)
+		kelvin_stress(i) *= sqrt(2.);
+	return kelvin_stress;
+}
+
+/**************************************************************************
+   Kelvin_to_Voigt_Strain()
+   Task: Writes the first n_comp components of a strain vector in Kelvin
+   notation in Voigt notation into strided storage.
+**************************************************************************/
+void Kelvin_to_Voigt_Strain(const KVec& kelvin_strain, double* voigt_strain, const int n_comp, const int stride)
+{
+	for (int i = 0; i < n_comp; i++)
+		voigt_strain[i * stride] = (i < 3) ? kelvin_strain(i) : kelvin_strain(i) * sqrt(2.);
+}
+
+/**************************************************************************
+   Kelvin_to_Voigt_Stress()
+   Task: Writes the first n_comp components of a stress vector in Kelvin
+   notation in Voigt notation into strided storage.
+**************************************************************************/
+void Kelvin_to_Voigt_Stress(const KVec& kelvin_stress, double* voigt_stress, const int n_comp, const int stride)
+{
+	for (int i = 0; i < n_comp; i++)
+		voigt_stress[i * stride] = (i < 3) ? kelvin_stress(i) : kelvin_stress(i) / sqrt(2.);
+}
+
+/**************************************************************************
+   Kelvin_to_Voigt_Tangent()
+   Task: Maps the 6x6 tangent from Kelvin notation to the global shear
+   components of Voigt notation. Only the n_comp x n_comp part is written.
+**************************************************************************/
+void Kelvin_to_Voigt_Tangent(const KMat& kelvin_tangent, double* voigt_tangent, const int n_comp)
+{
+	for (int i = 0; i < n_comp; i++)
+	{
+		const double fac_i = (i < 3) ? 1. : 1. / sqrt(2.);
+		for (int j = 0; j < n_comp; j++)
+		{
+			const double fac_j = (j < 3) ? 1. : 1. / sqrt(2.);
+			voigt_tangent[i * n_comp + j] = kelvin_tangent(i, j) * fac_i * fac_j;
+		}
+	}
+}
+
 // Maps a 6D Kelvin vector back into 3D Tensor coordinates
 Eigen::Matrix<double, 3, 3> KelvinVectorToTensor(const KVec& vec)
 {
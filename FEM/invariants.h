@@ -37,6 +37,19 @@ KVec Voigt_to_Kelvin_Strain(const std::vector<double>& voigt_strain);
 void Kelvin_to_Voigt_Stress(const KVec& kelvin_stress, std::vector<double>& voigt_stress);
 void Kelvin_to_Voigt_Strain(const KVec& kelvin_strain, std::vector<double>& voigt_strain);
 
+// Kelvin/Voigt mapping routines for vectors in contiguous or strided storage,
+// e.g. the Gauss point column of a (components x Gauss points) matrix.
+// n_comp is 4 for 2D and 6 for 3D; the missing 3D components are zero.
+KVec Voigt_to_Kelvin_Stress(const double* voigt_stress, const int n_comp, const int stride = 1);
+KVec Voigt_to_Kelvin_Strain(const double* voigt_strain, const int n_comp, const int stride = 1);
+void Kelvin_to_Voigt_Stress(const KVec& kelvin_stress, double* voigt_stress, const int n_comp,
+                            const int stride = 1);
+void Kelvin_to_Voigt_Strain(const KVec& kelvin_strain, double* voigt_strain, const int n_comp,
+                            const int stride = 1);
+// Maps a tangent dsig/deps in Kelvin notation into a row-major n_comp x n_comp
+// matrix in Voigt notation
+void Kelvin_to_Voigt_Tangent(const KMat& kelvin_tangent, double* voigt_tangent, const int n_comp);
+
 // Maps a 6D Kelvin vector back into 3D Tensor coordinates
 Eigen::Matrix<double, 3, 3> KelvinVectorToTensor(const KVec& vec);
 
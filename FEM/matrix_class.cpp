@@ -18,6 +18,7 @@
    ==========================================================================*/
 
 /// Matrix
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <iomanip>
@@ -684,8 +685,6 @@ SparseTable::SparseTable(CFEMesh* a_mesh, bool quadratic, bool symm, StorageType
 {
 	long i = 0, j = 0, ii = 0, jj = 0;
 	long lbuff0 = 0, lbuff1 = 0;
-	long** larraybuffer;
-	larraybuffer = NULL;
 	//
 	// In sparse table, = number of nodes
 	rows = a_mesh->GetNodesNumber(quadratic);
@@ -703,29 +702,26 @@ SparseTable::SparseTable(CFEMesh* a_mesh, bool quadratic, bool symm, StorageType
 		row_index_mapping_o2n = NULL;
 	}
 
-	if (symmetry)
+	// Columns of each row in equation indices, which may differ from the
+	// node indices if the equations are renumbered.
+	std::vector<std::vector<long> > row_columns(rows);
+	for (i = 0; i < rows; i++)
 	{
-		larraybuffer = new long*[rows];
-		for (i = 0; i < rows; i++)
+		const std::vector<size_t>& connected(
+		    a_mesh->nod_vector[a_mesh->Eqs2Global_NodeIndex[i]]->getConnectedNodes());
+		std::vector<long>& columns(row_columns[i]);
+		columns.reserve(connected.size());
+		for (j = 0; j < (long)connected.size(); j++)
 		{
-			if (storage_type == JDS)
-				row_index_mapping_n2o[i] = i;
-			// 'diag_entry' used as a temporary array
-			// to store the number of nodes connected to this node
-			lbuff1 = (long)a_mesh->nod_vector[i]->getConnectedNodes().size();
-			larraybuffer[i] = new long[lbuff1 + 1];
-			//
-			larraybuffer[i][0] = lbuff1;
-			for (j = 0; j < lbuff1; j++)
-				larraybuffer[i][j + 1] = a_mesh->nod_vector[i]->getConnectedNodes()[j];
-			a_mesh->nod_vector[i]->getConnectedNodes().clear();
-			for (j = 0; j < lbuff1; j++)
-			{
-				jj = larraybuffer[i][j + 1];
-				if (i <= jj)
-					a_mesh->nod_vector[i]->getConnectedNodes().push_back(jj);
-			}
+			jj = a_mesh->nod_vector[connected[j]]->GetEquationIndex();
+			/// If linear element is used
+			if (jj < 0 || jj >= rows)
+				continue;
+			if (symmetry && jj < i)
+				continue;
+			columns.push_back(jj);
 		}
+		std::sort(columns.begin(), columns.end());
 	}
 
 	/// CRS storage
@@ -734,33 +730,22 @@ SparseTable::SparseTable(CFEMesh* a_mesh, bool quadratic, bool symm, StorageType
 		/// num_column_entries saves vector ptr of CRS
 		num_column_entries = new long[rows + 1];
 
-		std::vector<long> A_index;
-		long col_index;
-
 		for (i = 0; i < rows; i++)
 		{
-			num_column_entries[i] = (long)A_index.size();
-
-			for (j = 0; j < (long)a_mesh->nod_vector[i]->getConnectedNodes().size(); j++)
-			{
-				col_index = a_mesh->nod_vector[i]->getConnectedNodes()[j];
-
-				/// If linear element is used
-				if ((!quadratic) && (col_index >= rows))
-					continue;
-
-				if (i == col_index)
-					diag_entry[i] = (long)A_index.size();
-				A_index.push_back(col_index);
-			}
+			num_column_entries[i] = size_entry_column;
+			size_entry_column += (long)row_columns[i].size();
 		}
-
-		size_entry_column = (long)A_index.size();
 		num_column_entries[rows] = size_entry_column;
 
 		entry_column = new long[size_entry_column];
-		for (i = 0; i < size_entry_column; i++)
-			entry_column[i] = A_index[i];
+		for (i = 0; i < rows; i++)
+			for (j = 0; j < (long)row_columns[i].size(); j++)
+			{
+				const long k = num_column_entries[i] + j;
+				entry_column[k] = row_columns[i][j];
+				if (i == entry_column[k])
+					diag_entry[i] = k;
+			}
 	}
 	else if (storage_type == JDS)
 	{
@@ -772,15 +757,7 @@ SparseTable::SparseTable(CFEMesh* a_mesh, bool quadratic, bool symm, StorageType
 			row_index_mapping_n2o[i] = i;
 			// 'diag_entry' used as a temporary array
 			// to store the number of nodes connected to this node
-			diag_entry[i] = (long)a_mesh->nod_vector[i]->getConnectedNodes().size();
-			if (!quadratic)
-			{
-				lbuff0 = 0;
-				for (j = 0; j < diag_entry[i]; j++)
-					if (a_mesh->nod_vector[i]->getConnectedNodes()[j] < static_cast<size_t>(rows))
-						lbuff0++;
-				diag_entry[i] = lbuff0;
-			}
+			diag_entry[i] = (long)row_columns[i].size();
 			size_entry_column += diag_entry[i];
 		}
 
@@ -831,7 +808,7 @@ SparseTable::SparseTable(CFEMesh* a_mesh, bool quadratic, bool symm, StorageType
 				// ii is the real row index of this entry in matrix
 				ii = row_index_mapping_n2o[j];
 				// jj is the real column index of this entry in matrix
-				jj = a_mesh->nod_vector[ii]->getConnectedNodes()[i];
+				jj = row_columns[ii][i];
 				entry_column[lbuff0] = jj;
 
 				// Till to this stage, 'diag_entry' is really used to store indices of the diagonal entries.
@@ -842,26 +819,6 @@ SparseTable::SparseTable(CFEMesh* a_mesh, bool quadratic, bool symm, StorageType
 				lbuff0++;
 			}
 	}
-
-	// For the case of symmetry matrix
-	if (symmetry)
-	{
-		for (i = 0; i < rows; i++)
-		{
-			lbuff0 = larraybuffer[i][0];
-			a_mesh->nod_vector[i]->getConnectedNodes().resize(lbuff0);
-			//
-			for (j = 0; j < lbuff0; j++)
-				a_mesh->nod_vector[i]->getConnectedNodes()[j] = larraybuffer[i][j + 1];
-		}
-		for (i = 0; i < rows; i++)
-		{
-			delete[] larraybuffer[i];
-			larraybuffer[i] = 0;
-		}
-		delete[] larraybuffer;
-		larraybuffer = 0;
-	}
 }
 /*\!
  ********************************************************************
@@ -1107,7 +1064,7 @@ CSparseMatrix::CSparseMatrix(const SparseTable& sparse_table, const int dof) : D
 						// I = ii * rows + i; // row in global matrix
 						// column in global matrix
 						J = jj * rows + entry_column[counter];
-						K = (ii * DOF + jj) * size_entry_column + counter;
+						K = BlockEntryIndex(counter, ii, jj);
 
 						// Store column index for CRS
 						col_idx[counter_col_idx] = J;
@@ -1194,7 +1151,7 @@ double& CSparseMatrix::operator()(const long i, const long j) const
 		if (counter >= size_entry_column)
 			return zero_e;
 		//  Zero entry;
-		k = (ii * DOF + jj) * size_entry_column + counter;
+		k = BlockEntryIndex(counter, ii, jj);
 	}
 	else if (storage_type == CRS)
 	{
@@ -1205,7 +1162,7 @@ double& CSparseMatrix::operator()(const long i, const long j) const
 		if (k == -1)
 			return zero_e;
 
-		k = (ii * DOF + jj) * size_entry_column + k;
+		k = BlockEntryIndex(k, ii, jj);
 	}
 
 	return entry[k]; //
@@ -1218,6 +1175,7 @@ double& CSparseMatrix::operator()(const long i, const long j) const
  ********************************************************************/
 void CSparseMatrix::operator=(const double a)
 {
+	ResetDirichlet();
 	long size = DOF * DOF * size_entry_column;
 	for (long i = 0; i < size; i++)
 		entry[i] = a;
@@ -1254,6 +1212,7 @@ void CSparseMatrix::operator+=(const double a)
  ********************************************************************/
 void CSparseMatrix::operator=(const CSparseMatrix& m)
 {
+	ResetDirichlet();
 	long size = DOF * DOF * size_entry_column;
 #ifdef gDEBUG
 	if (size != m.DOF * m.DOF * m.size_entry_column)
@@ -1306,6 +1265,29 @@ void CSparseMatrix::operator-=(const CSparseMatrix& m)
 	for (long i = 0; i < size; i++)
 		entry[i] -= m.entry[i];
 }
+/*\!
+ ********************************************************************
+   this = a * m1 + b * m2 for matrices of the same sparse table.
+   One pass over the entries, e.g. for M/dt + theta K
+ ********************************************************************/
+void CSparseMatrix::SetLinearCombination(const double a, const CSparseMatrix& m1, const double b,
+                                         const CSparseMatrix& m2)
+{
+	long size = DOF * DOF * size_entry_column;
+#ifdef gDEBUG
+	if (size != m1.DOF * m1.DOF * m1.size_entry_column || size != m2.DOF * m2.DOF * m2.size_entry_column)
+	{
+		std::cout << "\n Dimensions of two matrices do not match"
+		          << "\n";
+		abort();
+	}
+#endif
+	ResetDirichlet();
+	const double* e1 = m1.entry;
+	const double* e2 = m2.entry;
+	for (long i = 0; i < size; i++)
+		entry[i] = a * e1[i] + b * e2[i];
+}
 /*\!
  ********************************************************************
    Output sparse matrix
@@ -1330,7 +1312,7 @@ void CSparseMatrix::Write(std::ostream& os)
 						// TEST
 						// if(fabs(entry[(ii*DOF+jj)*size_entry_column+counter])>DBL_MIN) //DBL_EPSILON)
 						os << std::setw(10) << ii * rows + i << " " << std::setw(10) << jj * rows + entry_column[k]
-						   << " " << std::setw(15) << entry[(ii * DOF + jj) * size_entry_column + k] << "\n";
+						   << " " << std::setw(15) << entry[BlockEntryIndex(k, ii, jj)] << "\n";
 
 	else if (storage_type == JDS)
 	{
@@ -1349,7 +1331,7 @@ void CSparseMatrix::Write(std::ostream& os)
 							// if(fabs(entry[(ii*DOF+jj)*size_entry_column+counter])>DBL_MIN) //DBL_EPSILON)
 							os << std::setw(10) << ii * rows + i << " " << std::setw(10)
 							   << jj * rows + entry_column[counter] << " " << std::setw(15)
-							   << entry[(ii * DOF + jj) * size_entry_column + counter] << "\n";
+							   << entry[BlockEntryIndex(counter, ii, jj)] << "\n";
 							counter += num_column_entries[k];
 						}
 						else
@@ -1399,7 +1381,7 @@ void CSparseMatrix::Write_BIN(std::ostream& os)
 					for (k = num_column_entries[i]; k < num_column_entries[i + 1]; k++)
 					{
 						A_index[counter] = jj * rows + entry_column[k];
-						A_value[counter] = entry[(ii * DOF + jj) * size_entry_column + k];
+						A_value[counter] = entry[BlockEntryIndex(k, ii, jj)];
 						counter++;
 					}
 			}
@@ -1438,7 +1420,31 @@ void CSparseMatrix::multiVec(double* vec_s, double* vec_r)
 		// Although this piece of code can deal with the case
 		// of DOF = 1, we also prepare a special piece of code for
 		// the case of DOF = 1 just for efficiency
-		if (storage_type == CRS)
+		if (storage_type == CRS && !symmetry)
+		{
+			/// Rows are independent: the DOF x DOF block of each entry is
+			/// contiguous in memory and is applied to the DOF values of node jj.
+			const long block_size = DOF * DOF;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+			for (ii = 0; ii < rows; ii++)
+			{
+				for (long jk = num_column_entries[ii]; jk < num_column_entries[ii + 1]; jk++)
+				{
+					const double* block = &entry[jk * block_size];
+					const long jn = entry_column[jk];
+					for (int id = 0; id < DOF; id++)
+					{
+						double val = 0.;
+						for (int jd = 0; jd < DOF; jd++)
+							val += block[id * DOF + jd] * vec_s[jd * rows + jn];
+						vec_r[id * rows + ii] += val;
+					}
+				}
+			}
+		}
+		else if (storage_type == CRS)
 		{
 			/// ptr is num_column_entries
 			for (ii = 0; ii < rows; ii++)
@@ -1451,7 +1457,7 @@ void CSparseMatrix::multiVec(double* vec_s, double* vec_r)
 						for (jdof = 0; jdof < DOF; jdof++)
 						{
 							ll = jdof * rows + jj;
-							k = (idof * DOF + jdof) * size_entry_column + j;
+							k = BlockEntryIndex(j, idof, jdof);
 							vec_r[kk] += entry[k] * vec_s[ll];
 							if (symmetry & (kk != ll))
 								vec_r[ll] += entry[k] * vec_s[kk];
@@ -1472,7 +1478,7 @@ void CSparseMatrix::multiVec(double* vec_s, double* vec_r)
 						for (jdof = 0; jdof < DOF; jdof++)
 						{
 							ll = jdof * rows + jj;
-							j = (idof * DOF + jdof) * size_entry_column + counter;
+							j = BlockEntryIndex(counter, idof, jdof);
 							vec_r[kk] += entry[j] * vec_s[ll];
 							if (symmetry & (kk != ll))
 								vec_r[ll] += entry[j] * vec_s[kk];
@@ -1484,7 +1490,20 @@ void CSparseMatrix::multiVec(double* vec_s, double* vec_r)
 	}
 	else // DOF = 1
 	{
-		if (storage_type == CRS)
+		if (storage_type == CRS && !symmetry)
+		{
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+			for (ii = 0; ii < rows; ii++)
+			{
+				double val = 0.;
+				for (long jk = num_column_entries[ii]; jk < num_column_entries[ii + 1]; jk++)
+					val += entry[jk] * vec_s[entry_column[jk]];
+				vec_r[ii] = val;
+			}
+		}
+		else if (storage_type == CRS)
 		{
 			/// ptr is num_column_entries
 			for (ii = 0; ii < rows; ii++)
@@ -1532,7 +1551,23 @@ void CSparseMatrix::Trans_MultiVec(double* vec_s, double* vec_r)
 		// Although this piece of code can deal with the case
 		// of DOF = 1, we also prepare a special piece of code for
 		// the case of DOF = 1 just for efficiency
-		if (storage_type == CRS)
+		if (storage_type == CRS && !symmetry)
+		{
+			const long block_size = DOF * DOF;
+			for (ii = 0; ii < rows; ii++)
+				for (j = num_column_entries[ii]; j < num_column_entries[ii + 1]; j++)
+				{
+					const double* block = &entry[j * block_size];
+					jj = entry_column[j];
+					for (idof = 0; idof < DOF; idof++)
+					{
+						const double val = vec_s[idof * rows + ii];
+						for (jdof = 0; jdof < DOF; jdof++)
+							vec_r[jdof * rows + jj] += block[idof * DOF + jdof] * val;
+					}
+				}
+		}
+		else if (storage_type == CRS)
 		{
 			/// ptr is num_column_entries
 			for (ii = 0; ii < rows; ii++)
@@ -1545,7 +1580,7 @@ void CSparseMatrix::Trans_MultiVec(double* vec_s, double* vec_r)
 						for (jdof = 0; jdof < DOF; jdof++)
 						{
 							ll = jdof * rows + jj;
-							k = (idof * DOF + jdof) * size_entry_column + j;
+							k = BlockEntryIndex(j, idof, jdof);
 							vec_r[ll] += entry[k] * vec_s[kk];
 							if (symmetry & (kk != ll))
 								vec_r[kk] += entry[k] * vec_s[ll];
@@ -1566,7 +1601,7 @@ void CSparseMatrix::Trans_MultiVec(double* vec_s, double* vec_r)
 						for (jdof = 0; jdof < DOF; jdof++)
 						{
 							ll = jdof * rows + jj;
-							j = (idof * DOF + jdof) * size_entry_column + counter;
+							j = BlockEntryIndex(counter, idof, jdof);
 							vec_r[ll] += entry[j] * vec_s[kk];
 							if (symmetry & (kk != ll))
 								vec_r[kk] += entry[j] * vec_s[ll];
@@ -1612,6 +1647,9 @@ void CSparseMatrix::Trans_MultiVec(double* vec_s, double* vec_r)
         A(ii, j) = 0., j!=ii
         A(i, ii) = 0., i!=ii
         b_i -= A(i,k)b_k  // b_k is given
+   The column is eliminated through the transpose of the sparse table,
+   so that a symmetric matrix stays symmetric (CG, Cholesky). The cost
+   is proportional to the entries of the row and of the column.
    Programm:
    10/2007 WW
    03/2011 WW  CRS storage
@@ -1630,43 +1668,21 @@ void CSparseMatrix::Diagonize(const long idiag, const double b_given, double* b)
 		const long row_end = num_column_entries[id + 1];
 		/// Diagonal entry and the row where the diagonal entry exists
 		j = diag_entry[id];
-		vdiag = entry[(ii * DOF + ii) * size_entry_column + j];
+		vdiag = entry[BlockEntryIndex(j, ii, ii)];
 		/// Row where the diagonal entry exists
 		for (jj = 0; jj < DOF; jj++)
 		{
-			const long ij = (ii * DOF + jj) * size_entry_column;
 			for (k = num_column_entries[id]; k < row_end; k++)
 			{
 				j0 = entry_column[k];
 				if (id == j0 && jj == ii) // Diagonal entry
 					continue;
-				entry[ij + k] = 0.;
+				entry[BlockEntryIndex(k, ii, jj)] = 0.;
 			}
 		}
-#ifdef colDEBUG
-		/// Clean column id
-		for (i = 0; i < rows; i++)
-		{
-			j = binarySearch(entry_column, id, num_column_entries[i], num_column_entries[i + 1]);
-			if (j == -1)
-				continue;
-			j0 = entry_column[j];
-
-			for (jj = 0; jj < DOF; jj++)
-			{
-				if (i == j0 && ii == jj)
-					continue;
-				k = (jj * DOF + ii) * size_entry_column + j;
-				b[jj * rows + i] -= entry[k] * b_given;
-				entry[k] = 0.;
-				// Room for symmetry case
-			}
-		}
-#endif
 	}
 	else if (storage_type == JDS)
 	{
-		const long kk = ii * DOF;
 		long row_in_parse_table, counter;
 
 		// Row is zero
@@ -1681,11 +1697,11 @@ void CSparseMatrix::Diagonize(const long idiag, const double b_given, double* b)
 				{
 					if (id == j0 && jj == ii)
 					{
-						vdiag = entry[(kk + jj) * size_entry_column + counter];
+						vdiag = entry[BlockEntryIndex(counter, ii, jj)];
 					}
 					else
 					{
-						entry[(kk + jj) * size_entry_column + counter] = 0.;
+						entry[BlockEntryIndex(counter, ii, jj)] = 0.;
 					}
 				}
 				counter += num_column_entries[k];
@@ -1693,37 +1709,121 @@ void CSparseMatrix::Diagonize(const long idiag, const double b_given, double* b)
 			else
 				break;
 		}
-#ifdef colDEBUG
-		//
-		counter = 0;
-		for (k = 0; k < max_columns; k++)
-			for (i = 0; i < num_column_entries[k]; i++)
+	}
+	// The row and the column are the same entries for symmetric storage
+	if (!symmetry)
+		EliminateColumn(idiag, b_given, b);
+	b[idiag] = vdiag * b_given;
+}
+
+/*\!
+ ********************************************************************
+   Transpose of the sparse table for the column elimination
+ ********************************************************************/
+void CSparseMatrix::BuildColumnMap()
+{
+	std::vector<long> entry_row(size_entry_column);
+	if (storage_type == JDS)
+	{
+		long counter = 0;
+		for (long k = 0; k < max_columns; k++)
+			for (long i = 0; i < num_column_entries[k]; i++)
+				entry_row[counter++] = row_index_mapping_n2o[i];
+	}
+	else
+	{
+		for (long i = 0; i < rows; i++)
+			for (long k = num_column_entries[i]; k < num_column_entries[i + 1]; k++)
+				entry_row[k] = i;
+	}
+
+	col_ptr_t.assign(rows + 1, 0);
+	for (long k = 0; k < size_entry_column; k++)
+		col_ptr_t[entry_column[k] + 1]++;
+	for (long i = 0; i < rows; i++)
+		col_ptr_t[i + 1] += col_ptr_t[i];
+	col_row_t.resize(size_entry_column);
+	col_entry_t.resize(size_entry_column);
+	std::vector<long> fill(col_ptr_t.begin(), col_ptr_t.end() - 1);
+	for (long k = 0; k < size_entry_column; k++)
+	{
+		const long l = fill[entry_column[k]]++;
+		col_row_t[l] = entry_row[k];
+		col_entry_t[l] = k;
+	}
+}
+
+/*\!
+ ********************************************************************
+   Set A(i, idiag) = 0, i != idiag, and b_i -= A(i, idiag) * b_given.
+   Rows of unknowns which are already eliminated are skipped, their RHS
+   is set by their own Diagonize call.
+ ********************************************************************/
+void CSparseMatrix::EliminateColumn(const long idiag, const double b_given, double* b)
+{
+	if (col_ptr_t.empty())
+		BuildColumnMap();
+	if (static_cast<long>(dirichlet_slot.size()) != rows * DOF) // DOF changed by SetDOF
+	{
+		ResetDirichlet();
+		dirichlet_slot.assign(rows * DOF, -1);
+	}
+	const long id = idiag % rows;
+	const long ii = idiag / rows;
+
+	long slot = dirichlet_slot[idiag];
+	const bool first = (slot < 0);
+	double factor = b_given;
+	if (first)
+	{
+		slot = static_cast<long>(dirichlet_dofs.size());
+		dirichlet_slot[idiag] = slot;
+		dirichlet_dofs.push_back(idiag);
+		dirichlet_given.push_back(b_given);
+		dirichlet_offset.push_back(static_cast<long>(dirichlet_column.size()));
+	}
+	else
+	{
+		// Another value for the same unknown, e.g. a node shared by two
+		// BCs: the last value is applied
+		factor = b_given - dirichlet_given[slot];
+		dirichlet_given[slot] = b_given;
+	}
+
+	long backup = dirichlet_offset[slot];
+	for (long l = col_ptr_t[id]; l < col_ptr_t[id + 1]; l++)
+	{
+		const long i = col_row_t[l];
+		for (long idof = 0; idof < DOF; idof++)
+		{
+			if (i == id && idof == ii) // Diagonal entry
+				continue;
+			const long k = BlockEntryIndex(col_entry_t[l], idof, ii);
+			if (first)
 			{
-				i0 = row_index_mapping_n2o[i];
-				/*
-				   if(i0 == id)
-				   {
-				   counter++;
-				   continue;
-				   }
-				 */
-				j0 = entry_column[counter];
-				if (j0 == id)
-					for (jj = 0; jj < DOF; jj++)
-					{
-						if (i0 == j0 && ii == jj)
-							continue;
-						j = (jj * DOF + ii) * size_entry_column + counter;
-						b[jj * rows + i0] -= entry[j] * b_given;
-						entry[j] = 0.;
-						// Room for symmetry case
-					}
-				//
-				counter++;
+				dirichlet_column.push_back(entry[k]);
+				entry[k] = 0.;
 			}
-#endif
+			const long row = idof * rows + i;
+			if (dirichlet_slot[row] < 0)
+				b[row] -= dirichlet_column[backup] * factor;
+			backup++;
+		}
 	}
-	b[idiag] = vdiag * b_given;
+}
+
+/*\!
+ ********************************************************************
+   Forget the eliminated unknowns, called when all entries are reset
+ ********************************************************************/
+void CSparseMatrix::ResetDirichlet()
+{
+	for (size_t i = 0; i < dirichlet_dofs.size(); i++)
+		dirichlet_slot[dirichlet_dofs[i]] = -1;
+	dirichlet_dofs.clear();
+	dirichlet_given.clear();
+	dirichlet_offset.clear();
+	dirichlet_column.clear();
 }
 
 /*\!
@@ -1749,7 +1849,7 @@ void CSparseMatrix::Precond_Jacobi(double* vec_s, double* vec_r)
 		for (i = 0; i < rows; i++)
 			for (idof = 0; idof < DOF; idof++)
 			{
-				diag = entry[(idof * DOF + idof) * size_entry_column + diag_entry[i]];
+				diag = entry[BlockEntryIndex(diag_entry[i], idof, idof)];
 				if (fabs(diag) < DBL_MIN)
 					//        if(fabs(diag)<DBL_EPSILON)
 					diag = 1.0;
@@ -1788,7 +1888,7 @@ void CSparseMatrix::DiagonalEntries(double* diag_e)
 		// the case of DOF = 1 just for efficiency
 		for (i = 0; i < rows; i++)
 			for (idof = 0; idof < DOF; idof++)
-				diag_e[idof * rows + i] = entry[(idof * DOF + idof) * size_entry_column + diag_entry[i]];
+				diag_e[idof * rows + i] = entry[BlockEntryIndex(diag_entry[i], idof, idof)];
 	//
 	else // DOF = 1
 
@@ -1797,6 +1897,73 @@ void CSparseMatrix::DiagonalEntries(double* diag_e)
 }
 #endif // USE_MPI
 
+/********************************************************************
+   Compressed column storage (CCS) of the matrix with all DOF
+   components, i.e. of size Dim() x Dim(). Row indices are sorted
+   within each column. entry_idx[k] is the position of the k-th
+   nonzero in the entry array, so that the values can be gathered
+   by GetCCSValues without searching the sparse table again.
+********************************************************************/
+void CSparseMatrix::GetCCSPattern(std::vector<int>& col_ptr,
+                                  std::vector<int>& row_idx,
+                                  std::vector<long>& entry_idx) const
+{
+	const long dim = rows * DOF;
+	// Nonzeros as (column, (row, entry position))
+	std::vector<std::pair<long, std::pair<long, long> > > nonzeros;
+	nonzeros.reserve(DOF * DOF * size_entry_column * (symmetry ? 2 : 1));
+	long counter = 0;
+	for (long k = 0; k < (storage_type == JDS ? max_columns : 1); k++)
+	{
+		const long n_sparse_rows = (storage_type == JDS) ? num_column_entries[k] : rows;
+		for (long i = 0; i < n_sparse_rows; i++)
+		{
+			const long ii = (storage_type == JDS) ? row_index_mapping_n2o[i] : i;
+			const long j_end = (storage_type == JDS) ? counter + 1 : num_column_entries[i + 1];
+			for (; counter < j_end; counter++)
+			{
+				const long jj = entry_column[counter];
+				for (long idof = 0; idof < DOF; idof++)
+					for (long jdof = 0; jdof < DOF; jdof++)
+					{
+						const long kk = idof * rows + ii;
+						const long ll = jdof * rows + jj;
+						const long pos = BlockEntryIndex(counter, idof, jdof);
+						nonzeros.push_back(std::make_pair(ll, std::make_pair(kk, pos)));
+						if (symmetry && kk != ll)
+							nonzeros.push_back(std::make_pair(kk, std::make_pair(ll, pos)));
+					}
+			}
+		}
+	}
+	std::sort(nonzeros.begin(), nonzeros.end());
+
+	col_ptr.assign(dim + 1, 0);
+	row_idx.resize(nonzeros.size());
+	entry_idx.resize(nonzeros.size());
+	for (size_t k = 0; k < nonzeros.size(); k++)
+	{
+		col_ptr[nonzeros[k].first + 1]++;
+		row_idx[k] = static_cast<int>(nonzeros[k].second.first);
+		entry_idx[k] = nonzeros[k].second.second;
+	}
+	for (long i = 0; i < dim; i++)
+		col_ptr[i + 1] += col_ptr[i];
+}
+
+/********************************************************************
+   Gather the matrix values in the order given by GetCCSPattern
+********************************************************************/
+void CSparseMatrix::GetCCSValues(const std::vector<long>& entry_idx, double* value) const
+{
+	const long n = (long)entry_idx.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (long k = 0; k < n; k++)
+		value[k] = entry[entry_idx[k]];
+}
+
 #if defined(LIS) || defined(MKL)
 /********************************************************************
    Get sparse matrix values in compressed row storage
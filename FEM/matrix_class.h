@@ -555,6 +555,7 @@ public:
 	void operator=(const CSparseMatrix& m);
 	void operator+=(const CSparseMatrix& m);
 	void operator-=(const CSparseMatrix& m);
+	void SetLinearCombination(const double a, const CSparseMatrix& m1, const double b, const CSparseMatrix& m2);
 	// Vector pass through augment and bring results back.
 	void multiVec(double* vec_s, double* vec_r);
 	void Trans_MultiVec(double* vec_s, double* vec_r);
@@ -571,6 +572,9 @@ public:
 		DOF = dof_n;
 	}
 	long Size() const { return rows; }
+	// Compressed column storage of all DOF components, for the sparse direct solver
+	void GetCCSPattern(std::vector<int>& col_ptr, std::vector<int>& row_idx, std::vector<long>& entry_idx) const;
+	void GetCCSValues(const std::vector<long>& entry_idx, double* value) const;
 #if defined(LIS) || defined(MKL) // These two pointers are in need for Compressed Row Storage
 	int nnz() const // PCH
 	{
@@ -590,6 +594,8 @@ public:
 #endif
 private:
 	// Data
+	/// Values of the sparse entries. For DOF > 1 each entry of the sparse table
+	/// holds a dense DOF x DOF block stored row-wise (block CRS).
 	double* entry;
 	mutable double zero_e;
 	/// 0. 03.2011. WW
@@ -608,6 +614,27 @@ private:
 	long rows;
 	//
 	int DOF;
+	/// Position of component (idof, jdof) of the k-th block in entry
+	long BlockEntryIndex(const long k, const long idof, const long jdof) const { return (k * DOF + idof) * DOF + jdof; }
+
+	// Transpose of the sparse table, built by the first Diagonize call: the
+	// blocks of column j are col_entry_t[col_ptr_t[j]...col_ptr_t[j+1]-1],
+	// located in the rows col_row_t[...]
+	std::vector<long> col_ptr_t;
+	std::vector<long> col_row_t;
+	std::vector<long> col_entry_t;
+	// Unknowns eliminated by Diagonize since the last reset of the entries.
+	// dirichlet_slot[i] is the slot of unknown i or -1. For each slot the
+	// given value and the removed column entries are kept, so that a second
+	// value for the same unknown corrects the RHS instead of being lost.
+	std::vector<long> dirichlet_slot;
+	std::vector<long> dirichlet_dofs;
+	std::vector<double> dirichlet_given;
+	std::vector<long> dirichlet_offset;
+	std::vector<double> dirichlet_column;
+	void BuildColumnMap();
+	void EliminateColumn(const long idiag, const double b_given, double* b);
+	void ResetDirichlet();
 };
 // Since the pointer to member funtions gives lower performance
 #endif
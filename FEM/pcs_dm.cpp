@@ -86,8 +86,11 @@ namespace process
 {
 CRFProcessDeformation::CRFProcessDeformation()
     : CRFProcess(), fem_dm(NULL), ARRAY(NULL), counter(0), InitialNorm(0.0), idata_type(none),
-      _has_initial_stress_data(false), error_k0(1.0e10)
-
+      _has_initial_stress_data(false), error_k0(1.0e10), _stiffness_reused(false)
+#if defined(NEW_EQS) && !defined(USE_MPI)
+      ,
+      _stiffness_buffer(NULL)
+#endif
 {
 }
 
@@ -108,6 +111,11 @@ CRFProcessDeformation::~CRFProcessDeformation()
 		delete[] ARRAY;
 	if (fem_dm)
 		delete fem_dm;
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	if (_stiffness_buffer)
+		delete _stiffness_buffer;
+	_stiffness_buffer = NULL;
+#endif
 
 	fem_dm = NULL;
 	ARRAY = NULL;
@@ -166,10 +174,14 @@ void CRFProcessDeformation::Initialization()
 		Axisymm = -1; // Axisymmetry is true
 	fem_dm = new CFiniteElementVec(this, Axisymm * m_msh->GetCoordinateFlag());
 	fem_dm->SetGaussPointNumber(m_num->ele_gauss_points);
+	fem_dm->setGeometryCache(m_msh->ele_vector.size(), m_num->ele_geometry_cache, m_num->ele_geometry_cache_max_mb);
 	//
 	// Monolithic scheme
 	if (type / 10 == 4)
+	{
 		fem = new CFiniteElementStd(this, Axisymm * m_msh->GetCoordinateFlag());
+		fem->setGeometryCache(m_msh->ele_vector.size(), m_num->ele_geometry_cache, m_num->ele_geometry_cache_max_mb);
+	}
 	//
 	pcs_number_deformation = pcs_number;
 	//
@@ -1351,6 +1363,36 @@ void CRFProcessDeformation::ResetTimeStep()
 		}
 }
 
+/*************************************************************************
+   Task: Save node values and Gauss point state at the beginning of a
+         time step. The buffer keeps its capacity over the time steps.
+   Programming:
+ **************************************************************************/
+void CRFProcessDeformation::SaveTimeStepState()
+{
+	CRFProcess::SaveTimeStepState();
+	_saved_gp_state.clear();
+	for (size_t e = 0; e < ele_value_dm.size(); e++)
+		if (ele_value_dm[e])
+			ele_value_dm[e]->SaveState(_saved_gp_state);
+}
+
+/*************************************************************************
+   Task: Roll back a rejected time step
+   Programming:
+ **************************************************************************/
+void CRFProcessDeformation::RestoreTimeStepState()
+{
+	if (_saved_gp_state.empty()) // No snapshot of this step
+		return;
+	CRFProcess::RestoreTimeStepState();
+	std::size_t offset = 0;
+	for (size_t e = 0; e < ele_value_dm.size(); e++)
+		if (ele_value_dm[e])
+			offset = ele_value_dm[e]->RestoreState(_saved_gp_state, offset);
+	_saved_gp_state.clear();
+}
+
 /*************************************************************************
    ROCKFLOW - Funktion: TransferNodeValuesToVectorLinearSolver
 
@@ -2648,7 +2690,29 @@ void CRFProcessDeformation::GlobalAssembly()
 	else
 #endif //#if !defined(USE_PETSC) // && !defined(other parallel libs)//10.3012. WW
 	{
+		_stiffness_reused = false;
+#if defined(NEW_EQS) && !defined(USE_MPI)
+		// Reuse the stiffness matrix if the operator has not been changed.
+		// Only the RHS is then assembled by the element loop.
+		const bool keep_stiffness = isStiffnessConstant();
+		if (keep_stiffness && _stiffness_buffer)
+		{
+			if (m_num->stiffness_reuse == 1 || ite_steps > 1)
+			{
+				(*eqs_new->A) = (*_stiffness_buffer);
+				_stiffness_reused = true;
+			}
+		}
+#endif
 		GlobalAssembly_DM();
+#if defined(NEW_EQS) && !defined(USE_MPI)
+		if (keep_stiffness && !_stiffness_reused)
+		{
+			if (!_stiffness_buffer)
+				_stiffness_buffer = new Math_Group::CSparseMatrix(*m_msh->GetSparseTable(true), eqs_new->A->Dof());
+			(*_stiffness_buffer) = (*eqs_new->A);
+		}
+#endif
 
 		if (type / 10 == 4) // p-u monolithic scheme
 
@@ -2742,6 +2806,37 @@ void CRFProcessDeformation::GlobalAssembly_DM()
 	}
 }
 
+/*!  \brief Check if the global stiffness matrix can be kept from the
+      last assembly, i.e. no excavation, no element deactivation and
+      material parameters which depend neither on time nor on the
+      deformation state. For the modified Newton option
+      (stiffness_reuse == 2) the material nonlinearity is allowed,
+      since the matrix is only kept within the Newton steps of one call.
+ */
+bool CRFProcessDeformation::isStiffnessConstant() const
+{
+	if (m_num->stiffness_reuse < 1 || m_num->stiffness_reuse > 2)
+		return false;
+	if (fem_dm->dynamic || type / 10 == 4 || m_num->nls_method == 2 || enhanced_strain_dm > 0)
+		return false;
+	if (hasAnyProcessDeactivatedSubdomains || NumDeactivated_SubDomains > 0 || ExcavMaterialGroup > -1
+	    || num_type_name.find("EXCAVATION") != string::npos || Write_Matrix)
+		return false;
+
+	for (std::size_t i = 0; i < msp_vector.size(); i++)
+	{
+		const CSolidProperties* smat = msp_vector[i];
+		if (smat->excavation > 0)
+			return false;
+		if (m_num->stiffness_reuse == 2)
+			continue;
+		if (smat->Youngs_mode == 2 || smat->E_Function_Model > 0 || smat->Time_Dependent_E_nv_mode > 0
+		    || smat->Plasticity_type > 0 || smat->Creep_mode > 0)
+			return false;
+	}
+	return true;
+}
+
 /**************************************************************************
    FEMLib-Method:
 Task: post process for excavation
@@ -37,6 +37,12 @@ namespace FiniteElement
 class CFiniteElementVec;
 }
 using FiniteElement::CFiniteElementVec;
+#if defined(NEW_EQS) && !defined(USE_MPI)
+namespace Math_Group
+{
+class CSparseMatrix;
+}
+#endif
 #if !defined(USE_PETSC) // && !defined(other parallel libs)//03.3012. WW
 class CPARDomain;
 #endif
@@ -101,6 +107,9 @@ public:
 	// For partitioned HM coupled scheme
 	void ResetCouplingStep();
 	void ResetTimeStep();
+	// Snapshot and rollback of a time step including the Gauss point state
+	virtual void SaveTimeStepState();
+	virtual void RestoreTimeStepState();
 	//
 	void UpdateStress();
 	void UpdateInitialStress(bool ZeroInitialS);
@@ -122,6 +131,9 @@ public:
 
 	// Access members
 	CFiniteElementVec* GetFEMAssembler() { return fem_dm; }
+	/// True if the global stiffness matrix is restored from the buffer
+	/// and only the RHS has to be assembled
+	bool isStiffnessReused() const { return _stiffness_reused; }
 
 	// WX:07.2011
 	void PostExcavation();
@@ -144,6 +156,18 @@ private:
 
 	//
 	double error_k0;
+
+	/// Gauss point state of all elements at the beginning of the time step
+	std::vector<double> _saved_gp_state;
+
+	// Reuse of the assembled stiffness matrix
+	bool _stiffness_reused;
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	/// Stiffness matrix before the Dirichlet BCs are applied
+	Math_Group::CSparseMatrix* _stiffness_buffer;
+#endif
+	bool isStiffnessConstant() const;
+
 #if !defined(USE_PETSC) // && !defined(other parallel libs)//03.3012. WW
 	// Domain decompisition
 	void DomainAssembly(CPARDomain* m_dom);
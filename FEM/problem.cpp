@@ -446,6 +446,8 @@ Problem::Problem (char* filename) :
 	// Controls for coupling. WW
 	cpl_overall_max_iterations = 1;
 	cpl_overall_min_iterations = 1; // JT2012
+	cpl_overall_acceleration = FiniteElement::FixedPointAccelerator::NONE;
+	cpl_overall_acceleration_depth = 1;
 	//========================================================================
 	// WW
 	char line[MAX_ZEILE];
@@ -471,6 +473,14 @@ Problem::Problem (char* filename) :
 				// JT: coupling_tolerance is process dependent, cannot be here. See m_num->cpl_tolerance (with
 				// $COUPLING_CONTROL)
 				in_num >> cpl_overall_min_iterations >> cpl_overall_max_iterations;
+				// NONE, AITKEN or ANDERSON depth
+				if (!FiniteElement::FixedPointAccelerator::readType(in_num, cpl_overall_acceleration,
+				                                                    cpl_overall_acceleration_depth))
+				{
+					ScreenMessage("ERROR in NUMRead. Invalid acceleration in $OVERALL_COUPLING, use NONE, AITKEN or "
+					              "ANDERSON depth.\n");
+					exit(1);
+				}
 				break;
 			}
 		}
@@ -1109,11 +1119,30 @@ void Problem::SetTimeActiveProcesses()
 	}
 }
 
+namespace
+{
+/// Add the process, for mass transport all transport components
+void addProcessWithComponents(CRFProcess* m_pcs, std::vector<CRFProcess*>& pcs_list)
+{
+	if (m_pcs->getProcessType() == FiniteElement::MASS_TRANSPORT)
+	{
+		for (size_t i = 0; i < pcs_vector.size(); i++)
+			if (pcs_vector[i]->getProcessType() == FiniteElement::MASS_TRANSPORT)
+				pcs_list.push_back(pcs_vector[i]);
+	}
+	else
+		pcs_list.push_back(m_pcs);
+}
+}
+
 /**************************************************************************
    FEMLib-Method:
    07/2008 WW Implementation
    01/2009 WW Update
    03/2012 JT Many changes. Allow independent time stepping.
+   The state of the active processes is saved before the coupling loop.
+   A rejected step is rolled back to it, including the element values and
+   the Gauss point state of deformation processes.
 **************************************************************************/
 void Problem::Euler_TimeDiscretize()
 {
@@ -1125,6 +1154,7 @@ void Problem::Euler_TimeDiscretize()
 	last_dt_accepted = false; // JT: false first. Thus copy node values after first dt.
 	//
 	CTimeDiscretization* m_tim = NULL;
+	std::vector<CRFProcess*> step_pcs; // Processes of the current step, saved for a rollback
 	aktueller_zeitschritt = 0;
 	ScreenMessage("\n\n***Start time steps\n");
 //
@@ -1203,6 +1233,13 @@ void Problem::Euler_TimeDiscretize()
     || defined(USE_MPI_GEMS)
 		}
 #endif
+		step_pcs.clear();
+		for (i = 0; i < (int)active_process_index.size(); i++)
+			if (total_processes[active_process_index[i]]->Tim->time_active)
+				addProcessWithComponents(total_processes[active_process_index[i]], step_pcs);
+		for (size_t j = 0; j < step_pcs.size(); j++)
+			step_pcs[j]->SaveTimeStepState();
+		//
 		if (CouplingLoop())
 		{
 			// ---------------------------------
@@ -1269,14 +1306,10 @@ void Problem::Euler_TimeDiscretize()
 				m_tim->step_current--;
 				m_tim->repeat = true;
 				m_tim->last_rejected_timestep = aktueller_zeitschritt + 1;
-				//
-				// Copy nodal values in reverse
-				if (isDeformationProcess(total_processes[active_process_index[i]]->getProcessType()))
-					continue;
-				total_processes[active_process_index[i]]->CopyTimestepNODValues(false);
-				// JT: This wasn't done before. Is it needed? //
-				// total_processes[active_process_index[i]]->CopyTimestepELEValues(false);
 			}
+			// Back to the node, element and Gauss point values of the beginning of the step
+			for (size_t j = 0; j < step_pcs.size(); j++)
+				step_pcs[j]->RestoreTimeStepState();
 			for (i = 0; i < (int)total_processes.size(); i++)
 			{
 				if (!active_processes[i] && total_processes[i] && total_processes[i]->tim_type == TimType::STEADY)
@@ -1337,6 +1370,33 @@ void Problem::Euler_TimeDiscretize()
 #endif
 }
 
+namespace
+{
+/// Add the processes whose primary variables are accelerated when m_pcs takes part in a coupling
+/// loop. A MASS_TRANSPORT process stands for all components. Deformation is left out because its
+/// Gauss point stresses are updated incrementally and would not match accelerated displacements.
+void addAcceleratedProcesses(CRFProcess* m_pcs, std::vector<CRFProcess*>& pcs_list)
+{
+	if (isDeformationProcess(m_pcs->getProcessType()))
+		return;
+	addProcessWithComponents(m_pcs, pcs_list);
+}
+
+void getCouplingValues(std::vector<CRFProcess*> const& pcs_list, std::vector<double>& values)
+{
+	values.clear();
+	for (size_t i = 0; i < pcs_list.size(); i++)
+		pcs_list[i]->GetPrimaryNODValues(values);
+}
+
+void setCouplingValues(std::vector<CRFProcess*> const& pcs_list, std::vector<double> const& values)
+{
+	std::size_t offset = 0;
+	for (size_t i = 0; i < pcs_list.size(); i++)
+		offset = pcs_list[i]->SetPrimaryNODValues(values, offset);
+}
+}
+
 /*-----------------------------------------------------------------------
    GeoSys - Function: Coupling loop
    Task:
@@ -1346,6 +1406,10 @@ void Problem::Euler_TimeDiscretize()
    Modification:
    12.2008 WW Update
    03.2012 JT All new. Different strategy, generalized tolerance criteria
+   Optionally, the inner and the overall coupling iterations are accelerated
+   by Anderson mixing or Aitken relaxation of the primary variables
+   ($COUPLING_ACCELERATION, $OVERALL_COUPLING). The convergence criteria
+   are the same.
    -------------------------------------------------------------------------*/
 bool Problem::CouplingLoop()
 {
@@ -1420,6 +1484,12 @@ bool Problem::CouplingLoop()
 	//
 	bool accept = true;
 	max_outer_error = 0.0;
+	FiniteElement::FixedPointAccelerator outer_accelerator(cpl_overall_acceleration, cpl_overall_acceleration_depth,
+	                                                       1.0);
+	const bool accelerate_outer
+	    = (cpl_overall_acceleration != FiniteElement::FixedPointAccelerator::NONE && cpl_overall_max_iterations > 1);
+	std::vector<CRFProcess*> outer_pcs;
+	std::vector<double> cpl_x, cpl_g;
 	for (outer_index = 0; outer_index < cpl_overall_max_iterations; outer_index++)
 	{
 		// JT: All active processes must run on the overall loop. Strange this wasn't the case before.
@@ -1435,6 +1505,17 @@ bool Problem::CouplingLoop()
 			if (!m_tim->time_active)
 				run_flag[index] = false;
 		}
+		if (accelerate_outer)
+		{
+			outer_pcs.clear();
+			for (i = 0; i < num_processes; i++)
+			{
+				index = active_process_index[i];
+				if (run_flag[index])
+					addAcceleratedProcesses(total_processes[index], outer_pcs);
+			}
+			getCouplingValues(outer_pcs, cpl_x);
+		}
 
 		max_outer_error = 0.0; // NW reset error for each iteration
 		for (i = 0; i < num_processes; i++)
@@ -1458,10 +1539,21 @@ bool Problem::CouplingLoop()
 				b_pcs->iter_outer_cpl = outer_index;
 				//
 				max_inner_error = 0.0;
+				FiniteElement::FixedPointAccelerator inner_accelerator(a_pcs->m_num->cpl_acceleration,
+				                                                       a_pcs->m_num->cpl_acceleration_depth, 1.0);
+				std::vector<CRFProcess*> inner_pcs;
+				std::vector<double> inner_x, inner_g;
+				if (inner_accelerator.getType() != FiniteElement::FixedPointAccelerator::NONE)
+				{
+					addAcceleratedProcesses(a_pcs, inner_pcs);
+					addAcceleratedProcesses(b_pcs, inner_pcs);
+				}
 				for (inner_index = 0; inner_index < a_pcs->m_num->cpl_max_iterations; inner_index++)
 				{
 					a_pcs->iter_inner_cpl = inner_index;
 					b_pcs->iter_inner_cpl = inner_index;
+					if (!inner_pcs.empty())
+						getCouplingValues(inner_pcs, inner_x);
 					//
 					// FIRST PROCESS
 					loop_process_number = i;
@@ -1509,6 +1601,14 @@ bool Problem::CouplingLoop()
 					    && inner_index + 2
 					           > a_pcs->m_num->cpl_min_iterations) // JT: error is relative to the tolerance.
 						break;
+					//
+					// Not converged: the next coupling iteration starts from the accelerated values
+					if (!inner_pcs.empty() && inner_index + 1 < a_pcs->m_num->cpl_max_iterations)
+					{
+						getCouplingValues(inner_pcs, inner_g);
+						inner_accelerator.update(inner_x, inner_g);
+						setCouplingValues(inner_pcs, inner_g);
+					}
 				}
 				run_flag[cpl_index] = false; // JT: CRUCIAL!!
 			}
@@ -1601,6 +1701,17 @@ if(has_constrained_bc > 0)
 		if (max_outer_error <= 1.0
 		    && outer_index + 1 >= cpl_overall_min_iterations) // JT: error is relative to the tolerance.
 			break;
+		//
+		// Not converged: the next overall iteration starts from the accelerated values
+		if (accelerate_outer && outer_index + 1 < cpl_overall_max_iterations)
+		{
+			getCouplingValues(outer_pcs, cpl_g);
+			if (cpl_g.size() == cpl_x.size())
+			{
+				outer_accelerator.update(cpl_x, cpl_g);
+				setCouplingValues(outer_pcs, cpl_g);
+			}
+		}
 
 		// MW
 		if (max_outer_error > 1 && outer_index + 1 == cpl_overall_max_iterations
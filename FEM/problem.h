@@ -20,6 +20,8 @@ class CRFProcess;
 // GEOLIB
 #include "GEOObjects.h"
 
+#include "FixedPointAccelerator.h"
+
 namespace FiniteElement
 {
 class ShapeFunctionPool;
@@ -105,6 +107,9 @@ private:
 	bool external_coupling_exists;
 	int cpl_overall_max_iterations;
 	int cpl_overall_min_iterations;
+	/// Acceleration of the overall coupling loop: optional entry after the iteration numbers of $OVERALL_COUPLING
+	FiniteElement::FixedPointAccelerator::Type cpl_overall_acceleration;
+	std::size_t cpl_overall_acceleration_depth;
 	int loop_process_number;
 	size_t max_time_steps;
 	//
@@ -27,6 +27,7 @@
 #include "memory.h"
 
 // FileIO
+#include "BinaryFieldIO.h"
 #include "BoundaryConditionIO.h"
 #include "GeoIO.h"
 #include "ProcessIO.h"
@@ -896,6 +897,27 @@ inline void CBoundaryCondition::DirectAssign(CRFProcess* m_pcs, long ShiftInNode
 	double n_val;
 	CBoundaryConditionNode* m_node_value = NULL;
 
+	// Binary field file
+	if (FileIO::BinaryFieldIO::isBinaryFieldFile(fname))
+	{
+		std::vector<long> node_ids;
+		std::vector<double> node_values;
+		if (!FileIO::BinaryFieldIO::readNodeValues(fname, node_ids, node_values))
+			abort();
+		for (size_t i = 0; i < node_ids.size(); i++)
+		{
+			m_node_value = new CBoundaryConditionNode;
+			m_node_value->conditional = false;
+			m_node_value->msh_node_number = node_ids[i] + ShiftInNodeVector;
+			m_node_value->geo_node_number = node_ids[i];
+			m_node_value->node_value = node_values[i];
+			m_node_value->CurveIndex = _curve_index;
+			m_pcs->bc_node.push_back(this);
+			m_pcs->bc_node_value.push_back(m_node_value);
+		}
+		return;
+	}
+
 	//========================================================================
 	// File handling
 	std::ifstream d_file(fname.c_str(), std::ios::in);
@@ -82,6 +82,8 @@ CFluidMomentum::CFluidMomentum(void)
 {
 	m_pcs = NULL;
 	RWPTSwitch = 0; // Set to be no
+	recovery_mass = NULL;
+	recovery_msh = NULL;
 }
 
 /**************************************************************************
@@ -93,6 +95,7 @@ CFluidMomentum::CFluidMomentum(void)
 **************************************************************************/
 CFluidMomentum::~CFluidMomentum(void)
 {
+	delete recovery_mass;
 }
 
 /**************************************************************************
@@ -216,7 +219,13 @@ double CFluidMomentum::Execute(int loop_process_number)
 **************************************************************************/
 void CFluidMomentum::SolveDarcyVelocityOnNode()
 {
-#if !defined(USE_PETSC) // || defined(other parallel libs)//03~04.3012. WW
+#if defined(USE_PETSC) // || defined(other parallel libs)//03~04.3012. WW
+	// The recovery needs the whole mesh, and no PETSc equation system is
+	// created for FLUID_MOMENTUM
+	cout << "Error in FLUID_MOMENTUM: the nodal velocity recovery is not available with PETSc"
+	     << "\n";
+	abort();
+#else
 	int nidx1 = 0;
 	long i;
 	MeshLib::CElem* elem = NULL;
@@ -258,163 +267,267 @@ void CFluidMomentum::SolveDarcyVelocityOnNode()
 		axis = 3; // x, y, z only
 	}
 
-	// Loop over three dimension to solve three velocity components
-	for (int phase = 0; phase < GetRFProcessNumPhases(); phase++)
+	// Solve for the velocity components. Without boundary conditions on the
+	// velocity all components share the mass matrix and are recovered together.
+	const bool with_bc = !m_pcs->bc_node_value.empty();
+	const size_t n_nodes = m_msh->GetNodesNumber(false);
+	std::vector<double> velocity;
+	if (!with_bc)
+		RecoverNodeVelocity(dimension, velocity);
+	for (int d = 0; d < dimension; ++d)
 	{
-		for (int d = 0; d < dimension; ++d)
+		if (with_bc)
+			SolveNodeVelocityComponent(d, velocity);
+
+		/* Store solution vector in model node values table */
+		if (dimension == 1)
+			nidx1 = m_pcs->GetNodeValueIndex(m_pcs->pcs_primary_function_name[axis]) + 1;
+		else if (dimension == 2)
 		{
-/* Initializations */
-/* System matrix */
-#if defined(NEW_EQS) // WW
-			m_pcs->EQSInitialize();
-#else
-			SetLinearSolverType(m_pcs->getEQSPointer(), m_num); // NW
-			SetZeroLinearSolver(m_pcs->getEQSPointer());
-#endif
+			if (axis == 1) // x,y only
+				nidx1 = m_pcs->GetNodeValueIndex(m_pcs->pcs_primary_function_name[(axis - d + 1) % dimension]) + 1;
+			else if (axis == 2) // x,z only
+				nidx1 = m_pcs->GetNodeValueIndex(m_pcs->pcs_primary_function_name[(axis - d + 1) % 3]) + 1;
+			else
+				abort(); // Just stop something's wrong.
+		}
+		else if (dimension == 3)
+			nidx1 = m_pcs->GetNodeValueIndex(m_pcs->pcs_primary_function_name[d]) + 1;
+		else
+			abort(); // Just stop something's wrong.
 
-			for (i = 0; i < (long)m_msh->ele_vector.size(); i++)
-			{
-				elem = m_msh->ele_vector[i];
-				if (elem->GetMark()) // Marked for use
-				{
-					fem->ConfigElement(elem);
-					fem->Assembly(0, d);
-				}
-			}
+		const double* v = with_bc ? &velocity[0] : &velocity[d * n_nodes];
+		for (size_t j = 0; j < n_nodes; j++)
+			m_pcs->SetNodeValue(j, nidx1, v[j]);
+	}
 
-			//		MXDumpGLS("rf_pcs.txt",1,m_pcs->eqs->b,m_pcs->eqs->x); //abort();
-			m_pcs->IncorporateBoundaryConditions(-1, d);
-// Solve for velocity
-#if defined(NEW_EQS)
+	/*
+	   if(m_msh->GetCoordinateFlag() == 32)
+	   ; // do nothing
+	   else
+	   {
+	   ConstructFractureNetworkTopology();
+	   for(i = 0; i < (long)m_msh->nod_vector.size(); i++)
+	   {
+	      // Let's get the norm of the first connected element plane.
+	      double norm[3];
+	      if(m_msh->GetCoordinateFlag() != 32 && m_msh->GetCoordinateFlag() != 22)
+	   {
+	   norm[0] = 0.0; norm[1] = 0.0; norm[2] = 1.0;
+	   }
+	   else
+	   {
+	   // I assume that all the element stay on the same plane.
+	   // So, I use element No.1 as the reference element or plane
+	   for(int j=0; j<3; ++j)
+	   norm[j] = m_msh->ele_vector[0]->getTransformTensor(j+6);
+	   }
+
+	   // Do some proper projection of velocity computed from Fluid Momentum.
+	   // Get the fluid velocity for this node
+	   double V[3];
+	   V[0] = m_pcs->GetNodeValue(i, m_pcs->GetNodeValueIndex("VELOCITY1_X")+1);
+	   V[1] = m_pcs->GetNodeValue(i, m_pcs->GetNodeValueIndex("VELOCITY1_Y")+1);
+	   V[2] = m_pcs->GetNodeValue(i, m_pcs->GetNodeValueIndex("VELOCITY1_Z")+1);
+
+	   // Let's solve the projected velocity on the element plane
+	   // by  Vp = norm X (V X norm) assuming norm is a unit vector
+	   double VxNorm[3], Vp[3];
+	   CrossProduction(V,norm,VxNorm);
+	   CrossProduction(norm,VxNorm, Vp);
+
+	   // Store the projected velocity back to the node velocity
+	   m_pcs->SetNodeValue(i,m_pcs->GetNodeValueIndex("VELOCITY1_X")+1,Vp[0]);
+	   m_pcs->SetNodeValue(i,m_pcs->GetNodeValueIndex("VELOCITY1_Y")+1,Vp[1]);
+	   m_pcs->SetNodeValue(i,m_pcs->GetNodeValueIndex("VELOCITY1_Z")+1,Vp[2]);
+	   }
+	   }
+	 */
+	// Obtain the edge velocity
+	SolveForEdgeVelocity();
+
+	// Obtain element-based velocity
+	for (i = 0; i < (long)m_msh->ele_vector.size(); i++)
+	{
+		elem = m_msh->ele_vector[i];
 
-			double* x;
-			int size = (int)m_msh->nod_vector.size(); // OK411??? long
-			x = new double[size];
-#if defined(LIS)
-			m_pcs->EQSSolver(x); // an option added to tell FLUID_MOMENTUM for sparse matrix system.
-			cout << "Solver passed in FLUID_MOMENTUM."
-			     << "\n";
-#endif
-#else
-			ExecuteLinearSolver(m_pcs->getEQSPointer());
-#endif
+		double vx = 0.0, vy = 0.0, vz = 0.0;
+		int numOfNodeInElement = elem->GetVertexNumber();
 
-			/* Store solution vector in model node values table */
-			if (dimension == 1)
-				nidx1 = m_pcs->GetNodeValueIndex(m_pcs->pcs_primary_function_name[axis]) + 1;
-			else if (dimension == 2)
-			{
-				if (axis == 1) // x,y only
-					nidx1 = m_pcs->GetNodeValueIndex(m_pcs->pcs_primary_function_name[(axis - d + 1) % dimension]) + 1;
-				else if (axis == 2) // x,z only
-					nidx1 = m_pcs->GetNodeValueIndex(m_pcs->pcs_primary_function_name[(axis - d + 1) % 3]) + 1;
-				else
-					abort(); // Just stop something's wrong.
-			}
-			else if (dimension == 3)
-				nidx1 = m_pcs->GetNodeValueIndex(m_pcs->pcs_primary_function_name[d]) + 1;
-			else
-				abort(); // Just stop something's wrong.
+		for (int j = 0; j < numOfNodeInElement; ++j)
+		{
+			vx += m_pcs->GetNodeValue(elem->GetNodeIndex(j), m_pcs->GetNodeValueIndex("VELOCITY1_X") + 1);
+			vy += m_pcs->GetNodeValue(elem->GetNodeIndex(j), m_pcs->GetNodeValueIndex("VELOCITY1_Y") + 1);
+			vz += m_pcs->GetNodeValue(elem->GetNodeIndex(j), m_pcs->GetNodeValueIndex("VELOCITY1_Z") + 1);
+		}
+		vx /= (double)numOfNodeInElement;
+		vy /= (double)numOfNodeInElement;
+		vz /= (double)numOfNodeInElement;
 
-#if defined(NEW_EQS)
-			for (int j = 0; j < size; j++)
-				m_pcs->SetNodeValue(m_msh->Eqs2Global_NodeIndex[j], nidx1, x[j]);
+		/*
+		         switch(phase)
+		         {
+		            case 0:
+		 */
 
-			delete[] x;
-#else
-			LINEAR_SOLVER* eqs = m_pcs->getEQSPointer();
-			for (int j = 0; j < eqs->dim; j++)
-				m_pcs->SetNodeValue(m_msh->Eqs2Global_NodeIndex[j], nidx1, eqs->x[j]);
-#endif
-		}
+		m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY1_X") + 1, vx);
+		m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY1_Y") + 1, vy);
+		m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY1_Z") + 1, vz);
 
 		/*
-		   if(m_msh->GetCoordinateFlag() == 32)
-		   ; // do nothing
-		   else
-		   {
-		   ConstructFractureNetworkTopology();
-		   for(i = 0; i < (long)m_msh->nod_vector.size(); i++)
-		   {
-		      // Let's get the norm of the first connected element plane.
-		      double norm[3];
-		      if(m_msh->GetCoordinateFlag() != 32 && m_msh->GetCoordinateFlag() != 22)
-		   {
-		   norm[0] = 0.0; norm[1] = 0.0; norm[2] = 1.0;
-		   }
-		   else
-		   {
-		   // I assume that all the element stay on the same plane.
-		   // So, I use element No.1 as the reference element or plane
-		   for(int j=0; j<3; ++j)
-		   norm[j] = m_msh->ele_vector[0]->getTransformTensor(j+6);
-		   }
-
-		   // Do some proper projection of velocity computed from Fluid Momentum.
-		   // Get the fluid velocity for this node
-		   double V[3];
-		   V[0] = m_pcs->GetNodeValue(i, m_pcs->GetNodeValueIndex("VELOCITY1_X")+1);
-		   V[1] = m_pcs->GetNodeValue(i, m_pcs->GetNodeValueIndex("VELOCITY1_Y")+1);
-		   V[2] = m_pcs->GetNodeValue(i, m_pcs->GetNodeValueIndex("VELOCITY1_Z")+1);
-
-		   // Let's solve the projected velocity on the element plane
-		   // by  Vp = norm X (V X norm) assuming norm is a unit vector
-		   double VxNorm[3], Vp[3];
-		   CrossProduction(V,norm,VxNorm);
-		   CrossProduction(norm,VxNorm, Vp);
-
-		   // Store the projected velocity back to the node velocity
-		   m_pcs->SetNodeValue(i,m_pcs->GetNodeValueIndex("VELOCITY1_X")+1,Vp[0]);
-		   m_pcs->SetNodeValue(i,m_pcs->GetNodeValueIndex("VELOCITY1_Y")+1,Vp[1]);
-		   m_pcs->SetNodeValue(i,m_pcs->GetNodeValueIndex("VELOCITY1_Z")+1,Vp[2]);
-		   }
-		   }
+		               break;
+		            case 1:
+		               m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY2_X")+1, vx);
+		                    m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY2_Y")+1, vy);
+		                    m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY2_Z")+1, vz);
+		               break;
+		            default:
+		               cout << "Error in VELCalcElementVelocity: invalid phase number" << "\n";
+		         }
 		 */
-		// Obtain the edge velocity
-		SolveForEdgeVelocity();
+	}
+#endif
+}
+
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Nodal velocity recovery M v_d = b_d for all velocity components d.
+         The consistent mass matrix M is assembled once and kept as long as
+         the mesh and its active elements do not change. With
+         $ELE_MASS_LUMPING the lumped mass matrix is used instead, then the
+         velocity is obtained node by node.
+         velocity[d * n_nodes + i]: component d at node i
+   Programing:
+   05/2005 PCH Implementation (SolveDarcyVelocityOnNode)
+**************************************************************************/
+void CFluidMomentum::RecoverNodeVelocity(int dimension, std::vector<double>& velocity)
+{
+	const size_t n_nodes = m_msh->GetNodesNumber(false);
+	const bool rebuild = !recovery_mass || recovery_msh != m_msh || recovery_mass->Rows() != n_nodes
+	                     || hasAnyProcessDeactivatedSubdomains;
+	if (rebuild)
+	{
+		delete recovery_mass;
+		std::vector<std::vector<size_t> > row_columns(n_nodes);
+		for (size_t e = 0; e < m_msh->ele_vector.size(); e++)
+		{
+			MeshLib::CElem* elem = m_msh->ele_vector[e];
+			if (!elem->GetMark())
+				continue;
+			const int nn = elem->GetVertexNumber();
+			for (int i = 0; i < nn; i++)
+				for (int j = 0; j < nn; j++)
+					row_columns[elem->GetNodeIndex(i)].push_back(elem->GetNodeIndex(j));
+		}
+		recovery_mass = new SparseMatrixCSR(row_columns);
+		recovery_msh = m_msh;
+	}
+
+	// Assemble the RHS of all components, and the mass matrix if needed
+	std::vector<double> rhs(dimension * n_nodes, 0.0);
+	double local_mass[20 * 20];
+	double local_rhs[3 * 20];
+	for (size_t e = 0; e < m_msh->ele_vector.size(); e++)
+	{
+		MeshLib::CElem* elem = m_msh->ele_vector[e];
+		if (!elem->GetMark()) // Marked for use
+			continue;
+		fem->ConfigElement(elem);
+		fem->LocalAssembly_VelocityRecovery(0, dimension, rebuild ? local_mass : NULL, local_rhs);
 
-		// Obtain element-based velocity
-		for (i = 0; i < (long)m_msh->ele_vector.size(); i++)
+		const int nn = elem->GetVertexNumber();
+		for (int i = 0; i < nn; i++)
 		{
-			elem = m_msh->ele_vector[i];
+			const size_t row = elem->GetNodeIndex(i);
+			for (int d = 0; d < dimension; d++)
+				rhs[d * n_nodes + row] += local_rhs[d * nn + i];
+			if (!rebuild)
+				continue;
+			for (int j = 0; j < nn; j++)
+				(*recovery_mass)(row, elem->GetNodeIndex(j)) += local_mass[i * nn + j];
+		}
+	}
+	if (rebuild)
+		recovery_mass->RowSums(recovery_mass_lumped);
 
-			double vx = 0.0, vy = 0.0, vz = 0.0;
-			int numOfNodeInElement = elem->GetVertexNumber();
+	if (m_num && m_num->ele_mass_lumping)
+	{
+		velocity.assign(dimension * n_nodes, 0.0);
+		for (int d = 0; d < dimension; d++)
+			for (size_t i = 0; i < n_nodes; i++)
+				if (recovery_mass_lumped[i] > 0.0)
+					velocity[d * n_nodes + i] = rhs[d * n_nodes + i] / recovery_mass_lumped[i];
+		return;
+	}
 
-			for (int j = 0; j < numOfNodeInElement; ++j)
-			{
-				vx += m_pcs->GetNodeValue(elem->GetNodeIndex(j), m_pcs->GetNodeValueIndex("VELOCITY1_X") + 1);
-				vy += m_pcs->GetNodeValue(elem->GetNodeIndex(j), m_pcs->GetNodeValueIndex("VELOCITY1_Y") + 1);
-				vz += m_pcs->GetNodeValue(elem->GetNodeIndex(j), m_pcs->GetNodeValueIndex("VELOCITY1_Z") + 1);
-			}
-			vx /= (double)numOfNodeInElement;
-			vy /= (double)numOfNodeInElement;
-			vz /= (double)numOfNodeInElement;
-
-			/*
-			         switch(phase)
-			         {
-			            case 0:
-			 */
-
-			m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY1_X") + 1, vx);
-			m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY1_Y") + 1, vy);
-			m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY1_Z") + 1, vz);
-
-			/*
-			               break;
-			            case 1:
-			               m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY2_X")+1, vx);
-			                    m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY2_Y")+1, vy);
-			                    m_pcs->SetElementValue(i, m_pcs->GetElementValueIndex("VELOCITY2_Z")+1, vz);
-			               break;
-			            default:
-			               cout << "Error in VELCalcElementVelocity: invalid phase number" << "\n";
-			         }
-			 */
+	const double tol = m_num ? m_num->ls_error_tolerance : 1.e-12;
+	const int max_iterations = m_num ? m_num->ls_max_iterations : 1000;
+	const int iterations = solvePCGMultiRHS(*recovery_mass, dimension, rhs, velocity, tol, max_iterations);
+	if (iterations < 0)
+		cout << "Warning in FLUID_MOMENTUM: velocity recovery not converged after " << max_iterations
+		     << " iterations"
+		     << "\n";
+	else
+		cout << "      PCG iterations for nodal velocity: " << iterations << "\n";
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Solve for one velocity component d with the equation system of the
+         process, which takes the boundary conditions on the velocity into
+         account. velocity[i]: component d at node i
+   Programing:
+   05/2005 PCH Implementation (SolveDarcyVelocityOnNode)
+**************************************************************************/
+void CFluidMomentum::SolveNodeVelocityComponent(int d, std::vector<double>& velocity)
+{
+#if !defined(USE_PETSC) // || defined(other parallel libs)//03~04.3012. WW
+/* Initializations */
+/* System matrix */
+#if defined(NEW_EQS) // WW
+	m_pcs->EQSInitialize();
+#else
+	SetLinearSolverType(m_pcs->getEQSPointer(), m_num); // NW
+	SetZeroLinearSolver(m_pcs->getEQSPointer());
+#endif
+
+	for (size_t i = 0; i < m_msh->ele_vector.size(); i++)
+	{
+		MeshLib::CElem* elem = m_msh->ele_vector[i];
+		if (elem->GetMark()) // Marked for use
+		{
+			fem->ConfigElement(elem);
+			fem->Assembly(0, d);
 		}
 	}
 
+	//		MXDumpGLS("rf_pcs.txt",1,m_pcs->eqs->b,m_pcs->eqs->x); //abort();
+	m_pcs->IncorporateBoundaryConditions(-1, d);
+
+	// Solve for velocity
+	const size_t n_nodes = m_msh->GetNodesNumber(false);
+	velocity.assign(n_nodes, 0.0);
+#if defined(NEW_EQS)
+#if defined(USE_MPI)
+	// CRFProcess::EQSSolver is not built with MPI
+	cout << "Error in FLUID_MOMENTUM: boundary conditions on the velocity are not supported with MPI"
+	     << "\n";
+	abort();
+#else
+	std::vector<double> x(m_msh->nod_vector.size());
+	m_pcs->EQSSolver(&x[0]); // an option added to tell FLUID_MOMENTUM for sparse matrix system.
+	cout << "Solver passed in FLUID_MOMENTUM."
+	     << "\n";
+	for (size_t j = 0; j < n_nodes; j++)
+		velocity[m_msh->Eqs2Global_NodeIndex[j]] = x[j];
+#endif
+#else
+	ExecuteLinearSolver(m_pcs->getEQSPointer());
+	LINEAR_SOLVER* eqs = m_pcs->getEQSPointer();
+	for (int j = 0; j < eqs->dim; j++)
+		velocity[m_msh->Eqs2Global_NodeIndex[j]] = eqs->x[j];
+#endif
 #endif
 }
 
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 //#include "rf_vel_new.h"
+#include "SparseMatrixCSR.h"
 #include "fem_ele.h"
 #include "fem_ele_std.h"
 #ifndef NEW_EQS // WW. 06.11.2008
@@ -103,6 +104,15 @@ protected:
 
 private:
 	CRFProcess* m_pcs;
+
+	// Mass matrix of the nodal velocity recovery. It depends on the geometry
+	// only and is kept over the time steps.
+	Math_Group::SparseMatrixCSR* recovery_mass;
+	std::vector<double> recovery_mass_lumped;
+	CFEMesh* recovery_msh;
+
+	void RecoverNodeVelocity(int dimension, std::vector<double>& velocity);
+	void SolveNodeVelocityComponent(int d, std::vector<double>& velocity);
 };
 
 extern void FMRead(std::string pcs_name = "");
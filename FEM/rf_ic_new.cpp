@@ -41,6 +41,9 @@ using namespace std;
 
 #include "InitialCondition.h"
 
+// FileIO
+#include "FEMIO/BinaryFieldIO.h"
+
 //==========================================================================
 vector<CInitialConditionGroup*> ic_group_vector;
 vector<CInitialCondition*> ic_vector;
@@ -543,6 +546,18 @@ void CInitialCondition::SetByNodeIndex(int nidx)
 	long node_index;
 	double node_val;
 
+	// Binary field file
+	if (FileIO::BinaryFieldIO::isBinaryFieldFile(fname))
+	{
+		std::vector<long> node_ids;
+		std::vector<double> node_values;
+		if (!FileIO::BinaryFieldIO::readNodeValues(fname, node_ids, node_values))
+			abort();
+		for (size_t i = 0; i < node_ids.size(); i++)
+			this->getProcess()->SetNodeValue(node_ids[i], nidx, node_values[i]);
+		return;
+	}
+
 	// File handling
 	ifstream d_file(fname.c_str(), ios::in);
 	if (!d_file.is_open())
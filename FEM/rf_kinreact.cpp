@@ -4430,9 +4430,8 @@ void CKinReactData::Biodegradation(double* m_Conc, long node, double eps, double
 
 void CKinReactData::Calc_linearized_rates(double* m_Conc, long Number_of_Components, double deltaT, long node)
 {
-	double* dydx;
-
-	dydx = dvector(1, Number_of_Components);
+	ode_rates.resize(Number_of_Components + 1);
+	double* dydx = &ode_rates[0];
 	derivs(deltaT, m_Conc, dydx, Number_of_Components, node, deltaT);
 	for (long i = 0; i < Number_of_Components; i++)
 		m_Conc[i + 1] += dydx[i + 1] * deltaT;
@@ -5562,7 +5561,8 @@ void jacobn(double t, double c[], double dfdt[], double** dfdc, int n, long node
 	//  m_krd->debugoutstr << " jacobn" << "\n" << flush;
 
 	/* Hilfsvektor f�r partielle Ableitung des Bakterienwachstums nach Species S */
-	d2X_dtdS = dvector(1, n);
+	m_krd->ode_rates.resize(n + 1);
+	d2X_dtdS = &m_krd->ode_rates[0];
 
 	/* weitere Ableitungen nach t dfdt[] alle null */
 	/* Ableitungen nach c dfdc[][] werden inkrementiv berechnet, also erst alles null setzen */
@@ -6249,8 +6249,6 @@ void jacobn(double t, double c[], double dfdt[], double** dfdc, int n, long node
 		} // NAPL-dissolution
 	} // loop over reactions r
 	//#ds
-
-	free_dvector(d2X_dtdS, 1, n);
 }
 
 /**************************************************************************
@@ -426,6 +426,7 @@ public:
 
 	std::vector<double> node_foc;
 	std::vector<double> IonicStrengths;
+	std::vector<double> ode_rates; // Work array of jacobn and Calc_linearized_rates, kept over all nodes
 	std::vector<std::vector<double> > ActivityCoefficients; //  For Mineral Dissolution, store gammas in 1 data object
 	int activity_model;
 
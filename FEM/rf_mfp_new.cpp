@@ -948,7 +948,7 @@ double CFluidProperties::Density(double* variables)
 {
 	double pressure;
 	double Rho = 0.0;
-	static double density;
+	double density = 0.0;
 	// static double air_gas_density,vapour_density,vapour_pressure;
 
 	int gueltig;
@@ -956,71 +956,8 @@ double CFluidProperties::Density(double* variables)
 	//----------------------------------------------------------------------
 	if (variables) // This condition is added by WW
 	{
-		//----------------------------------------------------------------------
-		// Duplicate the following lines just to enhance computation. WW
 		switch (density_model)
 		{
-			case 0: // rho = f(x)
-				density = GetCurveValue(density_curve_number, 0, variables[1], &gueltig);
-				break;
-			case 1: // rho = const
-				density = rho_0;
-				break;
-			case 2: // rho(p) = rho_0*(1+beta_p*(p-p_0))
-				density = rho_0 * (1. + drho_dp * (max(variables[0], 0.0) - p_0));
-				break;
-			case 3: // rho(C) = rho_0*(1+beta_C*(C-C_0))
-				density = rho_0 * (1. + drho_dC * (max(variables[2], 0.0) - C_0));
-				break;
-			case 4: // rho(T) = rho_0*(1+beta_T*(T-T_0))
-				density = rho_0 * (1. + drho_dT * (max(variables[1], 0.0) - T_0));
-				break;
-			case 5: // rho(C,T) = rho_0*(1+beta_C*(C-C_0)+beta_T*(T-T_0))
-				density = rho_0
-				          * (1. + drho_dC * (max(variables[2], 0.0) - C_0) + drho_dT * (max(variables[1], 0.0) - T_0));
-				break;
-			case 6: // rho(p,T) = rho_0*(1+beta_p*(p-p_0)+beta_T*(T-T_0))
-				density = rho_0
-				          * (1. + drho_dp * (max(variables[0], 0.0) - p_0) + drho_dT * (max(variables[1], 0.0) - T_0));
-				break;
-			case 7: // Pefect gas. WW
-				density = variables[0] * molar_mass / (PhysicalConstant::IdealGasConstant * variables[1]);
-				break;
-			case 8: // M14 von JdJ // 25.1.12 Added by CB for density output AB-model
-				density = MATCalcFluidDensityMethod8(variables[0], variables[1], variables[2]);
-				break;
-			case 10: // Get density from temperature-pressure values from fct-file	NB 4.8.01
-				if (!T_Process)
-					variables[1] = T_0;
-				else
-					variables[1] += T_0; // JM if T_0==273 (user defined), Celsius can be used within this model
-				density = GetMatrixValue(variables[1], variables[0], fluid_name, &gueltig);
-				break;
-			case 11: // Redlich-Kwong EOS for different fluids NB 4.9.05
-				if (!T_Process)
-					variables[1] = T_0;
-				else
-					variables[1] += T_0; // JM if T_0==273 (user defined), Celsius can be used within this model
-				density = rkeos(variables[1], variables[0], fluid_id);
-				break;
-			case 12: // Peng-Robinson EOS for different fluids NB 4.9.05
-				if (!T_Process)
-					variables[1] = T_0;
-				else
-					variables[1] += T_0; // JM if T_0==273 (user defined), Celsius can be used within this model
-				// NB
-				density = preos(this, variables[1], variables[0]);
-				break;
-			case 13: // Helmholtz free Energy NB JUN 09
-				variables[1] += T_0; // JM if T_0==273 (user defined), Celsius can be used within this model
-				// NB
-				density = zero(variables[1], variables[0], fluid_id, 1e-8);
-				break;
-			case 14: // #Exponential law#
-				density = rho_0 * exp(drho_dp * (max(variables[0], 0.0) - p_0) + drho_dT * (max(variables[2], 0.0))
-				                      + drho_dC * max(variables[2], 0.0));
-				break;
-
 			case 15: // mixture 1/rho= sum_i x_i/rho_i #p, T, x:->Amagat's law#
 				for (int CIndex = 2; CIndex < cmpN + 2; CIndex++)
 					Rho += variables[CIndex] / ComponentDensity(CIndex, variables);
@@ -1056,53 +993,12 @@ double CFluidProperties::Density(double* variables)
 #endif
 				// insert call for GEMS densities..
 				break;
-			case 20: // rho(p,T, C) for water, range p < 100 MPa, 0 <= T <= 350 °C   Magri GFZ thesis
-
-				pressure = variables[0] / 1e5;
-				density = 9.99792877961606e+02 + 5.07605113140940e-04 * max(pressure, 0.0)
-				          - 5.28425478164183e-10 * pow(max(pressure, 0.0), 2.)
-				          + (5.13864847162196e-02 - 3.61991396354483e-06 * max(pressure, 0.0)
-				             + 7.97204102509724e-12 * pow(max(pressure, 0.0), 2.))
-				                * max(variables[1], 0.0)
-				          + (-7.53557031774437e-03 + 6.32712093275576e-08 * max(pressure, 0.0)
-				             - 1.66203631393248e-13 * pow(max(pressure, 0.0), 2.))
-				                * pow(max(variables[1], 0.0), 2.)
-				          + (4.60380647957350e-05 - 5.61299059722121e-10 * max(pressure, 0.0)
-				             + 1.80924436489400e-15 * pow(max(pressure, 0.0), 2.))
-				                * pow(max(variables[1], 0.0), 3.)
-				          + (-2.26651454175013e-07 + 3.36874416675978e-12 * max(pressure, 0.0)
-				             - 1.30352149261326e-17 * pow(max(pressure, 0.0), 2.))
-				                * pow(max(variables[1], 0.0), 4.)
-				          + (6.14889851856743e-10 - 1.06165223196756e-14 * max(pressure, 0.0)
-				             + 4.75014903737416e-20 * pow(max(pressure, 0.0), 2.))
-				                * pow(max(variables[1], 0.0), 5.)
-				          + (-7.39221950969522e-13 + 1.42790422913922e-17 * max(pressure, 0.0)
-				             - 7.13130230531541e-23 * pow(max(pressure, 0.0), 2.))
-				                * pow(max(variables[1], 0.0), 6.);
-
-				if (fabs(drho_dC) > 1.e-20)
-					density *= 1. + drho_dC * (max(variables[2], 0.0) - C_0);
-
-				break;
-			case 26: // Dalton's law + ideal gas for use with TNEQ/TES
-			{
-				const double M0 = cp_vec[0]->molar_mass; // molar mass of component 0
-				const double M1 = cp_vec[1]->molar_mass;
-				const double p = variables[0];
-				const double T = variables[1];
-				const double x = variables[2]; // gas mass fraction of component 1
-				// assert(0.0 <= x && x <= 1.0);
-
-				// gas molar fraction of component 1
-				const double xn = M0 * x / (M0 * x + M1 * (1.0 - x));
-
-				density = p / (PhysicalConstant::IdealGasConstant * T) * (M1 * xn + M0 * (1.0 - xn)); // R_uni in mNs
-			}
-			break;
-
 			default:
-				std::cout << "Error in CFluidProperties::Density: no valid model"
-				          << "\n";
+				density = Density(MaterialState(variables));
+				// The models 10 to 13 return the shifted temperature, which is
+				// reused by the callers, e.g. Viscosity() model 9
+				if (density_model >= 10 && density_model <= 13)
+					variables[1] = densityTemperature(variables[1]);
 				break;
 		}
 	}
@@ -1181,8 +1077,9 @@ double CFluidProperties::Density(double* variables)
 				break;
 
 			case 14: // #Exponential law#
-				density = rho_0 * exp(drho_dp * (max(variables[0], 0.0) - p_0) + drho_dT * (max(variables[2], 0.0))
-				                      + drho_dC * max(variables[2], 0.0));
+				density = rho_0 * exp(drho_dp * (max(primary_variable[0], 0.0) - p_0)
+				                      + drho_dT * (max(primary_variable[2], 0.0))
+				                      + drho_dC * max(primary_variable[2], 0.0));
 				break;
 			case 15: // mixture 1/rho= sum_i x_i/rho_i #p, T, x:-> Amagat's law#
 				for (int CIndex = 2; CIndex < cmpN + 2; CIndex++)
@@ -1271,6 +1168,133 @@ double CFluidProperties::Density(double* variables)
 	return density;
 }
 
+/**************************************************************************
+   FEMLib-Method:
+   Task: Density at the state (p, T, C) without changing the object.
+         Same models as Density(double* variables).
+**************************************************************************/
+double CFluidProperties::Density(const MaterialState& state) const
+{
+	const double* variables = state.primary_variable;
+	double density = 0.0;
+	int gueltig;
+
+	switch (density_model)
+	{
+		case 0: // rho = f(x)
+			density = GetCurveValue(density_curve_number, 0, variables[1], &gueltig);
+			break;
+		case 1: // rho = const
+			density = rho_0;
+			break;
+		case 2: // rho(p) = rho_0*(1+beta_p*(p-p_0))
+			density = rho_0 * (1. + drho_dp * (max(variables[0], 0.0) - p_0));
+			break;
+		case 3: // rho(C) = rho_0*(1+beta_C*(C-C_0))
+			density = rho_0 * (1. + drho_dC * (max(variables[2], 0.0) - C_0));
+			break;
+		case 4: // rho(T) = rho_0*(1+beta_T*(T-T_0))
+			density = rho_0 * (1. + drho_dT * (max(variables[1], 0.0) - T_0));
+			break;
+		case 5: // rho(C,T) = rho_0*(1+beta_C*(C-C_0)+beta_T*(T-T_0))
+			density = rho_0 * (1. + drho_dC * (max(variables[2], 0.0) - C_0) + drho_dT * (max(variables[1], 0.0) - T_0));
+			break;
+		case 6: // rho(p,T) = rho_0*(1+beta_p*(p-p_0)+beta_T*(T-T_0))
+			density = rho_0 * (1. + drho_dp * (max(variables[0], 0.0) - p_0) + drho_dT * (max(variables[1], 0.0) - T_0));
+			break;
+		case 7: // Pefect gas. WW
+			density = variables[0] * molar_mass / (PhysicalConstant::IdealGasConstant * variables[1]);
+			break;
+		case 8: // M14 von JdJ // 25.1.12 Added by CB for density output AB-model
+			density = MATCalcFluidDensityMethod8(variables[0], variables[1], variables[2]);
+			break;
+		case 10: // Get density from temperature-pressure values from fct-file	NB 4.8.01
+			density = GetMatrixValue(densityTemperature(variables[1]), variables[0], fluid_name, &gueltig);
+			break;
+		case 11: // Redlich-Kwong EOS for different fluids NB 4.9.05
+			density = rkeos(densityTemperature(variables[1]), variables[0], fluid_id);
+			break;
+		case 12: // Peng-Robinson EOS for different fluids NB 4.9.05
+			density = preos(this, densityTemperature(variables[1]), variables[0]);
+			break;
+		case 13: // Helmholtz free Energy NB JUN 09
+			density = zero(densityTemperature(variables[1]), variables[0], fluid_id, 1e-8);
+			break;
+		case 14: // #Exponential law#
+			density = rho_0 * exp(drho_dp * (max(variables[0], 0.0) - p_0) + drho_dT * (max(variables[2], 0.0))
+			                      + drho_dC * max(variables[2], 0.0));
+			break;
+		case 20: // rho(p,T, C) for water, range p < 100 MPa, 0 <= T <= 350 °C   Magri GFZ thesis
+		{
+			const double pressure = max(variables[0] / 1e5, 0.0);
+			const double T = max(variables[1], 0.0);
+			density = 9.99792877961606e+02 + 5.07605113140940e-04 * pressure - 5.28425478164183e-10 * pow(pressure, 2.)
+			          + (5.13864847162196e-02 - 3.61991396354483e-06 * pressure
+			             + 7.97204102509724e-12 * pow(pressure, 2.))
+			                * T
+			          + (-7.53557031774437e-03 + 6.32712093275576e-08 * pressure
+			             - 1.66203631393248e-13 * pow(pressure, 2.))
+			                * pow(T, 2.)
+			          + (4.60380647957350e-05 - 5.61299059722121e-10 * pressure
+			             + 1.80924436489400e-15 * pow(pressure, 2.))
+			                * pow(T, 3.)
+			          + (-2.26651454175013e-07 + 3.36874416675978e-12 * pressure
+			             - 1.30352149261326e-17 * pow(pressure, 2.))
+			                * pow(T, 4.)
+			          + (6.14889851856743e-10 - 1.06165223196756e-14 * pressure
+			             + 4.75014903737416e-20 * pow(pressure, 2.))
+			                * pow(T, 5.)
+			          + (-7.39221950969522e-13 + 1.42790422913922e-17 * pressure
+			             - 7.13130230531541e-23 * pow(pressure, 2.))
+			                * pow(T, 6.);
+
+			if (fabs(drho_dC) > 1.e-20)
+				density *= 1. + drho_dC * (max(variables[2], 0.0) - C_0);
+			break;
+		}
+		case 26: // Dalton's law + ideal gas for use with TNEQ/TES
+		{
+			const double M0 = cp_vec[0]->molar_mass; // molar mass of component 0
+			const double M1 = cp_vec[1]->molar_mass;
+			const double p = variables[0];
+			const double T = variables[1];
+			const double x = variables[2]; // gas mass fraction of component 1
+
+			// gas molar fraction of component 1
+			const double xn = M0 * x / (M0 * x + M1 * (1.0 - x));
+
+			density = p / (PhysicalConstant::IdealGasConstant * T) * (M1 * xn + M0 * (1.0 - xn)); // R_uni in mNs
+		}
+		break;
+		case 15:
+		case 18:
+		case 19:
+			std::cout << "Error in CFluidProperties::Density: model " << density_model
+			          << " is not available for the evaluation at a MaterialState"
+			          << "\n";
+			break;
+		default:
+			std::cout << "Error in CFluidProperties::Density: no valid model"
+			          << "\n";
+			break;
+	}
+	return density;
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Temperature passed to the equations of state of the density models
+         10 to 13 for the temperature T of the process
+**************************************************************************/
+double CFluidProperties::densityTemperature(double T) const
+{
+	if (density_model == 13)
+		return T + T_0; // JM if T_0==273 (user defined), Celsius can be used within this model
+	if (!T_Process)
+		return T_0;
+	return T + T_0;
+}
+
 /*-------------------------------------------------------------------------
    GeoSys - Function: GetElementValueFromNodes
    Task: Interpolates node values like density or viscosity to the elements (if GPIndex < 0) or to element gauss points
@@ -1387,7 +1411,7 @@ double CFluidProperties::GetElementValueFromNodes(long ElementIndex, int GPIndex
    09/2004   CMCD  Inclusion in GeoSys vs. 4
 
 *************************************************************************/
-double CFluidProperties::MATCalcFluidDensityMethod8(double Press, double TempK, double Conc)
+double CFluidProperties::MATCalcFluidDensityMethod8(double Press, double TempK, double Conc) const
 {
 	Conc = Conc;
 	/*int c_idx;*/
@@ -1562,65 +1586,25 @@ double CFluidProperties::Viscosity(double* variables)
 	//----------------------------------------------------------------------
 	switch (viscosity_model)
 	{
-		case 0: // rho = f(x)
-		{
-			int gueltig;
-			viscosity = GetCurveValue(viscosity_curve_number, 0, primary_variable[1], &gueltig);
-			break;
-		}
-		case 1: // my = const
-			viscosity = my_0;
-			break;
-		case 2: // my(p) = my_0*(1+gamma_p*(p-p_0))
-			viscosity = my_0 * (1. + dmy_dp * (max(primary_variable[0], 0.0) - p_0));
-			break;
 		case 3: // my^l(T), Yaws et al. (1976)
-		{
-			CRFProcess* m_pcs = PCSGet("MULTI_COMPONENTIAL_FLOW");
-
 			if (mode == 1) // OK4704 for nodal output
 			{
-				m_pcs = PCSGet("HEAT_TRANSPORT");
-				// if(!m_pcs) return 0.0;
+				CRFProcess* m_pcs = PCSGet("HEAT_TRANSPORT");
 				primary_variable[1] = m_pcs->GetNodeValue(node, m_pcs->GetNodeValueIndex("TEMPERATURE1") + 1);
 			}
-			// ToDo pcs_name
-			if (!T_Process)
-				primary_variable[1] = T_0 + viscosity_T_shift;
-			else
-				primary_variable[1] += viscosity_T_shift; // JM if viscosity_T_shift==273 (user defined), Celsius can be
-			// used within this model
-			viscosity = LiquidViscosity_Yaws_1976(primary_variable[1]);
-			break;
-		}
-		case 4: // my^g(T), Marsily (1986)
-			viscosity = LiquidViscosity_Marsily_1986(primary_variable[1]);
-			// viscosity = LiquidViscosity_Marsily_1986(primary_variable[0]);
-			break;
-		case 5: // my^g(p,T), Reichenberg (1971)
-			viscosity = GasViscosity_Reichenberg_1971(primary_variable[0], primary_variable[1]);
-			break;
-		case 6: // my(C,T),
-			viscosity = LiquidViscosity_NN(primary_variable[0], primary_variable[1]);
-			break;
-		case 8: // my(p,C,T),
-			viscosity = LiquidViscosity_CMCD(primary_variable[0], primary_variable[1], primary_variable[2]);
+			viscosity = Viscosity(MaterialState(primary_variable));
 			break;
 		case 9: // viscosity as function of density and temperature, NB
 		{
-			double mfp_arguments[2];
-
+			// Density() also covers the density models which depend on the object state
+			double mfp_arguments[3];
 			if (!T_Process)
 				primary_variable[1] = T_0;
-			// TODO: switch case different models...
-			// Problem.cpp 3 PS_GLOBAL, 1212,1313 pcs_type
-			// TODO: default fluid_ID, if not specified
 			mfp_arguments[0] = primary_variable[0]; // rescue primary_variable before its destroyed by Density();
 			mfp_arguments[1] = primary_variable[1];
+			mfp_arguments[2] = primary_variable[2];
 
-			const double density
-			    = Density(mfp_arguments); // TODO: (NB) store density (and viscosity) as secondary variable
-			// NB
+			const double density = Density(mfp_arguments);
 			viscosity = Fluid_Viscosity(density, mfp_arguments[1], mfp_arguments[0], fluid_id);
 			break;
 		}
@@ -1652,8 +1636,71 @@ double CFluidProperties::Viscosity(double* variables)
 			    int(variables[0]), int(variables[1]), int(variables[2]),
 			    1); // hand over element index, Gauss point index, phase index and variable index
 			break;
-		case 19: // reserved for GEMS coupling
+		default:
+			viscosity = Viscosity(MaterialState(primary_variable));
 			break;
+	}
+	//----------------------------------------------------------------------
+
+	return viscosity;
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Viscosity at the state (p, T, C) without changing the object.
+         Same models as Viscosity(double* variables).
+**************************************************************************/
+double CFluidProperties::Viscosity(const MaterialState& state) const
+{
+	const double* variables = state.primary_variable;
+	double viscosity = 0.0;
+
+	switch (viscosity_model)
+	{
+		case 0: // rho = f(x)
+		{
+			int gueltig;
+			viscosity = GetCurveValue(viscosity_curve_number, 0, variables[1], &gueltig);
+			break;
+		}
+		case 1: // my = const
+			viscosity = my_0;
+			break;
+		case 2: // my(p) = my_0*(1+gamma_p*(p-p_0))
+			viscosity = my_0 * (1. + dmy_dp * (max(variables[0], 0.0) - p_0));
+			break;
+		case 3: // my^l(T), Yaws et al. (1976)
+			// ToDo pcs_name
+			if (!T_Process)
+				viscosity = LiquidViscosity_Yaws_1976(T_0 + viscosity_T_shift);
+			else // JM if viscosity_T_shift==273 (user defined), Celsius can be used within this model
+				viscosity = LiquidViscosity_Yaws_1976(variables[1] + viscosity_T_shift);
+			break;
+		case 4: // my^g(T), Marsily (1986)
+			viscosity = LiquidViscosity_Marsily_1986(variables[1]);
+			break;
+		case 5: // my^g(p,T), Reichenberg (1971)
+			viscosity = GasViscosity_Reichenberg_1971(variables[0], variables[1]);
+			break;
+		case 6: // my(C,T),
+			viscosity = LiquidViscosity_NN(variables[0], variables[1]);
+			break;
+		case 8: // my(p,C,T),
+			viscosity = LiquidViscosity_CMCD(variables[0], variables[1], variables[2]);
+			break;
+		case 9: // viscosity as function of density and temperature, NB
+		{
+			MaterialState density_state(state);
+			if (!T_Process)
+				density_state.primary_variable[1] = T_0;
+			const double density = Density(density_state);
+			// The equations of state of the density models 10 to 13 shift the temperature
+			double T = density_state.primary_variable[1];
+			if (density_model >= 10 && density_model <= 13)
+				T = densityTemperature(T);
+			viscosity = Fluid_Viscosity(density, T, variables[0], fluid_id);
+			break;
+		}
 		case 26: // Wilke (see Poling, B. E.; Prausnitz, J. M.; John Paul, O. & Reid, R. C. The properties of gases and
 			// liquids McGraw-Hill New York, 2001, 5: page 9.21)
 			{
@@ -1662,9 +1709,9 @@ double CFluidProperties::Viscosity(double* variables)
 				const double M1 = cp_vec[0]->molar_mass;
 				const double M2 = cp_vec[1]->molar_mass;
 
-				const double p = primary_variable[0];
-				const double T = primary_variable[1];
-				const double X = primary_variable[2];
+				const double p = variables[0];
+				const double T = variables[1];
+				const double X = variables[2];
 
 				// reactive component
 				x[0] = M1 * X / (M1 * X + M2 * (1.0 - X)); // mass in mole fraction
@@ -1687,15 +1734,19 @@ double CFluidProperties::Viscosity(double* variables)
 				break;
 			}
 		case 30: // exp(T) e.g Reynolds
-			viscosity = LiquidViscosity_expo(primary_variable[1]);
+			viscosity = LiquidViscosity_expo(variables[1]);
+			break;
+		case 15:
+		case 18:
+			std::cout << "Error in CFluidProperties::Viscosity: model " << viscosity_model
+			          << " is not available for the evaluation at a MaterialState"
+			          << "\n";
 			break;
 		default:
 			cout << "Error in CFluidProperties::Viscosity: no valid model"
 			     << "\n";
 			break;
 	}
-	//----------------------------------------------------------------------
-
 	return viscosity;
 }
 
@@ -1709,7 +1760,7 @@ double CFluidProperties::Viscosity(double* variables)
    08/2004 OK MFP implementation based on CalcFluidViscosityMethod7 by OK
    last modification:
 **************************************************************************/
-double CFluidProperties::GasViscosity_Reichenberg_1971(double p, double T)
+double CFluidProperties::GasViscosity_Reichenberg_1971(double p, double T) const
 {
 	double my, my0;
 	double A, B, C, D;
@@ -1758,7 +1809,7 @@ double CFluidProperties::GasViscosity_Reichenberg_1971(double p, double T)
            based on CalcFluidViscosityMethod8 by OK (06/2001)
    last modification:
 **************************************************************************/
-double CFluidProperties::LiquidViscosity_Yaws_1976(double T)
+double CFluidProperties::LiquidViscosity_Yaws_1976(double T) const
 {
 	double ln_my, my;
 	double A, B, C, D;
@@ -1795,7 +1846,7 @@ double CFluidProperties::LiquidViscosity_Yaws_1976(double T)
            based on CalcFluidViscosityMethod9 by OK (05/2001)
    last modification:
 **************************************************************************/
-double CFluidProperties::LiquidViscosity_Marsily_1986(double T)
+double CFluidProperties::LiquidViscosity_Marsily_1986(double T) const
 {
 	const double A = 2.29E-03, B = -1.01E-03;
 
@@ -1820,7 +1871,7 @@ double CFluidProperties::LiquidViscosity_Marsily_1986(double T)
    08/2004 OK MFP implementation
    last modification:
 **************************************************************************/
-double CFluidProperties::LiquidViscosity_NN(double c, double T)
+double CFluidProperties::LiquidViscosity_NN(double c, double T) const
 {
 	double f1, f2, mu0 = 0.001, mu;
 	double omega0, omega, sigma0, sigma;
@@ -1941,9 +1992,6 @@ double CFluidProperties::SpecificHeatCapacity(double* variables)
 	double Cp = 0.0;
 	double x[2], Cp_c[2];
 
-	int gueltig = -1;
-	double pressure, saturation, temperature;
-
 	if (variables) // NB Jan 09
 	{
 		primary_variable[0] = variables[0]; // p (single phase)
@@ -1952,25 +2000,10 @@ double CFluidProperties::SpecificHeatCapacity(double* variables)
 	}
 	else
 		CalPrimaryVariable(specific_heat_capacity_pcs_name_vector);
-
-	pressure = primary_variable[0];
-	temperature = primary_variable[1];
-	saturation = primary_variable[2];
 	//......................................................................
 	//
 	switch (heat_capacity_model)
 	{
-		case 0: // c = f(x)
-			specific_heat_capacity = GetCurveValue(0, 0, temperature, &gueltig);
-			break;
-		case 1: // c = const, value already read in to specific_heat_capacity
-			break;
-		case 2: // c = f(p,T,Conc)
-			specific_heat_capacity = MATCalcFluidHeatCapacityMethod2(pressure, temperature, saturation);
-			break;
-		case 5:
-			specific_heat_capacity = GetCurveValue(heat_phase_change_curve, 0, temperature_buffer, &gueltig);
-			break;
 		case 9:
 			specific_heat_capacity = isobaric_heat_capacity(Density(primary_variable), primary_variable[1], fluid_id);
 			break;
@@ -1998,24 +2031,6 @@ double CFluidProperties::SpecificHeatCapacity(double* variables)
 				specific_heat_capacity /= (M1 * x[1] + M2 * x[0]); // molar in specific of mixture value
 				break;
 			}
-		case 12: // mass fraction weighted average of isobaric specific heat capacities using a linearised model
-			// reactive component
-			x[0] = primary_variable[2]; // mass fraction
-			Cp_c[0] = linear_heat_capacity(variables[1], cp_vec[1]->fluid_id);
-			// inert component
-			x[1] = 1.0 - x[0];
-			Cp_c[1] = linear_heat_capacity(variables[1], cp_vec[0]->fluid_id);
-			specific_heat_capacity = Cp_c[0] * x[0] + Cp_c[1] * x[1]; // mixture isobaric specific heat capacities
-			break;
-		case 13: //mass fraction weighted average of isobaric specific heat capacities using a polynomial model
-			//reactive component
-			x[0] = primary_variable[2]; //mass fraction
-			Cp_c[0] = polynomial_heat_capacity(variables[1],cp_vec[1]->fluid_id);
-			//inert component
-			x[1] = 1.0 - x[0];
-			Cp_c[1] = polynomial_heat_capacity(variables[1],cp_vec[0]->fluid_id);
-			specific_heat_capacity = Cp_c[0]*x[0] + Cp_c[1]*x[1]; //mixture isobaric specific heat capacities
-			break;
 		case 15: // mixture cp= sum_i y_i*cp:: P, T, x dependent
 			for (int CIndex = 2; CIndex < cmpN + 2; CIndex++)
 			{
@@ -2032,11 +2047,72 @@ double CFluidProperties::SpecificHeatCapacity(double* variables)
 			}
 			specific_heat_capacity = Cp;
 
+			break;
+		default:
+			specific_heat_capacity = SpecificHeatCapacity(MaterialState(primary_variable));
 			break;
 	}
 	return specific_heat_capacity;
 }
 
+/**************************************************************************
+   FEMLib-Method:
+   Task: Specific heat capacity at the state (p, T, C) without changing the
+         object. Same models as SpecificHeatCapacity(double* variables).
+**************************************************************************/
+double CFluidProperties::SpecificHeatCapacity(const MaterialState& state) const
+{
+	const double pressure = state.primary_variable[0];
+	const double temperature = state.primary_variable[1];
+	const double saturation = state.primary_variable[2];
+	double cp = specific_heat_capacity;
+	double x[2], Cp_c[2];
+	int gueltig = -1;
+
+	switch (heat_capacity_model)
+	{
+		case 0: // c = f(x)
+			cp = GetCurveValue(0, 0, temperature, &gueltig);
+			break;
+		case 1: // c = const, value already read in to specific_heat_capacity
+			break;
+		case 2: // c = f(p,T,Conc)
+			cp = MATCalcFluidHeatCapacityMethod2(pressure, temperature, saturation);
+			break;
+		case 5:
+			cp = GetCurveValue(heat_phase_change_curve, 0, temperature_buffer, &gueltig);
+			break;
+		case 9:
+			cp = isobaric_heat_capacity(Density(state), temperature, fluid_id);
+			break;
+		case 12: // mass fraction weighted average of isobaric specific heat capacities using a linearised model
+			// reactive component
+			x[0] = saturation; // mass fraction
+			Cp_c[0] = linear_heat_capacity(temperature, cp_vec[1]->fluid_id);
+			// inert component
+			x[1] = 1.0 - x[0];
+			Cp_c[1] = linear_heat_capacity(temperature, cp_vec[0]->fluid_id);
+			cp = Cp_c[0] * x[0] + Cp_c[1] * x[1]; // mixture isobaric specific heat capacities
+			break;
+		case 13: // mass fraction weighted average of isobaric specific heat capacities using a polynomial model
+			// reactive component
+			x[0] = saturation; // mass fraction
+			Cp_c[0] = polynomial_heat_capacity(temperature, cp_vec[1]->fluid_id);
+			// inert component
+			x[1] = 1.0 - x[0];
+			Cp_c[1] = polynomial_heat_capacity(temperature, cp_vec[0]->fluid_id);
+			cp = Cp_c[0] * x[0] + Cp_c[1] * x[1]; // mixture isobaric specific heat capacities
+			break;
+		case 11:
+		case 15:
+			std::cout << "Error in CFluidProperties::SpecificHeatCapacity: model " << heat_capacity_model
+			          << " is not available for the evaluation at a MaterialState"
+			          << "\n";
+			break;
+	}
+	return cp;
+}
+
 /**************************************************************************
    FEMLib-Method:
    Task: calculate heat capacity for phase change
@@ -2256,38 +2332,81 @@ double CFluidProperties::HeatConductivity(double* variables)
 	else
 		CalPrimaryVariable(heat_conductivity_pcs_name_vector);
 
+	switch (heat_conductivity_model)
+	{
+		case 3: // NB
+			heat_conductivity = Fluid_Heat_Conductivity(Density(), primary_variable[1], fluid_id);
+			// if (heat_conductivity<0.03) // not sure about this
+			break;
+		case 9:
+			heat_conductivity = Fluid_Heat_Conductivity(Density(primary_variable), primary_variable[1], fluid_id);
+			break;
+
+		case 15: // mixture k_m= sum_i y_i*k_i:: p, T, x
+		{
+			CRFProcess* m_pcs = PCSGet("MULTI_COMPONENTIAL_FLOW");
+			double Kappa = 0.0;
+
+			for (int CIndex = 2; CIndex < cmpN + 2; CIndex++)
+			{
+				if (eos_name == "CONSTANT")
+				{
+					Kappa += variables[CIndex] * kappa[CIndex - 2];
+				}
+				else
+				{
+					therm_prop(m_pcs->pcs_primary_function_name[CIndex]);
+					Kappa += variables[CIndex]
+					         * Fluid_Heat_Conductivity(ComponentDensity(CIndex, variables), variables[1], fluid_id);
+				}
+			}
+			heat_conductivity = Kappa;
+		}
+		break;
+		default:
+			heat_conductivity = HeatConductivity(MaterialState(primary_variable));
+			break;
+	}
+
+	return heat_conductivity;
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Heat conductivity at the state (p, T, C) without changing the
+         object. Same models as HeatConductivity(double* variables).
+**************************************************************************/
+double CFluidProperties::HeatConductivity(const MaterialState& state) const
+{
+	const double* variables = state.primary_variable;
+	double conductivity = heat_conductivity;
+
 	switch (heat_conductivity_model)
 	{
 		case 0: // rho = f(x)
 		{
 			int fct_number = 0;
 			int gueltig;
-			heat_conductivity = GetCurveValue(fct_number, 0, primary_variable[0], &gueltig);
+			conductivity = GetCurveValue(fct_number, 0, variables[0], &gueltig);
 		}
 		break;
 		case 1: // c = const
 			break;
 		case 2:
-			heat_conductivity
-			    = MATCalcHeatConductivityMethod2(primary_variable[0], primary_variable[1], primary_variable[2]);
-			break;
-		case 3: // NB
-			heat_conductivity = Fluid_Heat_Conductivity(Density(), primary_variable[1], fluid_id);
-			// if (heat_conductivity<0.03) // not sure about this
+			conductivity = MATCalcHeatConductivityMethod2(variables[0], variables[1], variables[2]);
 			break;
 		case 9:
-			heat_conductivity = Fluid_Heat_Conductivity(Density(primary_variable), primary_variable[1], fluid_id);
+			conductivity = Fluid_Heat_Conductivity(Density(state), variables[1], fluid_id);
 			break;
-
 		case 11: // Wassilijewa, Maso&Saxena (see Poling, B. E.; Prausnitz, J. M.; John Paul, O. & Reid, R. C. The
 			// properties of gases and liquids McGraw-Hill New York, 2001, 5: page 10.30f.)
 			{
 				double x[2], k[2];
 				const double M0 = cp_vec[0]->molar_mass;
 				const double M1 = cp_vec[1]->molar_mass;
-				const double p = primary_variable[0];
-				const double T = primary_variable[1];
-				const double X = primary_variable[2];
+				const double p = variables[0];
+				const double T = variables[1];
+				const double X = variables[2];
 
 				// TODO [CL] max() is redundant if the fraction is guaranteed to be between 0 and 1.
 				// reactive component
@@ -2308,34 +2427,173 @@ double CFluidProperties::HeatConductivity(double* variables)
 				                      / pow(8.0 * (1.0 + M1_over_M2), 0.5);
 				const double phi_21 = phi_12 * M1_over_M2 / V1_over_V2;
 
-				heat_conductivity = k[0] * x[0] / (x[0] + x[1] * phi_12);
-				heat_conductivity += k[1] * x[1] / (x[1] + x[0] * phi_21);
+				conductivity = k[0] * x[0] / (x[0] + x[1] * phi_12);
+				conductivity += k[1] * x[1] / (x[1] + x[0] * phi_21);
 				break;
 			}
-		case 15: // mixture k_m= sum_i y_i*k_i:: p, T, x
+		case 3:
+		case 15:
+			std::cout << "Error in CFluidProperties::HeatConductivity: model " << heat_conductivity_model
+			          << " is not available for the evaluation at a MaterialState"
+			          << "\n";
+			break;
+	}
+
+	return conductivity;
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: True if all property models of the fluid can be evaluated with the
+         const functions taking a MaterialState, i.e. concurrently.
+**************************************************************************/
+bool CFluidProperties::isReentrant() const
+{
+	if (density_model == 15 || density_model == 18 || density_model == 19)
+		return false;
+	if (viscosity_model == 15 || viscosity_model == 18)
+		return false;
+	if (heat_capacity_model == 11 || heat_capacity_model == 15)
+		return false;
+	if (heat_conductivity_model == 3 || heat_conductivity_model == 15)
+		return false;
+	return true;
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Density at n states, e.g. at all Gauss points of an element. The
+         model is selected once for all states, so that the loops of the
+         analytical models can be vectorised. C may be NULL if the model
+         does not depend on the concentration.
+**************************************************************************/
+void CFluidProperties::Density(const double* p, const double* T, const double* C, const int n, double* density) const
+{
+	const double rho0 = rho_0;
+	switch (density_model)
+	{
+		case 1: // rho = const
+			for (int i = 0; i < n; i++)
+				density[i] = rho0;
+			return;
+		case 2: // rho(p) = rho_0*(1+beta_p*(p-p_0))
 		{
-			CRFProcess* m_pcs = PCSGet("MULTI_COMPONENTIAL_FLOW");
-			double Kappa = 0.0;
+			const double beta_p = drho_dp, p0 = p_0;
+			for (int i = 0; i < n; i++)
+				density[i] = rho0 * (1. + beta_p * (max(p[i], 0.0) - p0));
+			return;
+		}
+		case 3: // rho(C) = rho_0*(1+beta_C*(C-C_0))
+		{
+			if (!C)
+				break;
+			const double beta_C = drho_dC, C0 = C_0;
+			for (int i = 0; i < n; i++)
+				density[i] = rho0 * (1. + beta_C * (max(C[i], 0.0) - C0));
+			return;
+		}
+		case 4: // rho(T) = rho_0*(1+beta_T*(T-T_0))
+		{
+			const double beta_T = drho_dT, T0 = T_0;
+			for (int i = 0; i < n; i++)
+				density[i] = rho0 * (1. + beta_T * (max(T[i], 0.0) - T0));
+			return;
+		}
+		case 5: // rho(C,T) = rho_0*(1+beta_C*(C-C_0)+beta_T*(T-T_0))
+		{
+			if (!C)
+				break;
+			const double beta_C = drho_dC, C0 = C_0, beta_T = drho_dT, T0 = T_0;
+			for (int i = 0; i < n; i++)
+				density[i] = rho0 * (1. + beta_C * (max(C[i], 0.0) - C0) + beta_T * (max(T[i], 0.0) - T0));
+			return;
+		}
+		case 6: // rho(p,T) = rho_0*(1+beta_p*(p-p_0)+beta_T*(T-T_0))
+		{
+			const double beta_p = drho_dp, p0 = p_0, beta_T = drho_dT, T0 = T_0;
+			for (int i = 0; i < n; i++)
+				density[i] = rho0 * (1. + beta_p * (max(p[i], 0.0) - p0) + beta_T * (max(T[i], 0.0) - T0));
+			return;
+		}
+		case 7: // Pefect gas. WW
+		{
+			const double M = molar_mass;
+			for (int i = 0; i < n; i++)
+				density[i] = p[i] * M / (PhysicalConstant::IdealGasConstant * T[i]);
+			return;
+		}
+		case 14: // #Exponential law#, the temperature term uses C as the scalar model
+		{
+			if (!C)
+				break;
+			const double beta_p = drho_dp, p0 = p_0, beta_T = drho_dT, beta_C = drho_dC;
+			for (int i = 0; i < n; i++)
+				density[i] = rho0 * exp(beta_p * (max(p[i], 0.0) - p0) + beta_T * (max(C[i], 0.0))
+				                        + beta_C * max(C[i], 0.0));
+			return;
+		}
+		default:
+			break;
+	}
 
-			for (int CIndex = 2; CIndex < cmpN + 2; CIndex++)
+	MaterialState state;
+	for (int i = 0; i < n; i++)
+	{
+		state.primary_variable[0] = p[i];
+		state.primary_variable[1] = T[i];
+		state.primary_variable[2] = C ? C[i] : 0.0;
+		density[i] = Density(state);
+	}
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Viscosity at n states, see the batched Density.
+**************************************************************************/
+void CFluidProperties::Viscosity(const double* p, const double* T, const double* C, const int n,
+                                 double* viscosity) const
+{
+	const double my0 = my_0;
+	switch (viscosity_model)
+	{
+		case 1: // my = const
+			for (int i = 0; i < n; i++)
+				viscosity[i] = my0;
+			return;
+		case 2: // my(p) = my_0*(1+gamma_p*(p-p_0))
+		{
+			const double gamma_p = dmy_dp, p0 = p_0;
+			for (int i = 0; i < n; i++)
+				viscosity[i] = my0 * (1. + gamma_p * (max(p[i], 0.0) - p0));
+			return;
+		}
+		case 3: // my^l(T), Yaws et al. (1976)
+			if (!T_Process)
 			{
-				if (eos_name == "CONSTANT")
-				{
-					Kappa += variables[CIndex] * kappa[CIndex - 2];
-				}
-				else
-				{
-					therm_prop(m_pcs->pcs_primary_function_name[CIndex]);
-					Kappa += variables[CIndex]
-					         * Fluid_Heat_Conductivity(ComponentDensity(CIndex, variables), variables[1], fluid_id);
-				}
+				const double my = LiquidViscosity_Yaws_1976(T_0 + viscosity_T_shift);
+				for (int i = 0; i < n; i++)
+					viscosity[i] = my;
 			}
-			heat_conductivity = Kappa;
-		}
-		break;
+			else
+				for (int i = 0; i < n; i++)
+					viscosity[i] = LiquidViscosity_Yaws_1976(T[i] + viscosity_T_shift);
+			return;
+		case 4: // my^g(T), Marsily (1986)
+			for (int i = 0; i < n; i++)
+				viscosity[i] = LiquidViscosity_Marsily_1986(T[i]);
+			return;
+		default:
+			break;
 	}
 
-	return heat_conductivity;
+	MaterialState state;
+	for (int i = 0; i < n; i++)
+	{
+		state.primary_variable[0] = p[i];
+		state.primary_variable[1] = T[i];
+		state.primary_variable[2] = C ? C[i] : 0.0;
+		viscosity[i] = Viscosity(state);
+	}
 }
 
 /**************************************************************************
@@ -2733,7 +2991,7 @@ double CFluidProperties::DensityTemperatureDependence(long number, int comp, dou
 }
 #endif // if define obsolete. WW
 
-double CFluidProperties::LiquidViscosity_expo(double T)
+double CFluidProperties::LiquidViscosity_expo(double T) const
 {
 	return viscosity0 * exp(-(T - T_0) / viscosity_T_star);
 }
@@ -2746,7 +3004,7 @@ double CFluidProperties::LiquidViscosity_expo(double T)
 
    last modification:
 **************************************************************************/
-double CFluidProperties::LiquidViscosity_CMCD(double Press, double TempK, double C)
+double CFluidProperties::LiquidViscosity_CMCD(double Press, double TempK, double C) const
 {
 	C = C;
 	/*CMcD variables for 20 ALR*/
@@ -2808,10 +3066,9 @@ double CFluidProperties::LiquidViscosity_CMCD(double Press, double TempK, double
 	my_Zero = 243.18e-7 * (pow(10., (247.8 / (TempK - 140)))) * (1 + (Pbar - PsatBar) * 1.0467e-6 * (TempK - 305));
 
 	/*Viscosity of saline water in Pa-S*/
-	viscosity = my_Zero * (1 - 0.00187 * (sqrt(Salinity)) + 0.000218 * (MathLib::fastpow(sqrt(Salinity), 5))
-	                       + (sqrt(TempF) - 0.0135 * TempF)
-	                             * (0.00276 * Salinity - 0.000344 * (MathLib::fastpow(sqrt(Salinity), 3))));
-	return viscosity;
+	return my_Zero * (1 - 0.00187 * (sqrt(Salinity)) + 0.000218 * (MathLib::fastpow(sqrt(Salinity), 5))
+	                  + (sqrt(TempF) - 0.0135 * TempF)
+	                        * (0.00276 * Salinity - 0.000344 * (MathLib::fastpow(sqrt(Salinity), 3))));
 }
 
 /**************************************************************************/
@@ -2831,7 +3088,7 @@ double CFluidProperties::LiquidViscosity_CMCD(double Press, double TempK, double
    08/2004   CMCD inclusion in GeoSys v. 4.
  */
 /**************************************************************************/
-double CFluidProperties::MATCalcHeatConductivityMethod2(double Press, double TempK, double Conc)
+double CFluidProperties::MATCalcHeatConductivityMethod2(double Press, double TempK, double Conc) const
 {
 	Conc = Conc;
 	int i, j;
@@ -3203,7 +3460,7 @@ double CFluidProperties::vaporDensity_derivative(const double T_abs)
 
  */
 /**************************************************************************/
-double CFluidProperties::MATCalcFluidHeatCapacityMethod2(double Press, double TempK, double Conc)
+double CFluidProperties::MATCalcFluidHeatCapacityMethod2(double Press, double TempK, double Conc) const
 {
 	Conc = Conc;
 	double Pressurevar, Tau, pressure_average, temperature_average, Tstar, Pstar, GazConst;
@@ -3596,7 +3853,7 @@ double CFluidProperties::drhodP(double* variables)
 	const double p = variables[0];
 	const double T = variables[1];
 
-	double arguments[2];
+	double arguments[3] = {0.0, 0.0, variables[2]};
 	double rho1, rho2, drhodP = 0.0;
 
 	if (p < 0)
@@ -3719,7 +3976,7 @@ double CFluidProperties::drhodT(double* variables)
 	R = 1000.0 * PhysicalConstant::IdealGasConstant;
 	alpha_m = 0.0;
 	v_m = 0.0;
-	double arguments[2];
+	double arguments[3] = {0.0, 0.0, variables[2]};
 	double rho1, rho2, drhodT = 0.0;
 
 	if (!drho_dT_unsaturated) // fluid expansion (drho/dT) for unsaturated case activated?
@@ -21,6 +21,8 @@
 #include <string>
 #include <vector>
 
+#include "MaterialState.h"
+
 class CompProperties;
 class CRFProcess;
 
@@ -100,6 +102,19 @@ public:
 	double HeatConductivity(double* variables = NULL);
 	double CalcEnthalpy(double temperature);
 
+	// Re-entrant evaluation at the state (p, T, C), see MaterialState.h
+	double Density(const MaterialState& state) const;
+	double Viscosity(const MaterialState& state) const;
+	double SpecificHeatCapacity(const MaterialState& state) const;
+	double HeatConductivity(const MaterialState& state) const;
+	/// False if a selected model reads the element of Fem_Ele_Std or switches
+	/// the fluid parameters (therm_prop). Such models are only evaluated by
+	/// the functions with a double* argument.
+	bool isReentrant() const;
+	// Evaluation at n states with the model selected once, C may be NULL
+	void Density(const double* p, const double* T, const double* C, const int n, double* density) const;
+	void Viscosity(const double* p, const double* T, const double* C, const int n, double* viscosity) const;
+
 	double vaporDensity(const double T); // WW
 	// WW
 	double vaporDensity_derivative(const double T);
@@ -260,17 +275,19 @@ private:
 	double primary_variable_t1[10]; // CMCD
 	bool cal_gravity; // YD/WW
 
-	double GasViscosity_Reichenberg_1971(double, double);
+	double GasViscosity_Reichenberg_1971(double, double) const;
 	// AKS
-	double MATCalcFluidDensityMethod8(double p, double T, double C);
-	double LiquidViscosity_Yaws_1976(double);
-	double LiquidViscosity_Marsily_1986(double);
-	double LiquidViscosity_NN(double, double);
-	double LiquidViscosity_CMCD(double p, double T, double C);
-	double LiquidViscosity_expo(double T);
+	double MATCalcFluidDensityMethod8(double p, double T, double C) const;
+	double LiquidViscosity_Yaws_1976(double) const;
+	double LiquidViscosity_Marsily_1986(double) const;
+	double LiquidViscosity_NN(double, double) const;
+	double LiquidViscosity_CMCD(double p, double T, double C) const;
+	double LiquidViscosity_expo(double T) const;
 	double PhaseDiffusion_Yaws_1976(double);
-	double MATCalcHeatConductivityMethod2(double p, double T, double C);
-	double MATCalcFluidHeatCapacityMethod2(double p, double T, double C);
+	double MATCalcHeatConductivityMethod2(double p, double T, double C) const;
+	double MATCalcFluidHeatCapacityMethod2(double p, double T, double C) const;
+	/// Temperature argument of the density models 10 to 13
+	double densityTemperature(double T) const;
 
 	friend class FiniteElement::CFiniteElementStd;
 	friend class Problem;
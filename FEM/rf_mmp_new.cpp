@@ -47,6 +47,13 @@ extern double gravity_constant;
 
 #include "PhysicalConstant.h"
 
+// GEOLib
+#include "KDTree.h"
+#include "Point.h"
+
+// FileIO
+#include "BinaryFieldIO.h"
+
 // MAT-MP data base lists
 list<string> keywd_list;
 list<string> mat_name_list;
@@ -63,6 +70,19 @@ using FiniteElement::ElementValue;
 using FiniteElement::CFiniteElementStd;
 using FiniteElement::ElementValue_DM;
 
+namespace
+{
+/// MRange for the loops of the batched material functions
+inline double clamp(const double a, const double b, const double c)
+{
+	if (b < a)
+		return a;
+	if (b > c)
+		return c;
+	return b;
+}
+}
+
 /**************************************************************************
    FEMLib-Method: CMediumProperties
    Task: constructor
@@ -2317,7 +2337,7 @@ double CMediumProperties::GetEffectiveSaturationForPerm(const double wetting_sat
    03/2007 WW Brooks/Corey:
    03/2012 JT All new
 **************************************************************************/
-double CMediumProperties::PermeabilitySaturationFunction(const double wetting_saturation, int phase)
+double CMediumProperties::PermeabilitySaturationFunction(const double wetting_saturation, int phase) const
 {
 	double kr = 0.0, sl, se, slr, slm, m, b;
 	int model, gueltig;
@@ -2519,6 +2539,80 @@ double CMediumProperties::PermeabilitySaturationFunction(const double wetting_sa
 	return kr;
 }
 
+/**************************************************************************
+   FEMLib-Method:
+   Task: Relative permeability at n saturations, e.g. at all Gauss points of
+         an element. The model is selected once, so that the loops of the
+         van Genuchten, Brooks-Corey and power law models can be vectorised.
+         Same results as PermeabilitySaturationFunction(double, int).
+**************************************************************************/
+void CMediumProperties::PermeabilitySaturationFunction(const double* wetting_saturation, const int n, int phase,
+                                                       double* kr) const
+{
+	int model = permeability_saturation_model[phase];
+	const int given_phase = phase;
+	bool phase_shift = false;
+	if (model == 2)
+	{ // krg = 1.0 - krl : get paramters for liquid phase calculation
+		phase_shift = true;
+		phase = 0;
+		model = permeability_saturation_model[phase];
+	}
+
+	const double kr_min = minimum_relative_permeability;
+	const double slr = residual_saturation[phase];
+	const double slm = maximum_saturation[phase];
+	const double m = saturation_exponent[phase];
+	switch (model)
+	{
+		case 1: // CONSTANT VALUE
+		{
+			const double b = perm_saturation_value[phase];
+			for (int i = 0; i < n; i++)
+				kr[i] = b;
+			break;
+		}
+		case 3: // FUNCTION: LINEAR OR POWER --> WETTING: krw = (b*Se)^m
+		{
+			const double b = perm_saturation_value[phase];
+			for (int i = 0; i < n; i++)
+			{
+				const double se = (clamp(slr, wetting_saturation[i], slm) - slr) / (slm - slr);
+				kr[i] = max(pow((b * se), m), kr_min);
+			}
+			break;
+		}
+		case 4: // 2-phase VAN GENUCHTEN/MUALEM --> WETTING
+		{
+			const double inv_m = 1.0 / m;
+			for (int i = 0; i < n; i++)
+			{
+				const double se = (clamp(slr, wetting_saturation[i], slm) - slr) / (slm - slr);
+				kr[i] = max(sqrt(se) * pow(1.0 - pow(1.0 - pow(se, inv_m), m), 2), kr_min);
+			}
+			break;
+		}
+		case 6: // 2-phase BROOKS/COREY --> WETTING
+		{
+			const double exponent = 3.0 + 2.0 / m;
+			for (int i = 0; i < n; i++)
+			{
+				const double se = (clamp(slr, wetting_saturation[i], slm) - slr) / (slm - slr);
+				kr[i] = max(pow(se, exponent), kr_min);
+			}
+			break;
+		}
+		default:
+			for (int i = 0; i < n; i++)
+				kr[i] = PermeabilitySaturationFunction(wetting_saturation[i], given_phase);
+			return;
+	}
+
+	if (phase_shift) // krg = 1.0 - krl : revert to gaseous phase
+		for (int i = 0; i < n; i++)
+			kr[i] = max(1.0 - kr[i], kr_min);
+}
+
 /**************************************************************************
    FEMLib-Method:
    Task: Calculate heat capacity of porous medium
@@ -3946,20 +4040,17 @@ double CMediumProperties::Porosity(long number, double theta)
 // WW
 double CMediumProperties::Porosity(CElement* assem)
 {
-	static int nidx0, nidx1, idx_n;
+	int nidx0, nidx1;
 	double primary_variable[PCS_NUMBER_MAX];
-	int gueltig;
 	double porosity_sw, theta;
 	std::string str;
 	///
-	ElementValue_DM* gval = NULL;
 	CFiniteElementStd* assem_tmp = m_pcs->GetAssember(); // WX: for poro vol strain. 03.2011
 
 	//----------------------------------------------------------------------
 	// Functional dependencies
 	number = assem->GetElementIndex();
 	CRFProcess* pcs_temp;
-	CRFProcess* m_pcs_flow;
 
 	const size_t no_pcs_names(porosity_pcs_name_vector.size());
 	for (size_t i = 0; i < no_pcs_names; i++)
@@ -3989,11 +4080,16 @@ double CMediumProperties::Porosity(CElement* assem)
 	switch (porosity_model)
 	{
 		case 0: // n = f(x)
-			porosity = GetCurveValue(fct_number, 0, primary_variable[0], &gueltig);
-			break;
 		case 1: // n = const
-			porosity = porosity_model_values[0];
+		case 7: // n = f(mean stress) WW
+		case 11: // n = const, but spatially distributed CB
+		{
+			MaterialState state(primary_variable, static_cast<int>(no_pcs_names));
+			state.element = number;
+			state.gauss_point = assem->GetGPindex();
+			porosity = Porosity(state);
 			break;
+		}
 		case 2: // n = f(sigma_eff), Stress dependance
 			porosity = PorosityEffectiveStress(number, primary_variable[0]);
 			break;
@@ -4012,26 +4108,20 @@ double CMediumProperties::Porosity(CElement* assem)
 			porosity
 			    = PorosityEffectiveConstrainedSwelling(number, primary_variable[0], primary_variable[1], &porosity_sw);
 			break;
-		case 7: // n = f(mean stress) WW
-			gval = ele_value_dm[number];
-			primary_variable[0] = -gval->MeanStress(assem->GetGPindex()) / 3.0;
-			porosity = GetCurveValue(porosity_curve, 0, primary_variable[0], &gueltig);
-			break;
 		case 10:
 			/* porosity change through dissolution/precipitation */
 			porosity = PorosityVolumetricChemicalReaction(number);
 			break;
-		case 11: // n = const, but spatially distributed CB
-			porosity = porosity_model_values[0];
-			break;
 		case 12: // n = n0 + vol_strain
 			porosity = PorosityVolStrain(number, porosity_model_values[0], assem_tmp); // WX:03.2011
 			break;
 		case 13:
-			m_pcs_flow = PCSGetFlow();
-			idx_n = m_pcs_flow->GetElementValueIndex("POROSITY");
+		{
+			CRFProcess* m_pcs_flow = PCSGetFlow();
+			const int idx_n = m_pcs_flow->GetElementValueIndex("POROSITY");
 			porosity = m_pcs_flow->GetElementValue(number, idx_n + 1);
 			break;
+		}
 #ifdef GEM_REACT
 		case 15:
 
@@ -4070,6 +4160,68 @@ double CMediumProperties::Porosity(CElement* assem)
 	return porosity;
 }
 
+/**************************************************************************
+   FEMLib-Method:
+   Task: Porosity at the given state without changing the object, for the
+         models which do not depend on the assembler or on a process. The
+         primary variables are the values of porosity_pcs_name_vector, the
+         element and Gauss point ids are needed by model 7.
+**************************************************************************/
+double CMediumProperties::Porosity(const MaterialState& state) const
+{
+	int gueltig;
+	double n = porosity;
+
+	switch (porosity_model)
+	{
+		case 0: // n = f(x)
+			n = GetCurveValue(fct_number, 0, state.primary_variable[0], &gueltig);
+			break;
+		case 1: // n = const
+		case 11: // n = const, but spatially distributed CB
+			n = porosity_model_values[0];
+			break;
+		case 7: // n = f(mean stress) WW
+		{
+			const double mean_stress = -ele_value_dm[state.element]->MeanStress(state.gauss_point) / 3.0;
+			n = GetCurveValue(porosity_curve, 0, mean_stress, &gueltig);
+			break;
+		}
+		default:
+			std::cout << "Error in CMediumProperties::Porosity: model " << porosity_model
+			          << " is not available for the evaluation at a MaterialState"
+			          << "\n";
+			break;
+	}
+	return n;
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: True if the porosity model can be evaluated with Porosity(const
+         MaterialState&) and the const capillary pressure and relative
+         permeability functions do not use other objects, i.e. if they can
+         be called concurrently. The entry pressure conversion reads the
+         density of the first fluid at its current state.
+**************************************************************************/
+bool CMediumProperties::isReentrant() const
+{
+	switch (porosity_model)
+	{
+		case -1: // not given
+		case 0:
+		case 1:
+		case 7:
+		case 11:
+			break;
+		default:
+			return false;
+	}
+	if (entry_pressure_conversion)
+		return false;
+	return true;
+}
+
 /**************************************************************************
    FEMLib-Method:
    Task:
@@ -4787,7 +4939,7 @@ double CMediumProperties::PermeabilityFunctionEffStress(long index, int nnodes,
    03/2012 JT All new
    last modification:
 **************************************************************************/
-double CMediumProperties::CapillaryPressureFunction(const double wetting_saturation)
+double CMediumProperties::CapillaryPressureFunction(const double wetting_saturation) const
 {
 	double pc, pb, sl, slr, slm, se, m;
 	int gueltig;
@@ -4857,7 +5009,7 @@ double CMediumProperties::CapillaryPressureFunction(const double wetting_saturat
    03/2012 JT All new.
    Last modified:
 **************************************************************************/
-double CMediumProperties::SaturationCapillaryPressureFunction(const double capillary_pressure)
+double CMediumProperties::SaturationCapillaryPressureFunction(const double capillary_pressure) const
 {
 	double se, sl, slr, slm, m, pb, pc;
 	int gueltig;
@@ -4934,6 +5086,53 @@ double CMediumProperties::SaturationCapillaryPressureFunction(const double capil
 	return sl;
 }
 
+/**************************************************************************
+   FEMLib-Method:
+   Task: Saturation at n capillary pressures, see the batched
+         PermeabilitySaturationFunction.
+**************************************************************************/
+void CMediumProperties::SaturationCapillaryPressureFunction(const double* capillary_pressure, const int n,
+                                                            double* saturation) const
+{
+	const double pb = capillary_pressure_values[0];
+	const double slr = capillary_pressure_values[1];
+	const double slm = capillary_pressure_values[2];
+	const double m = capillary_pressure_values[3];
+	switch (capillary_pressure_model)
+	{
+		case 2: // Constant saturation for pp models (for WX, from JT)
+			for (int i = 0; i < n; i++)
+				saturation[i] = pb;
+			return;
+		case 4: // van Genuchten
+			if (entry_pressure_conversion) // needs the fluid density
+				break;
+			{
+				const double exponent = 1.0 / (1.0 - m);
+				for (int i = 0; i < n; i++)
+				{
+					const double pc = max(capillary_pressure[i], 0.0);
+					const double se = pow(pow(pc / pb, exponent) + 1.0, -m);
+					saturation[i] = clamp(slr + DBL_EPSILON, se * (slm - slr) + slr, slm - DBL_EPSILON);
+				}
+			}
+			return;
+		case 6: //  Brook & Corey
+			for (int i = 0; i < n; i++)
+			{
+				const double pc = max(capillary_pressure[i], pb);
+				const double se = pow(pc / pb, -m);
+				saturation[i] = clamp(slr + DBL_EPSILON, se * (slm - slr) + slr, slm - DBL_EPSILON);
+			}
+			return;
+		default:
+			break;
+	}
+
+	for (int i = 0; i < n; i++)
+		saturation[i] = SaturationCapillaryPressureFunction(capillary_pressure[i]);
+}
+
 /**************************************************************************
    FEMLib-Method:
    Task: returns dSw/dPc
@@ -5306,10 +5505,137 @@ void CMediumProperties::SetConstantELEarea(double area, int group)
 		}
 }
 
+namespace
+{
+/**************************************************************************
+   Task: Search structures over the scattered samples of a distributed
+         medium property. The kd-trees are built once per data set and
+         shared (read only) by the queries of all elements.
+**************************************************************************/
+class HetValueSearch
+{
+public:
+	HetValueSearch(const vector<double>& xvals,
+	               const vector<double>& yvals,
+	               const vector<double>& zvals,
+	               const vector<double>& mmpvals,
+	               bool with_xy_projection)
+	    : _xvals(xvals), _yvals(yvals), _zvals(zvals), _mmpvals(mmpvals), _tree(NULL), _xy_tree(NULL)
+	{
+		vector<GEOLIB::Point*> pnts(xvals.size());
+		for (size_t i = 0; i < pnts.size(); i++)
+			pnts[i] = new GEOLIB::Point(xvals[i], yvals[i], zvals[i]);
+		_tree = new GEOLIB::KDTree<GEOLIB::Point>(pnts);
+		if (with_xy_projection)
+		{
+			for (size_t i = 0; i < pnts.size(); i++)
+				(*pnts[i])[2] = 0.0;
+			_xy_tree = new GEOLIB::KDTree<GEOLIB::Point>(pnts);
+		}
+		for (size_t i = 0; i < pnts.size(); i++)
+			delete pnts[i];
+	}
+	~HetValueSearch()
+	{
+		delete _tree;
+		delete _xy_tree;
+	}
+
+	/// Value of the sample nearest to the element center, see GetNearestHetVal2
+	double nearest(MeshLib::CElem* ele) const { return _mmpvals[_tree->getNearestPoint(ele->GetGravityCenter())]; }
+
+	/// Mean of the samples within the triangle of the first three element
+	/// nodes (xy projection), see GetAverageHetVal2
+	double triangleAverage(MeshLib::CElem* ele) const
+	{
+		double xp[3], yp[3];
+		double min_pnt[3] = {0.0, 0.0, 0.0}, max_pnt[3] = {0.0, 0.0, 0.0};
+		for (int j = 0; j < 3; j++)
+		{
+			double const* const pnt(ele->GetNode(j)->getData());
+			xp[j] = pnt[0];
+			yp[j] = pnt[1];
+			if (j == 0 || xp[j] < min_pnt[0])
+				min_pnt[0] = xp[j];
+			if (j == 0 || xp[j] > max_pnt[0])
+				max_pnt[0] = xp[j];
+			if (j == 0 || yp[j] < min_pnt[1])
+				min_pnt[1] = yp[j];
+			if (j == 0 || yp[j] > max_pnt[1])
+				max_pnt[1] = yp[j];
+		}
+		// IsInTriangleXYProjection accepts points slightly outside of the triangle
+		const double tol = 1e-3 * max(max_pnt[0] - min_pnt[0], max_pnt[1] - min_pnt[1]);
+		for (int k = 0; k < 2; k++)
+		{
+			min_pnt[k] -= tol;
+			max_pnt[k] += tol;
+		}
+		vector<size_t> ids;
+		_xy_tree->getPointsInBox(min_pnt, max_pnt, ids);
+
+		double value = 0.0;
+		long n_values = 0;
+		CGLPoint point(0.0, 0.0, 0.0);
+		for (size_t i = 0; i < ids.size(); i++)
+		{
+			if (_mmpvals[ids[i]] == -999999.0)
+				continue;
+			point.x = _xvals[ids[i]];
+			point.y = _yvals[ids[i]];
+			if (point.IsInTriangleXYProjection(xp, yp))
+			{
+				value += _zvals[ids[i]];
+				n_values++;
+			}
+		}
+		if (n_values == 0)
+			return nearest(ele);
+		return value / n_values;
+	}
+
+	/// Mean of the k samples nearest to the element center
+	double kNearestAverage(MeshLib::CElem* ele, size_t k) const
+	{
+		vector<size_t> ids;
+		_tree->getKNearestPoints(ele->GetGravityCenter(), k, ids);
+		return average(ids);
+	}
+
+	/// Mean of the samples within the given distance of the element center,
+	/// the nearest sample if there is none
+	double radiusAverage(MeshLib::CElem* ele, double radius) const
+	{
+		vector<size_t> ids;
+		_tree->getPointsInSphere(ele->GetGravityCenter(), radius, ids);
+		if (ids.empty())
+			return nearest(ele);
+		return average(ids);
+	}
+
+private:
+	double average(const vector<size_t>& ids) const
+	{
+		double value = 0.0;
+		for (size_t i = 0; i < ids.size(); i++)
+			value += _mmpvals[ids[i]];
+		return value / ids.size();
+	}
+
+	const vector<double>& _xvals;
+	const vector<double>& _yvals;
+	const vector<double>& _zvals;
+	const vector<double>& _mmpvals;
+	GEOLIB::KDTree<GEOLIB::Point>* _tree;
+	GEOLIB::KDTree<GEOLIB::Point>* _xy_tree;
+};
+}
+
 /**************************************************************************
    PCSLib-Method:
    Programing:
    11/2005 OK Implementation
+   kd-tree search of the samples, K_NEAREST and RADIUS_AVERAGE
 **************************************************************************/
 void CMediumProperties::SetDistributedELEProperties(string file_name)
 {
@@ -5319,7 +5645,7 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
 	string mmp_property_mesh;
 	MeshLib::CElem* m_ele_geo = NULL;
 	bool element_area = false;
-	long i, j, ihet;
+	long i, j;
 	double mmp_property_value;
 	int mat_vector_size = 0; // Init WW
 	double ddummy, conversion_factor = 1.0; // init WW
@@ -5327,6 +5653,8 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
 	vector<double> temp_store;
 	int c_vals;
 	double x, y, z, mmpv;
+	size_t n_neighbours = 1;
+	double search_radius = 0.0;
 	std::stringstream in;
 	// CB
 	vector<double> garage;
@@ -5338,6 +5666,13 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
 
 	cout << " SetDistributedELEProperties: ";
 	//----------------------------------------------------------------------
+	// Binary field file: one value per element, name taken from the header
+	if (FileIO::BinaryFieldIO::isBinaryFieldFile(file_name))
+	{
+		SetDistributedELEPropertiesBinary(file_name);
+		return;
+	}
+	//----------------------------------------------------------------------
 	// File handling
 	ifstream mmp_property_file(file_name.data(), ios::in);
 	if (!mmp_property_file.good())
@@ -5397,6 +5732,10 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
 		if (line_string.find("$DIS_TYPE") != string::npos)
 		{
 			mmp_property_file >> mmp_property_dis_type;
+			if (mmp_property_dis_type[0] == 'K') // K_NEAREST k
+				mmp_property_file >> n_neighbours;
+			if (mmp_property_dis_type[0] == 'R') // RADIUS_AVERAGE r
+				mmp_property_file >> search_radius;
 			continue;
 		}
 		//....................................................................
@@ -5412,6 +5751,9 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
 			{
 				case 'N': // Next neighbour
 				case 'G': // Geometric mean
+				case 'K': // Mean of the k nearest samples
+				case 'R': // Mean of the samples within a radius
+				{
 					// Read in all values given, store in vectors for x, y, z and value
 					i = 0;
 					while (i == 0)
@@ -5428,8 +5770,34 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
 						zvals.push_back(z);
 						mmpvals.push_back(mmpv);
 					}
+					if (xvals.empty())
+					{
+						cout << "Error in CMediumProperties::SetDistributedELEProperties - no data points"
+						     << "\n";
+						return;
+					}
+					// Map the samples to the elements
+					const char dis_type = mmp_property_dis_type[0];
+					const HetValueSearch search(xvals, yvals, zvals, mmpvals, dis_type == 'G');
+					const long n_elements = (long)_mesh->ele_vector.size();
+					vector<double> ele_values(n_elements);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+					for (long e = 0; e < n_elements; e++)
+					{
+						MeshLib::CElem* ele = _mesh->ele_vector[e];
+						if (dis_type == 'N')
+							ele_values[e] = search.nearest(ele);
+						else if (dis_type == 'G')
+							ele_values[e] = search.triangleAverage(ele);
+						else if (dis_type == 'K')
+							ele_values[e] = search.kNearestAverage(ele, n_neighbours);
+						else
+							ele_values[e] = search.radiusAverage(ele, search_radius);
+					}
 					// sort values to mesh
-					for (i = 0; i < (long)_mesh->ele_vector.size(); i++)
+					for (i = 0; i < n_elements; i++)
 					{
 						m_ele_geo = _mesh->ele_vector[i];
 						mat_vector_size = m_ele_geo->mat_vector.Size();
@@ -5441,20 +5809,10 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
 						for (j = 0; j < mat_vector_size; j++)
 							m_ele_geo->mat_vector(j) = garage[j];
 						garage.clear();
-						if (mmp_property_dis_type[0] == 'N')
-						{
-							// Search for all elements of the mesh, which is the nearest given value in the input file
-							// Return value ihet is the index of the het. val in the mmpval-vector
-							ihet = GetNearestHetVal2(i, _mesh, xvals, yvals, zvals, mmpvals);
-							m_ele_geo->mat_vector(mat_vector_size) = mmpvals[ihet];
-						}
-						if (mmp_property_dis_type[0] == 'G')
-						{
-							mmpv = GetAverageHetVal2(i, _mesh, xvals, yvals, zvals, mmpvals);
-							m_ele_geo->mat_vector(mat_vector_size) = mmpv;
-						}
+						m_ele_geo->mat_vector(mat_vector_size) = ele_values[i];
 					}
 					break;
+				}
 				case 'E': // Element data
 					for (i = 0; i < (long)_mesh->ele_vector.size(); i++)
 					{
@@ -5589,6 +5947,78 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
 	}
 }
 
+/**************************************************************************
+   FEMLib-Method:
+   Task: Set heterogeneous element properties from a binary field file
+         (see FileIO::BinaryFieldIO). The field has to hold one value for
+         every element of the mesh.
+**************************************************************************/
+void CMediumProperties::SetDistributedELEPropertiesBinary(string const& file_name)
+{
+	FileIO::BinaryFieldIO::Association association;
+	string mmp_property_name;
+	vector<uint32_t> ids;
+	vector<double> values;
+	if (!FileIO::BinaryFieldIO::read(file_name, association, mmp_property_name, ids, values))
+		return;
+	cout << mmp_property_name << "\n";
+
+	if (!_mesh && !fem_msh_vector.empty())
+		_mesh = fem_msh_vector[0];
+	if (!_mesh)
+	{
+		cout << "CMediumProperties::SetDistributedELEProperties: no MSH data"
+		     << "\n";
+		return;
+	}
+	const size_t n_elements(_mesh->ele_vector.size());
+	if (association != FileIO::BinaryFieldIO::ELEMENT || values.size() != n_elements)
+	{
+		cout << "Error in CMediumProperties::SetDistributedELEProperties - " << file_name
+		     << " does not hold one value per element"
+		     << "\n";
+		return;
+	}
+
+	vector<double> ele_values;
+	if (ids.empty())
+		ele_values.swap(values);
+	else
+	{
+		ele_values.assign(n_elements, 0.0);
+		for (size_t i = 0; i < n_elements; i++)
+		{
+			if (ids[i] >= n_elements)
+			{
+				cout << "Error in CMediumProperties::SetDistributedELEProperties - element id " << ids[i]
+				     << " out of range"
+				     << "\n";
+				return;
+			}
+			ele_values[ids[i]] = values[i];
+		}
+	}
+
+	_mesh->mat_names_vector.push_back(mmp_property_name);
+	const bool element_area(mmp_property_name == "GEOMETRY_AREA");
+	vector<double> garage;
+	for (size_t i = 0; i < n_elements; i++)
+	{
+		MeshLib::CElem* m_ele_geo = _mesh->ele_vector[i];
+		const int mat_vector_size = m_ele_geo->mat_vector.Size();
+		// Store old values as they are set to zero after resizing
+		for (int j = 0; j < mat_vector_size; j++)
+			garage.push_back(m_ele_geo->mat_vector(j));
+		m_ele_geo->mat_vector.resize(mat_vector_size + 1);
+		for (int j = 0; j < mat_vector_size; j++)
+			m_ele_geo->mat_vector(j) = garage[j];
+		garage.clear();
+		m_ele_geo->mat_vector(mat_vector_size) = ele_values[i];
+		if (element_area)
+			m_ele_geo->SetFluxArea(ele_values[i]);
+	}
+}
+
 /**************************************************************************
    PCSLib-Method:
    Programing:
@@ -5739,10 +6169,10 @@ void CMediumProperties::WriteTecplotDistributedProperties()
 **************************************************************************/
 long GetNearestHetVal2(long EleIndex,
                        CFEMesh* m_msh,
-                       vector<double> xvals,
-                       vector<double> yvals,
-                       vector<double> zvals,
-                       vector<double> mmpvals)
+                       const vector<double>& xvals,
+                       const vector<double>& yvals,
+                       const vector<double>& zvals,
+                       const vector<double>& mmpvals)
 {
 	(void)mmpvals;
 	long i, nextele, no_values;
@@ -5792,10 +6222,10 @@ long GetNearestHetVal2(long EleIndex,
 **************************************************************************/
 double GetAverageHetVal2(long EleIndex,
                          CFEMesh* m_msh,
-                         vector<double> xvals,
-                         vector<double> yvals,
-                         vector<double> zvals,
-                         vector<double> mmpvals)
+                         const vector<double>& xvals,
+                         const vector<double>& yvals,
+                         const vector<double>& zvals,
+                         const vector<double>& mmpvals)
 {
 	long i, j, ihet;
 	double average;
@@ -5843,7 +6273,6 @@ double GetAverageHetVal2(long EleIndex,
 			{
 				value = value + zvals[i];
 				NumberOfValues++;
-				mmpvals[i] = -999999.0; // used as marker
 			}
 		}
 	// end for
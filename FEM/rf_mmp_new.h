@@ -28,6 +28,8 @@
 #include "GeoType.h"
 #include "makros.h" // JT
 
+#include "MaterialState.h"
+
 // PCSLib
 #include "rf_pcs.h"
 
@@ -98,6 +100,9 @@ public:
 	double* PermeabilityTensor(long index);
 	// CMCD 9/2004 GeoSys 4
 	double Porosity(FiniteElement::CElement* assem = NULL);
+	// Re-entrant evaluation for the models 0, 1, 7 and 11, see MaterialState.h
+	double Porosity(const MaterialState& state) const;
+	bool isReentrant() const;
 	// CMCD 9/2004 GeoSys 4
 	double TortuosityFunction(long number, double* gp, double theta, CFiniteElementStd* assem = NULL);
 	// CMCD 9/2004 GeoSys 4
@@ -137,13 +142,16 @@ public:
 	// OK
 	double Density(long number, double* gp, double theta);
 	// Capillary pressure functions
-	double CapillaryPressureFunction(const double wetting_saturation);
+	double CapillaryPressureFunction(const double wetting_saturation) const;
 	double PressureSaturationDependency(double wetting_saturation, bool invert);
 	// JT: No longer used // double SaturationPressureDependency(const double capillary_pressure, bool allow_zero =
 	// false);
-	double SaturationCapillaryPressureFunction(const double capillary_pressure);
+	double SaturationCapillaryPressureFunction(const double capillary_pressure) const;
+	void SaturationCapillaryPressureFunction(const double* capillary_pressure, const int n, double* saturation) const;
 	// WW
-	double PermeabilitySaturationFunction(const double wetting_saturation, int phase);
+	double PermeabilitySaturationFunction(const double wetting_saturation, int phase) const;
+	// Evaluation at n saturations with the model selected once
+	void PermeabilitySaturationFunction(const double* wetting_saturation, const int n, int phase, double* kr) const;
 	double GetEffectiveSaturationForPerm(const double wetting_saturation, int phase); // JT
 	// MX 1/2005
 	double PorosityVolumetricChemicalReaction(long);
@@ -152,6 +160,7 @@ public:
 	void SetConstantELEarea(double area, int group);
 	// OK
 	void SetDistributedELEProperties(std::string);
+	void SetDistributedELEPropertiesBinary(std::string const& file_name);
 
 	void WriteTecplotDistributedProperties(); // OK
 	double HeatTransferCoefficient(long number, double theta, CFiniteElementStd* assem); // NW
@@ -348,24 +357,16 @@ extern void MMP2PCSRelation(CRFProcess*);
 extern void GetHeterogeneousFields(); // SB
 extern long GetNearestHetVal2(long EleIndex,
                               CFEMesh* m_msh,
-                              std::vector<double>
-                                  xvals,
-                              std::vector<double>
-                                  yvals,
-                              std::vector<double>
-                                  zvals,
-                              std::vector<double>
-                                  mmpvals);
+                              const std::vector<double>& xvals,
+                              const std::vector<double>& yvals,
+                              const std::vector<double>& zvals,
+                              const std::vector<double>& mmpvals);
 double GetAverageHetVal2(long EleIndex,
                          CFEMesh* m_msh,
-                         std::vector<double>
-                             xvals,
-                         std::vector<double>
-                             yvals,
-                         std::vector<double>
-                             zvals,
-                         std::vector<double>
-                             mmpvals);
+                         const std::vector<double>& xvals,
+                         const std::vector<double>& yvals,
+                         const std::vector<double>& zvals,
+                         const std::vector<double>& mmpvals);
 extern bool MMPExist(std::ifstream* mmp_file); // OK
 extern bool MMPExist(); // OK
 
@@ -1481,6 +1481,21 @@ double CSolidProperties::Enthalpy(double temperature, const double latent_factor
    08/2004 WW Implementation
 **************************************************************************/
 double CSolidProperties::Heat_Conductivity(double reference)
+{
+	if (Conductivity_mode == 5)
+	{
+		CalPrimaryVariable(capacity_pcs_name_vector);
+		return Heat_Conductivity(reference, MaterialState(primary_variable, 2));
+	}
+	return Heat_Conductivity(reference, MaterialState());
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Heat conductivity at the given state without changing the object.
+         Model 5 reads the temperature and the pressure from the state.
+**************************************************************************/
+double CSolidProperties::Heat_Conductivity(double reference, const MaterialState& state) const
 {
 	double val = 0.0;
 	int gueltig;
@@ -1524,8 +1539,7 @@ double CSolidProperties::Heat_Conductivity(double reference)
 			val = CalulateValue(data_Conductivity, reference);
 			break;
 		case 5: // DECOVALEX2015, TaskB2 JM
-			CalPrimaryVariable(capacity_pcs_name_vector);
-			val = GetMatrixValue(primary_variable[0] + T_0, primary_variable[1], name, &gueltig);
+			val = GetMatrixValue(state.primary_variable[0] + T_0, state.primary_variable[1], name, &gueltig);
 			break;
 	}
 	return val;
@@ -1671,14 +1685,12 @@ double CSolidProperties::Kronecker(const int ii, const int jj)
    Programing:
    06/2014 TN Implementation
 **************************************************************************/
-void CSolidProperties::ExtractConsistentTangent(const Eigen::MatrixXd& Jac, const Eigen::MatrixXd& dGdE,
-												const bool pivoting, Eigen::Matrix<double, 6, 6>& dsigdE)
+template <int N>
+void CSolidProperties::ExtractConsistentTangent(const Eigen::Matrix<double, N, N>& Jac,
+												const Eigen::Matrix<double, N, 6>& dGdE, const bool pivoting,
+												KMat& dsigdE) const
 {
-	const unsigned int local_dim(Jac.cols());
-	// Check Dimensions
-	assert(local_dim == dGdE.rows() && dGdE.cols() == 6);
-
-	Eigen::MatrixXd dzdE(local_dim, 6);
+	Eigen::Matrix<double, N, 6> dzdE;
 	// solve linear system
 	if (pivoting)
 		dzdE = Jac.fullPivHouseholderQr().solve(-1.0 * dGdE); // Could consider moving to different Eigen solver.
@@ -1688,8 +1700,14 @@ void CSolidProperties::ExtractConsistentTangent(const Eigen::MatrixXd& Jac, cons
 	// in-built Gauss elimination solver was at least 4 OoM more inaccurate.
 
 	// Extract matrix part relevant for global tangent
-	dsigdE = dzdE.block<6, 6>(0, 0);
+	dsigdE = dzdE.template block<6, 6>(0, 0);
 }
+template void CSolidProperties::ExtractConsistentTangent<18>(const Eigen::Matrix<double, 18, 18>&,
+															 const Eigen::Matrix<double, 18, 6>&, const bool,
+															 KMat&) const;
+template void CSolidProperties::ExtractConsistentTangent<27>(const Eigen::Matrix<double, 27, 27>&,
+															 const Eigen::Matrix<double, 27, 6>&, const bool,
+															 KMat&) const;
 
 /**************************************************************************
    FEMLib-Method: CSolidProperties::LocalNewtonBurgers()
@@ -1698,27 +1716,19 @@ void CSolidProperties::ExtractConsistentTangent(const Eigen::MatrixXd& Jac, cons
    06/2014 TN Implementation
    03/2015 NB Modified
 **************************************************************************/
-void CSolidProperties::LocalNewtonBurgers(const double dt, const std::vector<double>& strain_curr,
-										  std::vector<double>& stress_curr, std::vector<double>& strain_K_curr,
-										  std::vector<double>& strain_M_curr, Math_Group::Matrix& Consistent_Tangent,
-										  double Temperature, double& local_res)
+void CSolidProperties::LocalNewtonBurgers(const double dt, const KVec& eps_i, KVec& sig_j, KVec& eps_K_j,
+										  KVec& eps_M_j, KMat& dsigdE, double Temperature, double& local_res)
 {
-	// stress, strain, internal variable
-	KVec sig_j, eps_K_j, eps_M_j;
-	// deviatoric stress, strain
+	// deviatoric stress
 	KVec sigd_j;
 	// local residual vector and Jacobian
 	Eigen::Matrix<double, 18, 1> res_loc, inc_loc;
 	Eigen::Matrix<double, 18, 18> K_loc;
 	double sig_eff(1.);
 
-	// initialisation of Kelvin vectors
-	// Note: Can be done in one loop instead of 5 if done right here.
-	const KVec eps_i(SolidMath::Voigt_to_Kelvin_Strain(strain_curr));
-	const KVec eps_K_t(SolidMath::Voigt_to_Kelvin_Strain(strain_K_curr));
-	const KVec eps_M_t(SolidMath::Voigt_to_Kelvin_Strain(strain_M_curr));
-	eps_M_j = eps_M_t;
-	eps_K_j = eps_K_t;
+	// internal variables at time t
+	const KVec eps_K_t(eps_K_j);
+	const KVec eps_M_t(eps_M_j);
 
 	if (!T_Process)
 		Temperature = material_burgers->T_ref;
@@ -1774,36 +1784,17 @@ void CSolidProperties::LocalNewtonBurgers(const double dt, const std::vector<dou
 	//		          << std::endl;
 	local_res = res_loc.norm();
 
-	// dGdE matrix and dsigdE matrix
+	// dGdE matrix
 	Eigen::Matrix<double, 18, 6> dGdE;
-	Eigen::Matrix<double, 6, 6> dsigdE;
 
 	// Calculate dGdE for time step
 	material_burgers->CaldGdEBurgers(dGdE);
 	// get dsigdE matrix
-	ExtractConsistentTangent(K_loc, dGdE, false, dsigdE);
+	ExtractConsistentTangent<18>(K_loc, dGdE, false, dsigdE);
 
 	// add hydrostatic part to stress and tangent
 	sig_j = material_burgers->GM * sigd_j + material_burgers->KM * e_i * SolidMath::ivec;
 	dsigdE = material_burgers->GM * dsigdE * SolidMath::P_dev + 3. * material_burgers->KM * SolidMath::P_sph;
-
-	// Sort into Consistent Tangent matrix for global Newton iteration and into standard OGS arrays
-	SolidMath::Kelvin_to_Voigt_Stress(sig_j, stress_curr);
-	SolidMath::Kelvin_to_Voigt_Strain(eps_K_j, strain_K_curr);
-	SolidMath::Kelvin_to_Voigt_Strain(eps_M_j, strain_M_curr);
-	for (size_t i = 0; i < 3; i++)
-	{
-		for (size_t j = 0; j < 3; j++)
-		{
-			Consistent_Tangent(i, j) = dsigdE(i, j);
-			Consistent_Tangent(i, j + 3) = dsigdE(i, j + 3)
-										   / sqrt(2.); // from local to global shear components (Kelvin to Voigt)
-			Consistent_Tangent(i + 3, j) = dsigdE(i + 3, j)
-										   / sqrt(2.); // from local to global shear components (Kelvin to Voigt)
-			Consistent_Tangent(i + 3, j + 3) = dsigdE(i + 3, j + 3)
-											   / 2.; // from local to global shear components (Kelvin to Voigt)
-		}
-	}
 }
 
 /**************************************************************************
@@ -1812,33 +1803,22 @@ void CSolidProperties::LocalNewtonBurgers(const double dt, const std::vector<dou
    Programing:
    06/2015 TN Implementation
 **************************************************************************/
-void CSolidProperties::LocalNewtonMinkley(const double dt, const std::vector<double>& strain_curr,
-										  std::vector<double>& stress_curr, std::vector<double>& eps_K_curr,
-										  std::vector<double>& eps_M_curr, std::vector<double>& eps_pl_curr,
-										  double& e_pl_v, double& e_pl_eff, double& lam,
-										  Math_Group::Matrix& Consistent_Tangent, double Temperature,
-										  double& local_res)
+void CSolidProperties::LocalNewtonMinkley(const double dt, const KVec& eps_i, KVec& sig_j, KVec& eps_K_j,
+										  KVec& eps_M_j, KVec& eps_pl_j, double& e_pl_v, double& e_pl_eff, double& lam,
+										  KMat& dsigdE, double Temperature, double& local_res)
 {
-	// stress, strain, internal variable
-	KVec sig_j, eps_K_j, eps_M_j, eps_pl_j;
-	// deviatoric stress, strain
+	// deviatoric stress
 	KVec sigd_j;
 	const double e_pl_v_t = e_pl_v, e_pl_eff_t = e_pl_eff;
 	// local residual vector and Jacobian
 	Eigen::Matrix<double, 18, 1> res_loc, inc_loc;
 	Eigen::Matrix<double, 18, 18> K_loc;
 	double sig_eff;
-	Eigen::Matrix<double, 6, 6> dsigdE;
-
-	// initialisation of Kelvin vectors
-	// Note: Can be done in one loop instead of 5 if done right here.
-	const KVec eps_i(SolidMath::Voigt_to_Kelvin_Strain(strain_curr));
-	const KVec eps_K_t(SolidMath::Voigt_to_Kelvin_Strain(eps_K_curr));
-	const KVec eps_M_t(SolidMath::Voigt_to_Kelvin_Strain(eps_M_curr));
-	const KVec eps_pl_t(SolidMath::Voigt_to_Kelvin_Strain(eps_pl_curr));
-	eps_M_j = eps_M_t;
-	eps_K_j = eps_K_t;
-	eps_pl_j = eps_pl_t;
+
+	// internal variables at time t
+	const KVec eps_K_t(eps_K_j);
+	const KVec eps_M_t(eps_M_j);
+	const KVec eps_pl_t(eps_pl_j);
 
 	if (!T_Process)
 		Temperature = material_minkley->T_ref;
@@ -1916,23 +1896,22 @@ void CSolidProperties::LocalNewtonMinkley(const double dt, const std::vector<dou
 			// Get Jacobian
 			material_minkley->CalViscoplasticJacobian(dt, sig_j, sig_eff, lam, e_pl_eff, K_loc_p);
 		}
-		// dGdE matrix and dsigdE matrix
+		// dGdE matrix
 		Eigen::Matrix<double, 27, 6> dGdE;
-		SolidMath::Kelvin_to_Voigt_Strain(eps_pl_j, eps_pl_curr);
 		// Calculate dGdE for time step
 		material_minkley->CalEPdGdE(dGdE);
 		// get dsigdE matrix
-		ExtractConsistentTangent(K_loc_p, dGdE, true, dsigdE); // Full pivoting needed for global convergence
+		ExtractConsistentTangent<27>(K_loc_p, dGdE, true, dsigdE); // Full pivoting needed for global convergence
 		local_res = res_loc_p.norm();
 	}
 	else
 	{
-		// dGdE matrix and dsigdE matrix
+		// dGdE matrix
 		Eigen::Matrix<double, 18, 6> dGdE;
 		// Calculate dGdE for time step
 		material_minkley->CaldGdE(dGdE);
 		// get dsigdE matrix
-		ExtractConsistentTangent(K_loc, dGdE, true, dsigdE); // Full pivoting needed for global convergence
+		ExtractConsistentTangent<18>(K_loc, dGdE, true, dsigdE); // Full pivoting needed for global convergence
 		//		if (counter == counter_max)
 		//			std::cout << "WARNING: Maximum iteration number needed in LocalNewtonMinkley. Convergence not
 		// guaranteed."
@@ -1943,24 +1922,6 @@ void CSolidProperties::LocalNewtonMinkley(const double dt, const std::vector<dou
 	// add hydrostatic part to stress and tangent
 	sig_j *= material_minkley->GM;
 	dsigdE *= material_minkley->GM;
-	// Sort into Consistent Tangent matrix for global Newton iteration and into standard OGS arrays
-	SolidMath::Kelvin_to_Voigt_Stress(sig_j, stress_curr);
-	SolidMath::Kelvin_to_Voigt_Strain(eps_K_j, eps_K_curr);
-	SolidMath::Kelvin_to_Voigt_Strain(eps_M_j, eps_M_curr);
-	// plastic strain dealt with further up
-	for (size_t i = 0; i < 3; i++)
-	{
-		for (size_t j = 0; j < 3; j++)
-		{
-			Consistent_Tangent(i, j) = dsigdE(i, j);
-			Consistent_Tangent(i, j + 3) = dsigdE(i, j + 3)
-										   / sqrt(2.); // from local to global shear components (Kelvin to Voigt)
-			Consistent_Tangent(i + 3, j) = dsigdE(i + 3, j)
-										   / sqrt(2.); // from local to global shear components (Kelvin to Voigt)
-			Consistent_Tangent(i + 3, j + 3) = dsigdE(i + 3, j + 3)
-											   / 2.; // from local to global shear components (Kelvin to Voigt)
-		}
-	}
 }
 
 /**************************************************************************
@@ -22,6 +22,7 @@ last modified:
 //#include <string>
 //#include <vector>
 
+#include "MaterialState.h"
 #include "invariants.h"
 
 #define MSP_FILE_EXTENSION ".msp"
@@ -63,6 +64,7 @@ class Invariants;
 namespace SolidProp
 {
 typedef Eigen::Matrix<double, 6, 1> KVec;
+typedef Eigen::Matrix<double, 6, 6> KMat;
 class CSolidProperties
 {
 public:
@@ -88,6 +90,8 @@ public:
 	void HeatConductivityTensor(const int dim, double* tensor, int group);
 
 	double Heat_Conductivity(double refence = 0.0);
+	// Re-entrant evaluation, the state holds the capacity variables of model 5. See MaterialState.h
+	double Heat_Conductivity(double reference, const MaterialState& state) const;
 
 	int GetCapacityModel() const { return Capacity_mode; }
 	int GetConductModel() const { return Conductivity_mode; }
@@ -152,17 +156,19 @@ public:
 	// Set value for solid reactive system - TN
 	void setSolidReactiveSystem(FiniteElement::SolidReactiveSystem reactive_system);
 
-	// general routine to get consistent tangent from local Newton iteration of material functionals
-	void ExtractConsistentTangent(const Eigen::MatrixXd& Jac, const Eigen::MatrixXd& dGdE, const bool pivoting,
-								  Eigen::Matrix<double, 6, 6>& dsigdE);
-	// general local Newton routines to integrate inelastic material models
-	void LocalNewtonBurgers(const double dt, const std::vector<double>& strain_curr, std::vector<double>& stress_curr,
-							std::vector<double>& strain_K_curr, std::vector<double>& strain_M_curr,
-							Math_Group::Matrix& Consistent_Tangent, double Temperature, double& local_res);
-	void LocalNewtonMinkley(const double dt, const std::vector<double>& strain_curr, std::vector<double>& stress_curr,
-							std::vector<double>& eps_K_curr, std::vector<double>& eps_M_curr,
-							std::vector<double>& eps_pl_curr, double& e_pl_v, double& e_pl_eff, double& lam,
-							Math_Group::Matrix& Consistent_Tangent, double Temperature, double& local_res);
+	// general routine to get consistent tangent from local Newton iteration of material functionals.
+	// N is the size of the local system (18 or 27); all matrices are of fixed size.
+	template <int N>
+	void ExtractConsistentTangent(const Eigen::Matrix<double, N, N>& Jac, const Eigen::Matrix<double, N, 6>& dGdE,
+								  const bool pivoting, KMat& dsigdE) const;
+	// general local Newton routines to integrate inelastic material models.
+	// Strains, stresses, internal variables and the tangent dsig/deps are in Kelvin notation.
+	// The internal variables are passed in with their values at time t and returned updated.
+	void LocalNewtonBurgers(const double dt, const KVec& eps_i, KVec& sig_j, KVec& eps_K_j, KVec& eps_M_j,
+							KMat& dsigdE, double Temperature, double& local_res);
+	void LocalNewtonMinkley(const double dt, const KVec& eps_i, KVec& sig_j, KVec& eps_K_j, KVec& eps_M_j,
+							KVec& eps_pl_j, double& e_pl_v, double& e_pl_eff, double& lam, KMat& dsigdE,
+							double Temperature, double& local_res);
 private:
 	// CMCD
 	FiniteElement::CFiniteElementStd* Fem_Ele_Std;
@@ -98,6 +98,8 @@ CNumerics::CNumerics(string name)
 	nls_relaxation = 0.0;
 	for (size_t i = 0; i < DOF_NUMBER_MAX; i++) // JT2012
 		nls_error_tolerance[i] = -1.0; // JT2012: should not default this. Should always be entered by user!
+	nls_acceleration = FiniteElement::FixedPointAccelerator::NONE;
+	nls_acceleration_depth = 1;
 	//
 	// CPL - Coupled processes
 	cpl_error_specified = false;
@@ -107,6 +109,8 @@ CNumerics::CNumerics(string name)
 	cpl_variable_JOD = "FLUX";
 	cpl_max_iterations = 1; // OK
 	cpl_min_iterations = 1; // JT2012
+	cpl_acceleration = FiniteElement::FixedPointAccelerator::NONE;
+	cpl_acceleration_depth = 1;
 	// Local picard1                                //NW
 	local_picard1_tolerance = 1.0e-3;
 	local_picard1_max_iterations = 1;
@@ -123,6 +127,8 @@ CNumerics::CNumerics(string name)
 	ele_supg_method = 0; // NW
 	ele_supg_method_length = 0; // NW
 	ele_supg_method_diffusivity = 0; // NW
+	ele_geometry_cache = 0;
+	ele_geometry_cache_max_mb = 0.0;
 	fct_method = -1; // NW
 	fct_prelimiter_type = 0; // NW
 	fct_const_alpha = -1.0; // NW
@@ -134,6 +140,8 @@ CNumerics::CNumerics(string name)
 	//----------------------------------------------------------------------
 	// Deformation
 	GravityProfile = 0;
+	stiffness_reuse = 0;
+	operator_reuse = 0;
 	DynamicDamping = NULL; // WW
 	if (pcs_type_name.compare("DEFORMATION") == 0)
 	{
@@ -160,6 +168,8 @@ CNumerics::CNumerics(string name)
 #ifdef USE_PETSC
 	lsover_name = "bcgs";
 	pres_name = "bjacobi";
+	pc_reuse_max = 0;
+	pc_reuse_growth = 0.0;
 #endif
 }
 
@@ -492,6 +502,19 @@ ios::pos_type CNumerics::Read(ifstream* num_file)
 			continue;
 		}
 		//....................................................................
+		// subkeyword found: NONE, AITKEN or ANDERSON depth
+		if (line_string.find("$NON_LINEAR_ACCELERATION") != string::npos)
+		{
+			line.str(GetLineFromFile1(num_file));
+			if (!FiniteElement::FixedPointAccelerator::readType(line, nls_acceleration, nls_acceleration_depth))
+			{
+				ScreenMessage("ERROR in NUMRead. Invalid $NON_LINEAR_ACCELERATION, use NONE, AITKEN or ANDERSON depth.\n");
+				exit(1);
+			}
+			line.clear();
+			continue;
+		}
+		//....................................................................
 		// subkeyword found
 		if (line_string.find("$LINEAR_SOLVER") != string::npos)
 		{
@@ -612,6 +635,19 @@ ios::pos_type CNumerics::Read(ifstream* num_file)
 			continue;
 		}
 		//....................................................................
+		// subkeyword found: NONE, AITKEN or ANDERSON depth. Applies to the iterations with the $COUPLED_PROCESS
+		if (line_string.find("$COUPLING_ACCELERATION") != string::npos)
+		{
+			line.str(GetLineFromFile1(num_file));
+			if (!FiniteElement::FixedPointAccelerator::readType(line, cpl_acceleration, cpl_acceleration_depth))
+			{
+				ScreenMessage("ERROR in NUMRead. Invalid $COUPLING_ACCELERATION, use NONE, AITKEN or ANDERSON depth.\n");
+				exit(1);
+			}
+			line.clear();
+			continue;
+		}
+		//....................................................................
 		if (line_string.find("$EXTERNAL_SOLVER_OPTION") != string::npos) // subkeyword found
 		{
 			ls_extra_arg = GetLineFromFile1(num_file);
@@ -657,6 +693,19 @@ ios::pos_type CNumerics::Read(ifstream* num_file)
 			continue;
 		}
 		// subkeyword found
+		if (line_string.find("$ELE_GEOMETRY_CACHE") != string::npos)
+		{
+			// precision (1: double, 2: single), optional memory limit in MB
+			line.str(GetLineFromFile1(num_file));
+			line >> ele_geometry_cache;
+			if (!(line >> ele_geometry_cache_max_mb))
+				ele_geometry_cache_max_mb = 0.0;
+			line.clear();
+			if (ele_geometry_cache > 0)
+				cout << "-> Element geometry cache selected for " << pcs_type_name << "\n";
+			continue;
+		}
+		// subkeyword found
 		if (line_string.find("$GRAVITY_PROFILE") != string::npos)
 		{
 			line.str(GetLineFromFile1(num_file)); // WW
@@ -664,6 +713,35 @@ ios::pos_type CNumerics::Read(ifstream* num_file)
 			line.clear();
 			continue;
 		}
+		// subkeyword found
+		if (line_string.find("$STIFFNESS_REUSE") != string::npos)
+		{
+			line.str(GetLineFromFile1(num_file));
+			line >> stiffness_reuse; // 1: linear elasticity, 2: modified Newton
+			line.clear();
+			continue;
+		}
+		// subkeyword found
+		if (line_string.find("$OPERATOR_REUSE") != string::npos)
+		{
+			line.str(GetLineFromFile1(num_file));
+			line >> operator_reuse; // 1: linear groundwater flow, heat or mass transport
+			line.clear();
+			continue;
+		}
+#ifdef USE_PETSC
+		// subkeyword found
+		if (line_string.find("$PRECONDITIONER_REUSE") != string::npos)
+		{
+			// max. number of solves per preconditioner, optional iteration growth factor
+			line.str(GetLineFromFile1(num_file));
+			line >> pc_reuse_max;
+			if (!(line >> pc_reuse_growth))
+				pc_reuse_growth = 0.0;
+			line.clear();
+			continue;
+		}
+#endif
 		// subkeyword found
 		if (line_string.find("$DYNAMIC_DAMPING") != string::npos)
 		{
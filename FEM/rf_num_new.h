@@ -19,6 +19,7 @@
 
 #include "makros.h" // JT
 #include "FEMEnums.h"
+#include "FixedPointAccelerator.h"
 
 #define NUM_FILE_EXTENSION ".num"
 // C++ STL
@@ -61,6 +62,9 @@ public:
 	double nls_relaxation;
 	double nls_error_tolerance[DOF_NUMBER_MAX]; // JT2012: array function of dof
 	double nls_plasticity_local_tolerance;
+	/// Acceleration of the Picard iterations ($NON_LINEAR_ACCELERATION)
+	FiniteElement::FixedPointAccelerator::Type nls_acceleration;
+	std::size_t nls_acceleration_depth;
 	void setNonLinearErrorMethod(FiniteElement::ErrorMethod nls_method) { _pcs_nls_error_method = nls_method; }
 	FiniteElement::ErrorMethod getNonLinearErrorMethod() const { return _pcs_nls_error_method; }
 	//
@@ -74,6 +78,9 @@ public:
 	double cpl_error_tolerance[DOF_NUMBER_MAX]; // JT2012: array function of dof
 	bool cpl_error_specified; // JT2012
 	bool cpl_master_process;
+	/// Acceleration of the coupling iterations with the coupled process ($COUPLING_ACCELERATION)
+	FiniteElement::FixedPointAccelerator::Type cpl_acceleration;
+	std::size_t cpl_acceleration_depth;
 	void setCouplingErrorMethod(FiniteElement::ErrorMethod cpl_method) { _pcs_cpl_error_method = cpl_method; }
 	FiniteElement::ErrorMethod getCouplingErrorMethod() const { return _pcs_cpl_error_method; }
 	// local_picard1
@@ -89,12 +96,23 @@ public:
 	int ele_supg_method; // NW
 	int ele_supg_method_length; // NW
 	int ele_supg_method_diffusivity; // NW
+	/// Keep the element Jacobians and shape function gradients at the Gauss
+	/// points. 0: off, 1: double, 2: single precision ($ELE_GEOMETRY_CACHE)
+	int ele_geometry_cache;
+	/// Memory limit of the geometry cache in MB, unlimited if <= 0
+	double ele_geometry_cache_max_mb;
 	// FEM-FCT
 	int fct_method; // NW
 	unsigned int fct_prelimiter_type; // NW
 	double fct_const_alpha; // NW
+	/// Keep the global mass and stiffness matrices of a linear process over
+	/// the time steps. 0: off, 1: on ($OPERATOR_REUSE)
+	int operator_reuse;
 	// Deformation
 	int GravityProfile;
+	/// Reuse of the assembled stiffness matrix. 0: off, 1: as long as the
+	/// operator is unchanged (linear elasticity), 2: within one step (modified Newton)
+	int stiffness_reuse;
 	// LAGRANGE method //OK
 	double lag_quality;
 	int lag_max_steps;
@@ -128,6 +146,11 @@ public:
 #ifdef USE_PETSC
 	const char* getLinearSolverName() const { return lsover_name.c_str(); }
 	const char* getPreconditionerName() const { return pres_name.c_str(); }
+	/// Maximum number of solves with one preconditioner, 0: rebuild for every solve
+	int getPreconditionerReuse() const { return pc_reuse_max; }
+	/// Rebuild a reused preconditioner once the iterations exceed this factor times
+	/// the iterations of the first solve with it, 0: no check
+	double getPreconditionerReuseGrowth() const { return pc_reuse_growth; }
 #endif
 
 private:
@@ -141,6 +164,8 @@ private:
 #ifdef USE_PETSC
 	std::string lsover_name; // WW
 	std::string pres_name;
+	int pc_reuse_max; // $PRECONDITIONER_REUSE
+	double pc_reuse_growth;
 #endif
 };
 
@@ -89,6 +89,9 @@ extern size_t max_dim; // OK411 todo
 using MeshLib::CFEMesh;
 //==========================================================================
 vector<COutput*> out_vector;
+// Observation points with $DAT_TYPE POINTS_CSV, grouped at the first output
+static vector<COutputPointGroup*> out_point_group_vector;
+static bool out_point_groups_built = false;
 
 std::string defaultOutputPath = ""; // CL
 
@@ -250,6 +253,42 @@ void OUTData(double time_current, int time_step_number, bool force_output)
 	bool OutputBySteps = false;
 	double tim_value;
 
+	if (!out_point_groups_built)
+	{
+		out_point_groups_built = true;
+		for (size_t i = 0; i < out_vector.size(); i++)
+		{
+			m_out = out_vector[i];
+			if (m_out->dat_type_name.compare("POINTS_CSV") != 0)
+				continue;
+			if (m_out->getGeoType() != GEOLIB::POINT)
+			{
+				cout << "Warning in OUTData - $DAT_TYPE POINTS_CSV requires $GEO_TYPE POINT"
+				     << "\n";
+				continue;
+			}
+			size_t k(0);
+			while (k < out_point_group_vector.size() && !out_point_group_vector[k]->accepts(*m_out))
+				k++;
+			if (k < out_point_group_vector.size())
+			{
+				out_point_group_vector[k]->add(m_out);
+				continue;
+			}
+			// one file per group, numbered if a process has several groups
+			string file_name(m_out->getFileBaseName() + "_" + convertProcessTypeToString(m_out->getProcessType())
+			                 + "_points");
+			size_t n_same_name(0);
+			for (size_t j = 0; j < out_point_group_vector.size(); j++)
+				if (out_point_group_vector[j]->getFileName().find(file_name) == 0)
+					n_same_name++;
+			if (n_same_name > 0)
+				file_name += "_" + number2str(n_same_name + 1);
+			file_name += CSV_FILE_EXTENSION;
+			out_point_group_vector.push_back(new COutputPointGroup(m_out, file_name));
+		}
+	}
+
 	for (size_t i = 0; i < out_vector.size(); i++)
 	{
 		OutputBySteps = false; // reset this flag for each COutput
@@ -601,6 +640,10 @@ void OUTData(double time_current, int time_step_number, bool force_output)
 			m_out->CalcELEFluxes();
 	} // OUT loop
 	//======================================================================
+	// Observation point groups, one row per group and output
+	for (size_t i = 0; i < out_point_group_vector.size(); i++)
+		out_point_group_vector[i]->write(time_current);
+	//======================================================================
 }
 
 /**************************************************************************
@@ -612,6 +655,11 @@ void OUTData(double time_current, int time_step_number, bool force_output)
 **************************************************************************/
 void OUTDelete()
 {
+	for (size_t i = 0; i < out_point_group_vector.size(); i++)
+		delete out_point_group_vector[i];
+	out_point_group_vector.clear();
+	out_point_groups_built = false;
+
 	const size_t no_out = out_vector.size();
 	for (size_t i = 0; i < no_out; i++)
 		delete out_vector[i];
@@ -44,6 +44,7 @@
 
 // C++
 #include <cfloat>
+#include <cstring>
 #include <iomanip> //WW
 #include <iostream>
 #include <algorithm>
@@ -129,6 +130,9 @@ REACT_BRNS* m_vec_BRNS;
 
 #include "fct_mpi.h"
 
+// FileIO
+#include "BinaryRestartIO.h"
+
 using namespace std;
 using namespace MeshLib;
 using namespace Math_Group;
@@ -236,12 +240,25 @@ CRFProcess::CRFProcess(void)
 #ifdef JFNK_H2M
       JFNK_precond(false), norm_u_JFNK(NULL), array_u_JFNK(NULL), array_Fu_JFNK(NULL),
 #endif
-      ele_val_name_vector(std::vector<std::string>())
+      ele_val_name_vector(std::vector<std::string>()), _has_saved_state(false)
 {
 	iter_lin = 0;
 	iter_lin_max = 0;
 	iter_nlin = 0;
 	iter_nlin_max = 0;
+	nls_accelerator = NULL;
+#if !defined(USE_PETSC)
+	_bc_plan_valid = false;
+	_bc_plan_time = 0.0;
+	_bc_plan_size = 0;
+#endif
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	_operator_mass = NULL;
+	_operator_stiffness = NULL;
+	_operator_recording = false;
+	_operator_valid = false;
+	_operator_velocity_checksum[0] = _operator_velocity_checksum[1] = 0.0;
+#endif
 	iter_inner_cpl = 0;
 	iter_outer_cpl = 0;
 	TempArry = NULL;
@@ -321,6 +338,7 @@ CRFProcess::CRFProcess(void)
 	// Reload solutions
 	reload = -1;
 	nwrite_restart = 1; // kg44 write every timestep is default
+	reload_binary = false;
 	pcs_nval_data = NULL;
 	pcs_eval_data = NULL;
 	non_linear = false; // OK/CMCD
@@ -506,6 +524,12 @@ CRFProcess::~CRFProcess(void)
 	DeleteArray(num_nodes_p_var);
 	// 20.08.2010. WW
 	DeleteArray(p_var_index);
+	delete nls_accelerator;
+	releaseTimeStepState();
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	delete _operator_mass;
+	delete _operator_stiffness;
+#endif
 #ifdef JFNK_H2M
 	DeleteArray(array_u_JFNK); // 13.08.2010. WW
 	DeleteArray(array_Fu_JFNK); // 31.08.2010. WW
@@ -559,6 +583,29 @@ void CRFProcess::AllocateMemGPoint()
 		ele_gp_value.push_back(new ElementValue(this, m_msh->ele_vector[i]));
 }
 
+namespace
+{
+/// Matrix over the FCT edges: nodes i and j are coupled if they share an
+/// element. With eqs_index the rows and columns are the equation indices of
+/// the nodes, otherwise the node indices.
+SparseMatrixCSR* createFCTMatrix(const CFEMesh* msh, size_t n_rows, bool eqs_index)
+{
+	std::vector<std::vector<size_t> > row_columns(n_rows);
+	std::vector<size_t> ids;
+	for (size_t e = 0; e < msh->ele_vector.size(); e++)
+	{
+		const CElem* elem = msh->ele_vector[e];
+		const size_t n_nodes = elem->GetNodesNumber(false);
+		ids.resize(n_nodes);
+		for (size_t i = 0; i < n_nodes; i++)
+			ids[i] = eqs_index ? msh->nod_vector[elem->GetNodeIndex(i)]->GetEquationIndex() : elem->GetNodeIndex(i);
+		for (size_t i = 0; i < n_nodes; i++)
+			row_columns[ids[i]].insert(row_columns[ids[i]].end(), ids.begin(), ids.end());
+	}
+	return new SparseMatrixCSR(row_columns);
+}
+}
+
 /**************************************************************************
    PCSLib-Method:
    10/2002 OK Implementation
@@ -659,12 +706,12 @@ void CRFProcess::Create()
 // Memory_Type = 1;
 #ifdef USE_PETSC
 		long gl_size = m_msh->getNumNodesGlobal();
-		this->FCT_K = new SparseMatrixDOK(gl_size, gl_size);
-		this->FCT_d = new SparseMatrixDOK(gl_size, gl_size);
+		this->FCT_K = createFCTMatrix(m_msh, gl_size, true);
+		this->FCT_d = createFCTMatrix(m_msh, gl_size, true);
 #else
 		long gl_size = m_msh->GetNodesNumber(false);
 #endif
-		this->FCT_AFlux = new SparseMatrixDOK(gl_size, gl_size);
+		this->FCT_AFlux = createFCTMatrix(m_msh, gl_size, false);
 		this->Gl_ML = new Math_Group::Vec(gl_size);
 		this->Gl_Vec = new Math_Group::Vec(gl_size);
 		this->Gl_Vec1 = new Math_Group::Vec(gl_size);
@@ -907,6 +954,8 @@ void CRFProcess::Create()
 				Axisymm = -1; // Axisymmetry is true
 			fem = new CFiniteElementStd(this, Axisymm * m_msh->GetCoordinateFlag());
 			fem->SetGaussPointNumber(m_num->ele_gauss_points);
+			fem->setGeometryCache(m_msh->ele_vector.size(), m_num->ele_geometry_cache,
+			                      m_num->ele_geometry_cache_max_mb);
 		}
 	}
 
@@ -1235,6 +1284,12 @@ void CRFProcess::WriteSolution()
 	if ((aktueller_zeitschritt % nwrite_restart) > 0)
 		return;
 
+	if (reload_binary)
+	{
+		WriteSolution_BIN();
+		return;
+	}
+
 	std::string pcs_type_name(convertProcessTypeToString(this->getProcessType()));
 #if defined(USE_PETSC) //|| defined(other parallel libs)//03.3012. WW
 	int rank;
@@ -1283,6 +1338,12 @@ void CRFProcess::WriteSolution()
 **************************************************************************/
 void CRFProcess::ReadSolution()
 {
+	if (reload_binary)
+	{
+		ReadSolution_BIN();
+		return;
+	}
+
 	std::string pcs_type_name(convertProcessTypeToString(this->getProcessType()));
 #if defined(USE_PETSC)
 	int rank;
@@ -1326,6 +1387,95 @@ void CRFProcess::ReadSolution()
 	delete[] val;
 }
 
+namespace
+{
+std::string restartFileName(const std::string& file_base, const std::string& pcs_type_name,
+                            const std::string& primary_name)
+{
+	std::string name = file_base + "_" + pcs_type_name + "_" + primary_name + "_restart";
+#if defined(USE_PETSC)
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	name += "_" + number2str(rank);
+#endif
+	return name + ".bin";
+}
+
+/// Layout of the binary restart file of a process: the sizes and names of
+/// the node and element values, and the time stepping state
+FileIO::BinaryRestartIO::Header restartFileHeader(CRFProcess& pcs)
+{
+	FileIO::BinaryRestartIO::Header header;
+	header.time_step = static_cast<int64_t>(aktueller_zeitschritt);
+	header.time = aktuelle_zeit;
+	header.time_step_size = dt;
+	header.n_nodes = static_cast<uint64_t>(pcs.m_msh->GetNodesNumber(true));
+	header.node_value_names = pcs.nod_val_name_vector;
+	header.n_elements = static_cast<uint64_t>(pcs.ele_val_vector.size());
+	header.n_element_values
+	    = (pcs.ele_val_vector.size() > 0) ? static_cast<uint32_t>(pcs.getElementValueNameVector().size()) : 0;
+	return header;
+}
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Write all node values (both time levels, primary and
+         secondary variables) and element values of the process into one
+         binary file for restart. Every node value array is written with
+         one call.
+**************************************************************************/
+void CRFProcess::WriteSolution_BIN()
+{
+	const std::string pcs_type_name(convertProcessTypeToString(this->getProcessType()));
+	const std::string m_file_name(restartFileName(FileName, pcs_type_name, pcs_primary_function_name[0]));
+
+	const FileIO::BinaryRestartIO::Header header(restartFileHeader(*this));
+	std::vector<double const*> node_values(nod_val_vector.begin(), nod_val_vector.end());
+	// Element values are stored per element. Gather them to write once.
+	std::vector<double> element_values(header.n_elements * header.n_element_values);
+	for (std::size_t i = 0; i < header.n_elements; i++)
+		for (std::size_t j = 0; j < header.n_element_values; j++)
+			element_values[i * header.n_element_values + j] = ele_val_vector[i][j];
+
+	if (!FileIO::BinaryRestartIO::write(m_file_name, header, node_values, element_values))
+	{
+		cout << "Failure to write file: " << m_file_name << "\n";
+		abort();
+	}
+	cout << "Write restart data for timestep " << aktueller_zeitschritt << " into file " << m_file_name << "\n";
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Read the binary restart file written by WriteSolution_BIN
+**************************************************************************/
+void CRFProcess::ReadSolution_BIN()
+{
+	const std::string pcs_type_name(convertProcessTypeToString(this->getProcessType()));
+	const std::string m_file_name(restartFileName(FileName, pcs_type_name, pcs_primary_function_name[0]));
+
+	FileIO::BinaryRestartIO::Header header(restartFileHeader(*this));
+	std::vector<double> element_values;
+	if (!FileIO::BinaryRestartIO::read(m_file_name, header, nod_val_vector, element_values))
+		abort();
+
+	// As for the ASCII restart, the restored solution is the initial state of
+	// both time levels of the primary variables
+	for (int j = 0; j < pcs_number_of_primary_nvals; j++)
+	{
+		const int idx_new = GetNodeValueIndex(pcs_primary_function_name[j]) + 1;
+		for (std::size_t i = 0; i < header.n_nodes; i++)
+			nod_val_vector[idx_new - 1][i] = nod_val_vector[idx_new][i];
+	}
+	for (std::size_t i = 0; i < header.n_elements; i++)
+		for (std::size_t j = 0; j < header.n_element_values; j++)
+			ele_val_vector[i][j] = element_values[i * header.n_element_values + j];
+
+	cout << "Read restart data of timestep " << header.time_step << " (time " << header.time
+	     << ", time step size " << header.time_step_size << ") from file " << m_file_name << "\n";
+}
+
 /**************************************************************************
    FEMLib-Method:
    Task:
@@ -1715,6 +1865,7 @@ CRFProcess* CRFProcess::CopyPCStoDM_PCS()
 	dm_pcs->NumDeactivated_SubDomains = NumDeactivated_SubDomains;
 	dm_pcs->reload = reload;
 	dm_pcs->nwrite_restart = nwrite_restart;
+	dm_pcs->reload_binary = reload_binary;
 	dm_pcs->isPCSDeformation = true;
 	dm_pcs->isPCSFlow = this->isPCSFlow; // JT
 	dm_pcs->isPCSMultiFlow = this->isPCSMultiFlow; // JT
@@ -2000,7 +2151,10 @@ std::ios::pos_type CRFProcess::Read(std::ifstream* pcs_file)
 			*pcs_file >> reload; // WW
 			if (reload == 1 || reload == 3)
 				*pcs_file >> nwrite_restart; // kg44 read number of timesteps between writing restart files
-			pcs_file->ignore(MAX_ZEILE, '\n');
+			// Optional file format: ASCII (default) or BINARY
+			getline(*pcs_file, line_string);
+			if (line_string.find("BINARY") != string::npos)
+				reload_binary = true;
 			continue;
 		}
 		// subkeyword found
@@ -4931,15 +5085,18 @@ double CRFProcess::Execute()
 		//--------------------------------------------------------------------
 		// 7 Store solution vector in model node values table
 		//....................................................................
-		for (int i = 0; i < pcs_number_of_primary_nvals; i++)
-		{
-			nidx1 = GetNodeValueIndex(pcs_primary_function_name[i]) + 1;
-			for (j = 0; j < g_nnodes; j++)
+		if (nls_accelerator && pcs_error >= 1.0)
+			AcceleratePicardIteration(eqs_x);
+		else
+			for (int i = 0; i < pcs_number_of_primary_nvals; i++)
 			{
-				k = m_msh->Eqs2Global_NodeIndex[j] * pcs_number_of_primary_nvals + i;
-				SetNodeValue(j, nidx1, (1. - nl_theta) * GetNodeValue(j, nidx1) + nl_theta * eqs_x[k]);
+				nidx1 = GetNodeValueIndex(pcs_primary_function_name[i]) + 1;
+				for (j = 0; j < g_nnodes; j++)
+				{
+					k = m_msh->Eqs2Global_NodeIndex[j] * pcs_number_of_primary_nvals + i;
+					SetNodeValue(j, nidx1, (1. - nl_theta) * GetNodeValue(j, nidx1) + nl_theta * eqs_x[k]);
+				}
 			}
-		}
 
 	} // END PICARD
 #else
@@ -4968,7 +5125,9 @@ double CRFProcess::Execute()
 		eqs_x = eqs_new->GetGlobalSolution();
 #endif
 		//
-		if (nl_theta > implicit_lim) // This is most common. So go for the lesser calculations.
+		if (nls_accelerator && pcs_error >= 1.0) // Anderson or Aitken instead of the fixed relaxation
+			AcceleratePicardIteration(eqs_x);
+		else if (nl_theta > implicit_lim) // This is most common. So go for the lesser calculations.
 		{
 			for (int ii = 0; ii < pcs_number_of_primary_nvals; ii++)
 			{
@@ -5131,11 +5290,8 @@ void CRFProcess::AddFCT_CorrectionVector()
 	int idx0 = 0;
 	int idx1 = idx0 + 1;
 	const double theta = this->m_num->ls_theta;
-	const size_t node_size = m_msh->GetNodesNumber(false);
-	SparseMatrixDOK::mat_t& fct_f = this->FCT_AFlux->GetRawData();
-	SparseMatrixDOK::col_t* col;
-	SparseMatrixDOK::mat_t::const_iterator ii;
-	SparseMatrixDOK::col_t::const_iterator jj;
+	const long node_size = static_cast<long>(m_msh->GetNodesNumber(false));
+	SparseMatrixCSR& fct_f = *this->FCT_AFlux;
 	Math_Group::Vec* ML = this->Gl_ML;
 #if defined(NEW_EQS)
 	CSparseMatrix* A = NULL; // WW
@@ -5144,6 +5300,13 @@ void CRFProcess::AddFCT_CorrectionVector()
 	// else
 	A = this->eqs_new->A;
 #endif
+#if !defined(USE_PETSC)
+	// The rows and columns of the equation system are the equation indices,
+	// which differ from the node indices with $EQS_RENUMBERING
+	std::vector<long> eqs_index(node_size);
+	for (long i = 0; i < node_size; i++)
+		eqs_index[i] = m_msh->nod_vector[i]->GetEquationIndex();
+#endif
 
 #ifdef USE_PETSC
 	// gather K
@@ -5152,15 +5315,6 @@ void CRFProcess::AddFCT_CorrectionVector()
 	FCT_MPI::computeD(m_msh, *FCT_K, *FCT_d);
 #endif
 
-	// List of Dirichlet nodes
-	std::set<long> list_bc_nodes;
-	for (size_t i = 0; i < bc_node_value.size(); i++)
-	{
-		CBoundaryConditionNode* bc_node = bc_node_value[i];
-		long nod_id = bc_node->geo_node_number;
-		list_bc_nodes.insert(nod_id);
-	}
-
 	//----------------------------------------------------------------------
 	// Construct global matrices: antidiffusive flux(f_ij), positivity matrix(L)
 	// - f_ij = 1/dt*m_ij*(DeltaU_ij^H-DeltaU_ij^n)-theta*d_ij^H*DeltaU_ij^H-(1-theta)*d_ij^n*DeltaU_ij^n
@@ -5172,36 +5326,43 @@ void CRFProcess::AddFCT_CorrectionVector()
 	// - K is stored in A matrix in the element assembly.
 	// - the first part of the antidiffusive flux is done in the element assembly.
 	//   -> f_ij = m_ij
+	// - f is stored over the edges of the mesh. The loops below run over the
+	//   rows and touch only the edges i<j of the row and their mirrors (j,i),
+	//   so rows can be processed in parallel.
 	//----------------------------------------------------------------------
 	// f_ij*=1/dt*(DeltaU_ij^H-DeltaU_ij^n)  for i!=j
-	for (size_t i = 0; i < node_size; i++)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (long i = 0; i < node_size; i++)
 	{
-		col = &fct_f[i];
-		for (jj = col->begin(); jj != col->end(); jj++)
+		for (size_t k = fct_f.RowBegin(i); k < fct_f.RowEnd(i); k++)
 		{
-			const size_t j = (*jj).first;
-			if (i > j)
+			const size_t j = fct_f.Column(k);
+			if ((size_t)i >= j)
 				continue; // symmetric part, off-diagonal
 			double diff_uH = this->GetNodeValue(i, idx1) - this->GetNodeValue(j, idx1);
 			double diff_u0 = this->GetNodeValue(i, idx0) - this->GetNodeValue(j, idx0);
 			double v = 1.0 / dt * (diff_uH - diff_u0);
-			(*FCT_AFlux)(i, j) *= v; // MC is already done in local ele assembly
-			(*FCT_AFlux)(j, i) *= -v; // MC is already done in local ele assembly
+			fct_f.Value(k) *= v; // MC is already done in local ele assembly
+			fct_f.Value(fct_f.Transposed(k)) *= -v; // MC is already done in local ele assembly
 		}
 	}
 
-	// Complete f, L
-	// Remark: Using iteration is only possible after the sparse table has been constructed.
-	for (size_t i = 0; i < node_size; i++)
+	// Complete f and get the artificial diffusion d_ij of each edge i<j
+	std::vector<double> edge_d(fct_f.Size(), 0.0);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (long i = 0; i < node_size; i++)
 	{
 #ifdef USE_PETSC
 		const size_t i_global = FCT_GLOB_ADDRESS(i);
 #endif
-		col = &fct_f[i];
-		for (jj = col->begin(); jj != col->end(); jj++)
+		for (size_t k = fct_f.RowBegin(i); k < fct_f.RowEnd(i); k++)
 		{
-			const size_t j = (*jj).first;
-			if (i > j || i == j)
+			const size_t j = fct_f.Column(k);
+			if ((size_t)i >= j)
 				continue; // do below only for upper triangle due to symmetric
 
 // Get artificial diffusion operator D
@@ -5210,11 +5371,11 @@ void CRFProcess::AddFCT_CorrectionVector()
 			double d1 = (*FCT_d)(i_global, j_global);
 #else
 #if defined(NEW_EQS)
-			double K_ij = (*A)(i, j);
-			double K_ji = (*A)(j, i);
+			double K_ij = (*A)(eqs_index[i], eqs_index[j]);
+			double K_ji = (*A)(eqs_index[j], eqs_index[i]);
 #else
-			double K_ij = MXGet(i, j);
-			double K_ji = MXGet(j, i);
+			double K_ij = MXGet(eqs_index[i], eqs_index[j]);
+			double K_ji = MXGet(eqs_index[j], eqs_index[i]);
 #endif
 			if (K_ij == 0.0 && K_ji == 0.0)
 				continue;
@@ -5223,18 +5384,13 @@ void CRFProcess::AddFCT_CorrectionVector()
 			if (d1 == 0.0)
 				continue;
 			double d0 = d1; // TODO should use AuxMatrix at the previous time step
-			// if (list_bc_nodes.find(i)!=list_bc_nodes.end() || list_bc_nodes.find(j)!=list_bc_nodes.end()) {
-			//  d1 = d0 = 0.0;
-			//}
 
 			// Complete antidiffusive flux: f_ij += -theta*d_ij^H*DeltaU_ij^H - (1-theta)*d_ij^n*DeltaU_ij^n
 			double diff_uH = this->GetNodeValue(i, idx1) - this->GetNodeValue(j, idx1);
 			double diff_u0 = this->GetNodeValue(i, idx0) - this->GetNodeValue(j, idx0);
-			double v = -(theta * d1 * diff_uH + (1.0 - theta) * d0 * diff_u0);
-			(*FCT_AFlux)(i, j) += v;
+			double v = fct_f.Value(k) - (theta * d1 * diff_uH + (1.0 - theta) * d0 * diff_u0);
 
 			// prelimiting f
-			v = (*FCT_AFlux)(i, j);
 			if (this->m_num->fct_prelimiter_type == 0)
 			{
 				if (v * (-diff_uH) > 0.0)
@@ -5244,16 +5400,32 @@ void CRFProcess::AddFCT_CorrectionVector()
 				v = MinMod(v, -d1 * diff_uH);
 			else if (this->m_num->fct_prelimiter_type == 2)
 				v = SuperBee(v, -d1 * diff_uH);
-			(*FCT_AFlux)(i, j) = v;
+			fct_f.Value(k) = v;
 #ifdef USE_PETSC
-			(*FCT_AFlux)(j, i) = -v;
+			fct_f.Value(fct_f.Transposed(k)) = -v;
 #else
-			(*FCT_AFlux)(j, i) = v;
+			fct_f.Value(fct_f.Transposed(k)) = v;
 #endif
+			edge_d[k] = d1;
+		}
+	}
 
+	// L = K + D
+	for (long i = 0; i < node_size; i++)
+	{
 #ifdef USE_PETSC
+		const size_t i_global = FCT_GLOB_ADDRESS(i);
+#endif
+		for (size_t k = fct_f.RowBegin(i); k < fct_f.RowEnd(i); k++)
+		{
+			const double d1 = edge_d[k];
+			if (d1 == 0.0)
+				continue;
+			const size_t j = fct_f.Column(k);
+#ifdef USE_PETSC
+			const size_t j_global = FCT_GLOB_ADDRESS(j);
 			// A += theta * D
-			if (i < (size_t)m_msh->getNumNodesLocal())
+			if (i < m_msh->getNumNodesLocal())
 			{
 				eqs_new->addMatrixEntry(i_global, i_global, -d1 * theta);
 				eqs_new->addMatrixEntry(i_global, j_global, d1 * theta);
@@ -5264,19 +5436,19 @@ void CRFProcess::AddFCT_CorrectionVector()
 				eqs_new->addMatrixEntry(j_global, j_global, -d1 * theta);
 			}
 #else
-// L = K + D
+			const long i_eqs = eqs_index[i], j_eqs = eqs_index[j];
 #if defined(NEW_EQS)
-			(*A)(i, i) += -d1;
-			(*A)(i, j) += d1;
-			(*A)(j, i) += d1;
-			(*A)(j, j) += -d1;
+			(*A)(i_eqs, i_eqs) += -d1;
+			(*A)(i_eqs, j_eqs) += d1;
+			(*A)(j_eqs, i_eqs) += d1;
+			(*A)(j_eqs, j_eqs) += -d1;
 #else
 			// add off-diagonal term
-			MXInc(i, j, d1);
-			MXInc(j, i, d1);
+			MXInc(i_eqs, j_eqs, d1);
+			MXInc(j_eqs, i_eqs, d1);
 			// add diagonal term
-			MXInc(i, i, -d1);
-			MXInc(j, j, -d1);
+			MXInc(i_eqs, i_eqs, -d1);
+			MXInc(j_eqs, j_eqs, -d1);
 #endif
 #endif
 		}
@@ -5301,39 +5473,43 @@ void CRFProcess::AddFCT_CorrectionVector()
 	if (1.0 - theta > .0)
 	{
 		// u^n
-		for (size_t i = 0; i < node_size; i++)
+		for (long i = 0; i < node_size; i++)
 			(*V1)(i) = this->GetNodeValue(i, idx0);
-		// L*u^n
-		for (size_t i = 0; i < node_size; i++)
+// L*u^n, L_ij is zero unless i and j share an element
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+		for (long i = 0; i < node_size; i++)
 		{
 #ifdef USE_PETSC
 			const size_t i_global = FCT_GLOB_ADDRESS(i);
 #endif
-			for (size_t j = 0; j < node_size; j++)
+			for (size_t k = fct_f.RowBegin(i); k < fct_f.RowEnd(i); k++)
 			{
+				const size_t j = fct_f.Column(k);
 #ifdef USE_PETSC
 				const size_t j_global = FCT_GLOB_ADDRESS(j);
 				// b+=-(1-theta)*D*u^n
 				(*V)(i) += (*FCT_d)(i_global, j_global) * (*V1)(j);
 #else
 #ifdef NEW_EQS
-				(*V)(i) += (*A)(i, j) * (*V1)(j);
+				(*V)(i) += (*A)(eqs_index[i], eqs_index[j]) * (*V1)(j);
 #else
-				(*V)(i) += MXGet(i, j) * (*V1)(j);
+				(*V)(i) += MXGet(eqs_index[i], eqs_index[j]) * (*V1)(j);
 #endif
 #endif
 			}
 		}
-		for (size_t i = 0; i < node_size; i++)
+		for (long i = 0; i < node_size; i++)
 		{
 #if defined(USE_PETSC)
-			if (i < (size_t)m_msh->getNumNodesLocal())
+			if (i < m_msh->getNumNodesLocal())
 			{
 				const size_t i_global = FCT_GLOB_ADDRESS(i);
 				eqs_new->add_bVectorEntry(i_global, -(1.0 - theta) * (*V)(i), ADD_VALUES);
 			}
 #else
-			eqs_rhs[i] -= (1.0 - theta) * (*V)(i);
+			eqs_rhs[eqs_index[i]] -= (1.0 - theta) * (*V)(i);
 //(*RHS)(i+LocalShift) +=  NodalVal[i];
 #endif
 		}
@@ -5349,9 +5525,9 @@ void CRFProcess::AddFCT_CorrectionVector()
 #ifdef NEW_EQS
 		(*A) = 0.0;
 #else
-		for (size_t i = 0; i < node_size; i++)
-			for (size_t j = 0; j < node_size; j++)
-				MXSet(i, j, 0.0);
+		for (long i = 0; i < node_size; i++)
+			for (size_t k = fct_f.RowBegin(i); k < fct_f.RowEnd(i); k++)
+				MXSet(eqs_index[i], eqs_index[fct_f.Column(k)], 0.0);
 
 #endif
 	}
@@ -5364,20 +5540,20 @@ void CRFProcess::AddFCT_CorrectionVector()
 #ifdef NEW_EQS
 		(*A) *= theta;
 #else
-		for (size_t i = 0; i < node_size; i++)
-			for (size_t j = 0; j < node_size; j++)
-				MXMul(i, j, theta);
+		for (long i = 0; i < node_size; i++)
+			for (size_t k = fct_f.RowBegin(i); k < fct_f.RowEnd(i); k++)
+				MXMul(eqs_index[i], eqs_index[fct_f.Column(k)], theta);
 
 #endif
 	}
 	// A matrix: += 1/dt * ML
-	for (size_t i = 0; i < node_size; i++)
+	for (long i = 0; i < node_size; i++)
 	{
 		double v = 1.0 / dt * (*ML)(i);
 #ifdef NEW_EQS
-		(*A)(i, i) += v;
+		(*A)(eqs_index[i], eqs_index[i]) += v;
 #else
-		MXInc(i, i, v);
+		MXInc(eqs_index[i], eqs_index[i], v);
 #endif
 	}
 #endif
@@ -5390,22 +5566,24 @@ void CRFProcess::AddFCT_CorrectionVector()
 	Math_Group::Vec* R_min = this->Gl_Vec;
 	(*R_plus) = 0.0;
 	(*R_min) = 0.0;
-	for (size_t i = 0; i < node_size; i++)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (long i = 0; i < node_size; i++)
 	{
 		const size_t i_global = FCT_GLOB_ADDRESS(i);
 		double P_plus, P_min;
 		double Q_plus, Q_min;
 		P_plus = P_min = 0.0;
 		Q_plus = Q_min = 0.0;
-		col = &fct_f[i];
-		for (jj = col->begin(); jj != col->end(); jj++)
+		for (size_t k = fct_f.RowBegin(i); k < fct_f.RowEnd(i); k++)
 		{
-			const size_t j = (*jj).first;
-			if (i == j)
+			const size_t j = fct_f.Column(k);
+			if ((size_t)i == j)
 				continue;
-			double f = (*jj).second; // double f = (*FCT_AFlux)(i,j);
+			double f = fct_f.Value(k);
 #ifndef USE_PETSC
-			if (i > j)
+			if ((size_t)i > j)
 				f *= -1.0;
 #endif
 			double diff_uH = this->GetNodeValue(j, idx1) - this->GetNodeValue(i, idx1);
@@ -5441,21 +5619,23 @@ void CRFProcess::AddFCT_CorrectionVector()
 		(*R_min)(i_global) = 1.0;
 	}
 
-	// b_i += alpha_i * f_ij
-	for (size_t i = 0; i < node_size; i++)
+// b_i += alpha_i * f_ij
+#if defined(_OPENMP) && !defined(USE_PETSC)
+#pragma omp parallel for
+#endif
+	for (long i = 0; i < node_size; i++)
 	{
 		const size_t i_global = FCT_GLOB_ADDRESS(i);
-		col = &fct_f[i];
-		for (jj = col->begin(); jj != col->end(); jj++)
+		for (size_t k = fct_f.RowBegin(i); k < fct_f.RowEnd(i); k++)
 		{
-			const size_t j = (*jj).first;
+			const size_t j = fct_f.Column(k);
 			const size_t j_global = FCT_GLOB_ADDRESS(j);
-			if (i == j)
+			if ((size_t)i == j)
 				continue;
 
-			double f = (*jj).second; // double f = (*FCT_AFlux)(i,j);
+			double f = fct_f.Value(k);
 #ifndef USE_PETSC
-			if (i > j)
+			if ((size_t)i > j)
 				f *= -1; // symmetric
 #endif
 			double alpha = 1.0;
@@ -5471,10 +5651,10 @@ void CRFProcess::AddFCT_CorrectionVector()
 				val = this->m_num->fct_const_alpha * f;
 
 #ifdef USE_PETSC
-			if (i < (size_t)m_msh->getNumNodesLocal())
+			if (i < m_msh->getNumNodesLocal())
 				eqs_new->add_bVectorEntry(i_global, val, ADD_VALUES);
 #else
-			eqs_rhs[i] += val;
+			eqs_rhs[eqs_index[i]] += val;
 #endif
 
 			// Note: Galerkin FEM is recovered if alpha = 1 as below,
@@ -5607,6 +5787,11 @@ void CRFProcess::GlobalAssembly()
 else
 #endif //#if !defined(USE_PETSC) // && !defined(other parallel libs)//03.3012. WW
 { // STD
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	// A linear operator of the last assembly replaces the element loop
+	const bool operator_reused = AssembleFromOperatorCache();
+	if (!operator_reused)
+#endif
 	// YDTEST. Changed to DOF 15.02.2007 WW
 	for (size_t ii = 0; ii < continuum_vector.size(); ii++)
 	{
@@ -5633,6 +5818,13 @@ else
 		}
 	}
 
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	if (_operator_recording) // The element loop has filled the cache
+	{
+		_operator_recording = false;
+		_operator_valid = true;
+	}
+#endif
 	if (femFCTmode) // NW
 		AddFCT_CorrectionVector();
 
@@ -5702,6 +5894,157 @@ cpu_time_assembly += v2 - v1;
 #endif
 }
 
+#if defined(NEW_EQS) && !defined(USE_MPI)
+/*!  \brief Check if the mass and stiffness matrices of the process are
+      constant, i.e. a linear process with $OPERATOR_REUSE: groundwater
+      flow, heat or mass transport with Picard iterations, no element
+      deactivation or excavation and no terms which are assembled
+      beside the mass and stiffness matrices. The material parameters
+      must not depend on time or on the solution, this is not checked.
+      Changes of the velocity field are detected by AssembleFromOperatorCache().
+ */
+bool CRFProcess::isOperatorConstant() const
+{
+	if (m_num->operator_reuse < 1)
+		return false;
+	const FiniteElement::ProcessType pcs_type = getProcessType();
+	if (pcs_type != FiniteElement::GROUNDWATER_FLOW && pcs_type != FiniteElement::HEAT_TRANSPORT
+	    && pcs_type != FiniteElement::MASS_TRANSPORT)
+		return false;
+	if (tim_type == TimType::STEADY || Tim->time_control_type == TimeControlType::NEUMANN)
+		return false;
+	if (m_num->nls_method > 0 || femFCTmode || continuum_vector.size() != 1 || Write_Matrix)
+		return false;
+	if (hasAnyProcessDeactivatedSubdomains || NumDeactivated_SubDomains > 0 || ExcavMaterialGroup > -1)
+		return false;
+	// Strain coupling in the flow equation
+	for (std::size_t i = 0; i < pcs_vector.size(); i++)
+		if (isDeformationProcess(pcs_vector[i]->getProcessType()))
+			return false;
+
+	if (pcs_type == FiniteElement::HEAT_TRANSPORT)
+	{
+		// Pressure and evaporation terms of the heat transport RHS
+		for (std::size_t i = 0; i < mmp_vector.size(); i++)
+			if (mmp_vector[i]->heat_diffusion_model == 1 || mmp_vector[i]->evaporation == 647)
+				return false;
+	}
+	else if (pcs_type == FiniteElement::MASS_TRANSPORT)
+	{
+		// Only linear sorption
+		if (cp_vec[pcs_component_number]->isotherm_model > 1)
+			return false;
+#ifdef GEM_REACT
+		return false; // Porosity is updated by GEMS
+#endif
+	}
+	return true;
+}
+
+/*!  \brief Checksum of the Gauss point velocities for the detection of a
+      changed velocity field. Two sums, one of them weighted by the
+      position, so that a permutation of the values is detected, too.
+ */
+void CRFProcess::getVelocityChecksum(double* checksum) const
+{
+	checksum[0] = checksum[1] = 0.0;
+	for (std::size_t e = 0; e < ele_gp_value.size(); e++)
+	{
+		const ElementValue* gp_ele = ele_gp_value[e];
+		if (!gp_ele)
+			continue;
+		const double* v = gp_ele->Velocity.getEntryArray();
+		const std::size_t n = gp_ele->Velocity.Size();
+		for (std::size_t i = 0; i < n; i++)
+		{
+			checksum[0] += v[i];
+			checksum[1] += v[i] * static_cast<double>(i % 31 + 1);
+		}
+		const double* vg = gp_ele->Velocity_g.getEntryArray();
+		const std::size_t ng = gp_ele->Velocity_g.Size();
+		for (std::size_t i = 0; i < ng; i++)
+		{
+			checksum[0] += vg[i];
+			checksum[1] += vg[i] * static_cast<double>(i % 29 + 1);
+		}
+	}
+}
+
+/*!  \brief Assemble the global system from the kept mass and stiffness
+      matrices:
+        A = M/dt + theta K
+        b = (M/dt - (1-theta) K) u0
+      Only dt may differ from the step where the matrices were recorded.
+      If the operator is not valid, the element loop of this assembly
+      records it. Returns true if the element loop can be skipped.
+ */
+bool CRFProcess::AssembleFromOperatorCache()
+{
+	_operator_recording = false;
+	if (!isOperatorConstant())
+	{
+		_operator_valid = false;
+		return false;
+	}
+
+	double checksum[2] = {0.0, 0.0};
+	if (getProcessType() != FiniteElement::GROUNDWATER_FLOW)
+		getVelocityChecksum(checksum);
+	if (checksum[0] != _operator_velocity_checksum[0] || checksum[1] != _operator_velocity_checksum[1])
+		_operator_valid = false;
+
+	if (!_operator_valid)
+	{
+		if (!_operator_mass)
+		{
+			_operator_mass = new Math_Group::CSparseMatrix(*m_msh->GetSparseTable(), eqs_new->A->Dof());
+			_operator_stiffness = new Math_Group::CSparseMatrix(*m_msh->GetSparseTable(), eqs_new->A->Dof());
+		}
+		(*_operator_mass) = 0.0;
+		(*_operator_stiffness) = 0.0;
+		_operator_velocity_checksum[0] = checksum[0];
+		_operator_velocity_checksum[1] = checksum[1];
+		_operator_recording = true;
+		return false;
+	}
+
+	// Time weighting as in the element assembly
+	double theta = m_num->ls_theta;
+	if (getProcessType() == FiniteElement::GROUNDWATER_FLOW)
+	{
+		theta = m_num->nls_relaxation;
+		if (theta < DBL_MIN)
+			theta = 1.0;
+	}
+	const double dt_inverse = 1.0 / Tim->time_step_length;
+	eqs_new->A->SetLinearCombination(dt_inverse, *_operator_mass, theta, *_operator_stiffness);
+
+	// u0 in the order of the equations
+	const long n_eqs = eqs_new->A->Dim();
+	_operator_buffer.resize(3 * n_eqs);
+	double* u0 = &_operator_buffer[0];
+	double* mu0 = u0 + n_eqs;
+	double* ku0 = mu0 + n_eqs;
+	const int idx0 = GetNodeValueIndex(pcs_primary_function_name[0]);
+	const double* u0_nodes = nod_val_vector[idx0];
+	for (std::size_t i = 0; i < m_msh->GetNodesNumber(false); i++)
+		u0[m_msh->nod_vector[i]->GetEquationIndex()] = u0_nodes[i];
+
+	double* b = eqs_new->b;
+	_operator_mass->multiVec(u0, mu0);
+	if (theta < 1.0)
+	{
+		_operator_stiffness->multiVec(u0, ku0);
+		for (long i = 0; i < n_eqs; i++)
+			b[i] += dt_inverse * mu0[i] - (1.0 - theta) * ku0[i];
+	}
+	else
+		for (long i = 0; i < n_eqs; i++)
+			b[i] += dt_inverse * mu0[i];
+	return true;
+}
+#endif
+
 //--------------------------------------------------------------------
 /*! \brief Assmble eqiations
      for all PDEs excluding deformation;
@@ -6439,6 +6782,24 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 	}
 #endif // END: #if !defined(USE_PETSC) // && !defined(other parallel libs)
 
+	// The BC nodes of one BC are stored one after the other and mostly share
+	// the time curve or function. Quantities which depend on the BC, the curve
+	// or the function only are evaluated once per run of nodes, not per node.
+	CBoundaryCondition* last_bc = NULL;
+	bool bc_time_active = true;
+	bool bc_on_domain = false;
+	int bc_pv_idx = -1;
+	int bc_cond_idx = -1;
+	bool bc_pv_idx_set = false;
+	bool bc_cond_idx_set = false;
+	int last_curve = 0;
+	double curve_fac = 1.0;
+	int curve_valid = 1;
+	std::string last_fct_name;
+	double fct_fac = 1.0;
+	bool excav_resolved = false;
+	double excav_depth = 0.0;
+
 	// update nod velocity before eval of constrained BC
 	if ((this->hasConstrainedBC() || this->hasConstrainedST())
 	    && (this->getProcessType() == FiniteElement::RICHARDS_FLOW
@@ -6448,6 +6809,24 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 		this->Extropolation_GaussValue();
 	}
 
+#if !defined(USE_PETSC) // && !defined(other parallel libs)
+	// Picard iterations of the same time step apply the plan of the first one.
+	// Newton increments depend on the current solution.
+	bool plan_reusable = (rank == -1 && m_num->nls_method == 0 && !(type == 4 || type / 10 == 4));
+	if (plan_reusable && _bc_plan_valid && _bc_plan_time == aktuelle_zeit && _bc_plan_size == bc_node_value.size())
+	{
+#ifdef NEW_EQS
+		ApplyBoundaryConditionPlan(eqs_p);
+#else
+		ApplyBoundaryConditionPlan(eqs_rhs);
+#endif
+		return;
+	}
+	_bc_plan_valid = false;
+	_bc_plan_eqs_index.clear();
+	_bc_plan_value.clear();
+#endif
+
 	for (i = begin; i < end; i++)
 	{
 		gindex = i;
@@ -6458,10 +6837,24 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 		m_bc_node = bc_node_value[gindex];
 		m_bc = bc_node[gindex];
 		//
-		// WX: check if bc is aktive, when Time_Controlled_Aktive for this bc is defined
-		if (m_bc->getTimeContrCurve() > 0)
-			if (GetCurveValue(m_bc->getTimeContrCurve(), 0, aktuelle_zeit, &valid) < MKleinsteZahl)
-				continue;
+		if (m_bc != last_bc)
+		{
+			last_bc = m_bc;
+			// WX: check if bc is aktive, when Time_Controlled_Aktive for this bc is defined
+			bc_time_active = !(m_bc->getTimeContrCurve() > 0
+			                   && GetCurveValue(m_bc->getTimeContrCurve(), 0, aktuelle_zeit, &valid) < MKleinsteZahl);
+			bc_on_domain = m_bc->getGeoTypeAsString().compare("DOMAIN") == 0;
+			bc_pv_idx_set = false;
+			bc_cond_idx_set = false;
+#if !defined(USE_PETSC)
+			// BCs which depend on the solution or on the element states
+			if (m_bc->getExcav() > 0 || bc_on_domain || m_bc->getPressureAsHeadModel() != -1 || m_bc->isSwitchBC()
+			    || m_bc->isConstrainedBC())
+				plan_reusable = false;
+#endif
+		}
+		if (!bc_time_active)
+			continue;
 
 		// WX: 01.2011. for excavation bc, check if excavated and if on boundary
 		if (m_bc->getExcav() > 0)
@@ -6475,13 +6868,16 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 
 			node = m_msh->nod_vector[m_bc_node->geo_node_number];
 			double const* node_coordinate(node->getData()); // Coordinates(node_coordinate);
+			if (!excav_resolved)
+			{
+				excav_depth = GetCurveValue(ExcavCurve, 0, aktuelle_zeit, &valid);
+				excav_resolved = true;
+			}
 
 			if ((node_coordinate[ExcavDirection] >= ExcavBeginCoordinate
-			     && (GetCurveValue(ExcavCurve, 0, aktuelle_zeit, &valid) + ExcavBeginCoordinate)
-			            >= node_coordinate[ExcavDirection])
+			     && (excav_depth + ExcavBeginCoordinate) >= node_coordinate[ExcavDirection])
 			    || (node_coordinate[ExcavDirection] < ExcavBeginCoordinate
-			        && (GetCurveValue(ExcavCurve, 0, aktuelle_zeit, &valid) + ExcavBeginCoordinate)
-			               < node_coordinate[ExcavDirection]))
+			        && (excav_depth + ExcavBeginCoordinate) < node_coordinate[ExcavDirection]))
 			{
 				excavated = true;
 #ifndef USE_PETSC
@@ -6497,9 +6893,7 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 						onExBoundary = true;
 						break;
 					}
-					else if (tmp_ele_coor[ExcavDirection]
-					             - (GetCurveValue(ExcavCurve, 0, aktuelle_zeit, &valid) - ExcavBeginCoordinate)
-					         > -0.001)
+					else if (tmp_ele_coor[ExcavDirection] - (excav_depth - ExcavBeginCoordinate) > -0.001)
 					{
 						onExBoundary = true;
 						// tmp_counter1++;
@@ -6512,7 +6906,7 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 
 		if ((m_bc->getExcav() > 0) && !excavated) // WX:01.2011. excav bc but is not excavated jet
 			continue;
-		if (m_bc->getGeoTypeAsString().compare("DOMAIN") == 0) // WX
+		if (bc_on_domain) // WX
 		{
 			CNode* node;
 			CElem* elem;
@@ -6596,12 +6990,17 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 			curve = m_bc_node->CurveIndex;
 			if (curve > 0)
 			{
-				if (curve > 10000000) /// 16.08.2010. WW
-					time_fac = GetCurveValue(curve - 10000000, interp_method, aktuelle_zeit, &valid);
-				else
-					time_fac = GetCurveValue(curve, interp_method, aktuelle_zeit, &valid);
-				if (!valid)
+				if (curve != last_curve)
+				{
+					last_curve = curve;
+					if (curve > 10000000) /// 16.08.2010. WW
+						curve_fac = GetCurveValue(curve - 10000000, interp_method, aktuelle_zeit, &curve_valid);
+					else
+						curve_fac = GetCurveValue(curve, interp_method, aktuelle_zeit, &curve_valid);
+				}
+				if (!curve_valid)
 					continue;
+				time_fac = curve_fac;
 			}
 			else
 				time_fac = 1.0;
@@ -6609,9 +7008,15 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 			// Time dependencies - FCT
 			if (m_bc_node->fct_name.length() > 0)
 			{
-				m_fct = FCTGet(m_bc_node->fct_name);
+				if (m_bc_node->fct_name != last_fct_name)
+				{
+					last_fct_name = m_bc_node->fct_name;
+					m_fct = FCTGet(m_bc_node->fct_name);
+					if (m_fct)
+						fct_fac = m_fct->GetValue(aktuelle_zeit, &is_valid);
+				}
 				if (m_fct)
-					time_fac = m_fct->GetValue(aktuelle_zeit, &is_valid);
+					time_fac = fct_fac;
 				// if(!valid) continue;
 				else
 					cout << "Warning in CRFProcess::IncorporateBoundaryConditions - no FCT data"
@@ -6621,6 +7026,9 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 			// copy values SB 09.2012
 			if (m_bc_node->bc_node_copy_geom.length() > 0)
 			{
+#if !defined(USE_PETSC)
+				plan_reusable = false;
+#endif
 				size_t geo_node_id;
 				// std::string geo_file_name = (std::string)this->m_msh->_geo_name;
 				GEOLIB::GEOObjects* geo_obj;
@@ -6652,16 +7060,23 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 			// Conditions
 			if (m_bc_node->conditional)
 			{
-				int idx_1 = -1; // 28.2.2007 WW
-				for (ii = 0; ii < dof; ii++) // 28.2.2007 WW
+#if !defined(USE_PETSC)
+				plan_reusable = false;
+#endif
+				if (!bc_cond_idx_set)
+				{
+					bc_cond_idx_set = true;
+					bc_cond_idx = -1; // 28.2.2007 WW
+					for (ii = 0; ii < dof; ii++) // 28.2.2007 WW
 
-					if (convertPrimaryVariableToString(m_bc->getProcessPrimaryVariable())
-					        .find(pcs_primary_function_name[ii]) != string::npos)
-					{
-						idx_1 = GetNodeValueIndex(pcs_primary_function_name[ii]) + 1;
-						break;
-					}
-				bc_value = time_fac * fac * GetNodeValue(m_bc_node->msh_node_number_subst, idx_1);
+						if (convertPrimaryVariableToString(m_bc->getProcessPrimaryVariable())
+						        .find(pcs_primary_function_name[ii]) != string::npos)
+						{
+							bc_cond_idx = GetNodeValueIndex(pcs_primary_function_name[ii]) + 1;
+							break;
+						}
+				}
+				bc_value = time_fac * fac * GetNodeValue(m_bc_node->msh_node_number_subst, bc_cond_idx);
 			}
 			else
 			{
@@ -6704,7 +7119,12 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 			    || type == 4
 			    || type / 10 == 4)
 			{ // Solution is in the manner of increment !
-				idx0 = GetNodeValueIndex(convertPrimaryVariableToString(m_bc->getProcessPrimaryVariable()));
+				if (!bc_pv_idx_set)
+				{
+					bc_pv_idx = GetNodeValueIndex(convertPrimaryVariableToString(m_bc->getProcessPrimaryVariable()));
+					bc_pv_idx_set = true;
+				}
+				idx0 = bc_pv_idx;
 				if (m_bc_node->pcs_pv_name.find("DISPLACEMENT") != string::npos)
 				{
 					bc_value -= GetNodeValue(m_bc_node->geo_node_number, idx0)
@@ -6784,11 +7204,8 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 				{
 					if (excavated && !onExBoundary)
 					{
-#ifdef NEW_EQS
-						eqs_p->SetKnownX_i(bc_eqs_index, bc_value); // WX:12.2012
-#else
-							MXRandbed(bc_eqs_index, bc_value, eqs_rhs);
-#endif
+						_bc_plan_eqs_index.push_back(bc_eqs_index); // WX:12.2012
+						_bc_plan_value.push_back(bc_value);
 						continue; // WX:09.2011
 					}
 					else if (m_bc_node->pcs_pv_name.find("DISPLACEMENT") != string::npos)
@@ -6811,16 +7228,28 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 				    static_cast<int>(m_msh->nod_vector[bc_msh_node]->GetEquationIndex() * dof_per_node + shift));
 				bc_eqs_value.push_back(bc_value);
 
-#elif defined(NEW_EQS) // WW
-			eqs_p->SetKnownX_i(bc_eqs_index, bc_value);
 #else
-			MXRandbed(bc_eqs_index, bc_value, eqs_rhs);
+			_bc_plan_eqs_index.push_back(bc_eqs_index);
+			_bc_plan_value.push_back(bc_value);
 #endif
 #ifdef JFNK_H2M
 			}
 #endif
 		}
 	}
+#if !defined(USE_PETSC) // && !defined(other parallel libs)
+#ifdef NEW_EQS
+	ApplyBoundaryConditionPlan(eqs_p);
+#else
+	ApplyBoundaryConditionPlan(eqs_rhs);
+#endif
+	if (plan_reusable)
+	{
+		_bc_plan_valid = true;
+		_bc_plan_time = aktuelle_zeit;
+		_bc_plan_size = bc_node_value.size();
+	}
+#endif
 #if defined(USE_PETSC) // || defined(other parallel libs)//03~04.3012. WW
 	int nbc = static_cast<int>(bc_eqs_id.size());
 	if (nbc > 0)
@@ -6878,6 +7307,27 @@ void CRFProcess::IncorporateBoundaryConditions(const int rank)
 #endif
 }
 
+#if !defined(USE_PETSC) // && !defined(other parallel libs)
+/**************************************************************************
+   FEMLib-Method: CRFProcess::ApplyBoundaryConditionPlan
+   Task: set the Dirichlet values of the BC plan in the equation system,
+         in the order in which IncorporateBoundaryConditions found them
+**************************************************************************/
+#ifdef NEW_EQS
+void CRFProcess::ApplyBoundaryConditionPlan(Linear_EQS* eqs_p) const
+{
+	for (size_t k = 0; k < _bc_plan_eqs_index.size(); k++)
+		eqs_p->SetKnownX_i(_bc_plan_eqs_index[k], _bc_plan_value[k]);
+}
+#else
+void CRFProcess::ApplyBoundaryConditionPlan(double* eqs_rhs) const
+{
+	for (size_t k = 0; k < _bc_plan_eqs_index.size(); k++)
+		MXRandbed(_bc_plan_eqs_index[k], _bc_plan_value[k], eqs_rhs);
+}
+#endif
+#endif
+
 /**************************************************************************
    FEMLib-Method: CRFProcess::IncorporateBoundaryConditions
    Task: set PCS boundary conditions for FLUID_MOMENTUM depending on axis
@@ -8126,6 +8576,7 @@ void CRFProcess::IncorporateSourceTerms(const int rank)
 				st_eqs_id.push_back(static_cast<int>(m_msh->nod_vector[glocalindex]->GetEquationIndex()));
 				st_eqs_value.push_back(Water_ST_vec[gindex].water_st_value);
 #else
+				// Index of the domain equation system, not changed by $EQS_RENUMBERING
 				eqs_rhs[glocalindex] += Water_ST_vec[gindex].water_st_value;
 #endif
 			}
@@ -8137,7 +8588,7 @@ void CRFProcess::IncorporateSourceTerms(const int rank)
 				st_eqs_value.push_back(Water_ST_vec[i].water_st_value);
 
 #else
-				eqs_rhs[gem_node_index] += Water_ST_vec[i].water_st_value;
+				eqs_rhs[m_msh->nod_vector[gem_node_index]->GetEquationIndex()] += Water_ST_vec[i].water_st_value;
 #endif
 			}
 		}
@@ -9690,6 +10141,18 @@ double CRFProcess::ExecuteNonLinear(int loop_process_number, bool print_pcs)
 	if (nl_theta < DBL_EPSILON)
 		nl_theta = 1.0;
 	g_nnodes = m_msh->GetNodesNumber(false);
+	// Anderson or Aitken acceleration of the Picard iterations. The history starts anew for each call.
+	if (m_num->nls_method == 0 && m_num->nls_acceleration != FiniteElement::FixedPointAccelerator::NONE)
+	{
+		if (!nls_accelerator)
+			nls_accelerator = new FiniteElement::FixedPointAccelerator(m_num->nls_acceleration,
+			                                                           m_num->nls_acceleration_depth, nl_theta);
+		nls_accelerator->reset();
+	}
+#if !defined(USE_PETSC) // && !defined(other parallel libs)
+	// The BC plan is compiled anew by the first iteration
+	_bc_plan_valid = false;
+#endif
 
 #if defined(USE_PETSC) // || defined(other parallel libs)//03.3012. WW
 	eqs_x = eqs_new->GetGlobalSolution();
@@ -10379,6 +10842,83 @@ void CRFProcess::CopyCouplingNODValues()
 	}
 }
 
+/**************************************************************************
+   FEMLib-Method:
+   Task: Picard update of the primary variables with Anderson or Aitken
+         acceleration. The current node values are the iterate x, the
+         solution of the linear system is its image G(x).
+**************************************************************************/
+void CRFProcess::AcceleratePicardIteration(double* eqs_x)
+{
+	const long g_nnodes = (long)m_msh->GetNodesNumber(false);
+	std::vector<double> x(g_nnodes * pcs_number_of_primary_nvals);
+	std::vector<double> g(x.size());
+	for (int ii = 0; ii < pcs_number_of_primary_nvals; ii++)
+	{
+		const int nidx1 = GetNodeValueIndex(pcs_primary_function_name[ii]) + 1;
+		const long nshift = ii * g_nnodes;
+		for (long j = 0; j < g_nnodes; j++)
+		{
+#if defined(USE_PETSC) // || defined(other parallel libs)
+			x[j + nshift] = GetNodeValue(j, nidx1);
+			g[j + nshift] = eqs_x[pcs_number_of_primary_nvals * m_msh->Eqs2Global_NodeIndex[j] + ii];
+#else
+			x[j + nshift] = GetNodeValue(m_msh->Eqs2Global_NodeIndex[j], nidx1);
+			g[j + nshift] = eqs_x[j + nshift];
+#endif
+		}
+	}
+
+	nls_accelerator->update(x, g);
+
+	for (int ii = 0; ii < pcs_number_of_primary_nvals; ii++)
+	{
+		const int nidx1 = GetNodeValueIndex(pcs_primary_function_name[ii]) + 1;
+		const long nshift = ii * g_nnodes;
+		for (long j = 0; j < g_nnodes; j++)
+		{
+#if defined(USE_PETSC) // || defined(other parallel libs)
+			SetNodeValue(j, nidx1, g[j + nshift]);
+			// Used for time stepping, see Execute()
+			eqs_x[pcs_number_of_primary_nvals * m_msh->Eqs2Global_NodeIndex[j] + ii] = x[j + nshift];
+#else
+			SetNodeValue(m_msh->Eqs2Global_NodeIndex[j], nidx1, g[j + nshift]);
+			eqs_x[j + nshift] = x[j + nshift]; // Used for time stepping, see Execute()
+#endif
+		}
+	}
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Gather and scatter the new time level values of the primary
+         variables, e.g. for the acceleration of the coupling iterations
+**************************************************************************/
+void CRFProcess::GetPrimaryNODValues(std::vector<double>& values)
+{
+	const bool quadratic = (type == 4 || type == 41);
+	const size_t n_nodes = m_msh->GetNodesNumber(quadratic);
+	for (int j = 0; j < pcs_number_of_primary_nvals; j++)
+	{
+		const int nidx1 = GetNodeValueIndex(pcs_primary_function_name[j]) + 1;
+		for (size_t l = 0; l < n_nodes; l++)
+			values.push_back(GetNodeValue(l, nidx1));
+	}
+}
+
+std::size_t CRFProcess::SetPrimaryNODValues(std::vector<double> const& values, std::size_t offset)
+{
+	const bool quadratic = (type == 4 || type == 41);
+	const size_t n_nodes = m_msh->GetNodesNumber(quadratic);
+	for (int j = 0; j < pcs_number_of_primary_nvals; j++)
+	{
+		const int nidx1 = GetNodeValueIndex(pcs_primary_function_name[j]) + 1;
+		for (size_t l = 0; l < n_nodes; l++)
+			SetNodeValue(l, nidx1, values[offset++]);
+	}
+	return offset;
+}
+
 /**************************************************************************
    FEMLib-Method:
    Task:
@@ -10471,6 +11011,62 @@ void CRFProcess::CopyTimestepELEValues(bool forward)
 	}
 }
 
+/**************************************************************************
+   FEMLib-Method:
+   Task: Save the node and element values at the beginning of a time step.
+         The arrays are allocated in the first call and then only copied.
+   Programing:
+**************************************************************************/
+void CRFProcess::SaveTimeStepState()
+{
+	const size_t n_nodes = m_msh->NodesNumber_Quadratic;
+	const size_t n_ele_vals = ele_val_name_vector.size();
+	if (_saved_nod_val_vector.size() != nod_val_vector.size() || _saved_ele_val_vector.size() != ele_val_vector.size())
+	{
+		releaseTimeStepState();
+		for (size_t i = 0; i < nod_val_vector.size(); i++)
+			_saved_nod_val_vector.push_back(new double[n_nodes]);
+		for (size_t i = 0; i < ele_val_vector.size(); i++)
+			_saved_ele_val_vector.push_back(new double[n_ele_vals]);
+	}
+	for (size_t i = 0; i < nod_val_vector.size(); i++)
+		std::memcpy(_saved_nod_val_vector[i], nod_val_vector[i], n_nodes * sizeof(double));
+	for (size_t i = 0; i < ele_val_vector.size(); i++)
+		std::memcpy(_saved_ele_val_vector[i], ele_val_vector[i], n_ele_vals * sizeof(double));
+	_has_saved_state = true;
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: Roll back a rejected time step. The saved arrays become the
+         current ones, the values of the rejected step are overwritten by
+         the next SaveTimeStepState().
+   Programing:
+**************************************************************************/
+void CRFProcess::RestoreTimeStepState()
+{
+	if (!_has_saved_state)
+	{
+		// No snapshot, e.g. a process that was not active at the beginning of the step
+		CopyTimestepNODValues(false);
+		return;
+	}
+	nod_val_vector.swap(_saved_nod_val_vector);
+	ele_val_vector.swap(_saved_ele_val_vector);
+	_has_saved_state = false;
+}
+
+void CRFProcess::releaseTimeStepState()
+{
+	for (size_t i = 0; i < _saved_nod_val_vector.size(); i++)
+		delete[] _saved_nod_val_vector[i];
+	_saved_nod_val_vector.clear();
+	for (size_t i = 0; i < _saved_ele_val_vector.size(); i++)
+		delete[] _saved_ele_val_vector[i];
+	_saved_ele_val_vector.clear();
+	_has_saved_state = false;
+}
+
 /**************************************************************************
    FEMLib-Method:
    Task:
@@ -14236,7 +14832,7 @@ void CRFProcess::EQSInitialize()
 	eqs_new->Initialize();
 }
 
-#if defined(LIS) // 11.03.2008 WW
+#if !defined(USE_MPI)
 /*************************************************************************
    ROCKFLOW - Function: CRFProcess::
    Task:  //For fluid momentum,
@@ -14246,7 +14842,12 @@ void CRFProcess::EQSInitialize()
  **************************************************************************/
 void CRFProcess::EQSSolver(double* x)
 {
+#if defined(LIS) || defined(MKL)
 	eqs_new->Solver(this->m_num); // NW
+#else
+	eqs_new->ConfigNumerics(this->m_num);
+	eqs_new->Solver();
+#endif
 
 	// OK411
 	for (int i = 0; i < (int)m_msh->nod_vector.size(); ++i)
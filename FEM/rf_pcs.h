@@ -31,7 +31,7 @@
 #include "rf_num_new.h"
 #include "rf_tim_new.h"
 #include "conversion_rate.h" // HS, 10.2011
-#include "SparseMatrixDOK.h"
+#include "SparseMatrixCSR.h"
 
 #include "Eigen/Eigen"
 
@@ -65,6 +65,7 @@ class CFEMesh;
 namespace Math_Group
 {
 class Linear_EQS;
+class CSparseMatrix;
 }
 using Math_Group::Linear_EQS;
 #endif
@@ -258,10 +259,10 @@ protected: // WW
 	Math_Group::Vec* Gl_Vec; // NW
 	Math_Group::Vec* Gl_Vec1; // NW
 	Math_Group::Vec* Gl_ML; // NW
-	Math_Group::SparseMatrixDOK* FCT_AFlux; // NW
+	Math_Group::SparseMatrixCSR* FCT_AFlux; // NW
 #ifdef USE_PETSC
-	Math_Group::SparseMatrixDOK* FCT_K;
-	Math_Group::SparseMatrixDOK* FCT_d;
+	Math_Group::SparseMatrixCSR* FCT_K;
+	Math_Group::SparseMatrixCSR* FCT_d;
 #endif
 	/**
 	 * Storage type for all element matrices and vectors
@@ -326,6 +327,8 @@ public:
 	// 3 read and write
 	int reload;
 	long nwrite_restart;
+	// Restart data as one binary file with all node and element values
+	bool reload_binary;
 	void WriteRHS_of_ST_NeumannBC();
 	void ReadRHS_of_ST_NeumannBC();
 	void Write_Processed_BC(); // 05.08.2011. WW
@@ -346,6 +349,45 @@ public:
 	double* array_Fu_JFNK;
 	std::vector<bc_JFNK> BC_JFNK;
 #endif
+#if !defined(USE_PETSC) // && !defined(other parallel libs)
+	// Dirichlet BC plan: equation indices and values of the BC nodes in the
+	// order of application. It is compiled by IncorporateBoundaryConditions
+	// and reused by the next calls of the same time step if all BC values
+	// depend on the time only.
+	std::vector<long> _bc_plan_eqs_index;
+	std::vector<double> _bc_plan_value;
+	bool _bc_plan_valid;
+	double _bc_plan_time;
+	size_t _bc_plan_size;
+#ifdef NEW_EQS
+	void ApplyBoundaryConditionPlan(Linear_EQS* eqs_p) const;
+#else
+	void ApplyBoundaryConditionPlan(double* eqs_rhs) const;
+#endif
+#endif
+#if defined(NEW_EQS) && !defined(USE_MPI)
+	// Linear operator of the last assembly ($OPERATOR_REUSE). The global
+	// mass matrix M and stiffness matrix K (Laplace, advection, decay) are
+	// kept before BCs are applied. Later steps set A = M/dt + theta K and
+	// b = (M/dt - (1-theta) K) u0 without an element loop.
+	Math_Group::CSparseMatrix* _operator_mass;
+	Math_Group::CSparseMatrix* _operator_stiffness;
+	bool _operator_recording;
+	bool _operator_valid;
+	double _operator_velocity_checksum[2];
+	std::vector<double> _operator_buffer;
+	bool isOperatorConstant() const;
+	void getVelocityChecksum(double* checksum) const;
+	bool AssembleFromOperatorCache();
+
+public:
+	/// True while the element loop adds its matrices to the operator cache
+	bool isOperatorRecording() const { return _operator_recording; }
+	Math_Group::CSparseMatrix* getOperatorMass() const { return _operator_mass; }
+	Math_Group::CSparseMatrix* getOperatorStiffness() const { return _operator_stiffness; }
+	/// Element matrices which the cache can not represent, e.g. a saturation change
+	void cancelOperatorRecording() { _operator_recording = false; }
+#endif
 public:
 	// BG, DL Calculate phase transition of CO2
 	void CO2_H2O_NaCl_VLE_isobaric(double T, double P, Phase_Properties& vapor, Phase_Properties& liquid,
@@ -426,6 +468,8 @@ public:
 	// 11-OUT
 	void WriteSolution(); // WW
 	void ReadSolution(); // WW
+	void WriteSolution_BIN();
+	void ReadSolution_BIN();
 	//....................................................................
 	// 12-NUM
 	//....................................................................
@@ -611,6 +655,12 @@ public:
 private:
 	// PCH
 	std::vector<std::string> ele_val_name_vector;
+	/// Node and element values at the beginning of the time step, same layout as
+	/// nod_val_vector and ele_val_vector. Allocated once, reused in every step.
+	std::vector<double*> _saved_nod_val_vector;
+	std::vector<double*> _saved_ele_val_vector;
+	bool _has_saved_state;
+	void releaseTimeStepState();
 
 public:
 	std::vector<double*> ele_val_vector; // PCH
@@ -677,6 +727,16 @@ public:
 	// Coupling
 	// WW double CalcCouplingNODError(); //MB
 	void CopyCouplingNODValues();
+	/// Append the new time level values of the primary variables to values
+	void GetPrimaryNODValues(std::vector<double>& values);
+	/// Set the new time level values of the primary variables from values, starting at offset.
+	/// Returns the offset of the next process.
+	std::size_t SetPrimaryNODValues(std::vector<double> const& values, std::size_t offset);
+	/// Keep a copy of the node and element values at the beginning of a time step
+	virtual void SaveTimeStepState();
+	/// Roll a rejected time step back to the values of SaveTimeStepState().
+	/// The value arrays are swapped with the saved ones, nothing is recomputed.
+	virtual void RestoreTimeStepState();
 	// WWvoid CalcFluxesForCoupling(); //MB
 	// Configuration 2 - ELE
 	void ConfigELEValues1(void);
@@ -774,6 +834,7 @@ public:
 	int num_notsatisfied;
 	int iter_nlin;
 	int iter_nlin_max;
+	FiniteElement::FixedPointAccelerator* nls_accelerator; // Picard acceleration, NULL if not requested
 	int iter_lin;
 	int iter_lin_max;
 	int iter_outer_cpl; // JT2012
@@ -934,6 +995,8 @@ private:
 
 	double evaluteSwitchBC(CBoundaryCondition const& bc, CBoundaryConditionNode const& bc_node, double time_fac,
 	                       double fac);
+	// Accelerated Picard update of the primary variables from the solution eqs_x
+	void AcceleratePicardIteration(double* eqs_x);
 
 	int _pcs_constant_model;
 	double _pcs_constant_value;
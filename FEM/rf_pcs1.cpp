@@ -666,6 +666,84 @@ void CRFProcess::setSolver(petsc_group::PETScLinearSolver* petsc_solver)
 	                m_num->getLinearSolverName(),
 	                m_num->getPreconditionerName(),
 	                convertProcessTypeToString(this->getProcessType()) + "_");
+	eqs_new->setPreconditionerReuse(m_num->getPreconditionerReuse(), m_num->getPreconditionerReuseGrowth());
+}
+
+/*!
+   Exact number of nonzeros per owned linear node, i.e. per local matrix row
+   of a system with one unknown per node, counted from the node connectivity
+   of the subdomain mesh. The entries are ordered by equation index.
+
+   Returns false if the owned nodes do not form the contiguous block of
+   equation indices that follows the nodes of the lower ranks. Then the
+   uniform estimate is kept.
+*/
+static bool calNonZerosPerNode(MeshLib::CFEMesh* mesh, vector<PetscInt>& d_nnz, vector<PetscInt>& o_nnz)
+{
+	long nnl = mesh->getNumNodesLocal();
+	const size_t n_linear = mesh->GetNodesNumber(false);
+
+	long eq_min = 0;
+	long eq_max = -1;
+	for (long i = 0; i < nnl; i++)
+	{
+		const long eq = mesh->nod_vector[i]->GetEquationIndex();
+		if (i == 0 || eq < eq_min)
+			eq_min = eq;
+		if (eq > eq_max)
+			eq_max = eq;
+	}
+	long offset = 0;
+	MPI_Exscan(&nnl, &offset, 1, MPI_LONG, MPI_SUM, PETSC_COMM_WORLD);
+	int rank_p;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &rank_p);
+	if (rank_p == 0) // the receive buffer of rank 0 is undefined
+		offset = 0;
+
+	long nn = 0;
+	MPI_Allreduce(&nnl, &nn, 1, MPI_LONG, MPI_SUM, PETSC_COMM_WORLD);
+	int ok_l = (nnl == 0) || (eq_max - eq_min + 1 == nnl && eq_min == offset);
+	int ok = 0;
+	MPI_Allreduce(&ok_l, &ok, 1, MPI_INT, MPI_LAND, PETSC_COMM_WORLD);
+	if (!ok || nn != mesh->getNumNodesGlobal())
+		return false;
+
+	d_nnz.assign(nnl, 0);
+	o_nnz.assign(nnl, 0);
+	for (long i = 0; i < nnl; i++)
+	{
+		const MeshLib::CNode* node = mesh->nod_vector[i];
+		const vector<size_t>& connected_nodes = node->getConnectedNodes();
+		const long row = node->GetEquationIndex() - offset;
+		for (size_t k = 0; k < connected_nodes.size(); k++)
+		{
+			if (connected_nodes[k] >= n_linear)
+				continue;
+			const long eq = mesh->nod_vector[connected_nodes[k]]->GetEquationIndex();
+			if (eq >= offset && eq < offset + nnl)
+				d_nnz[row]++;
+			else
+				o_nnz[row]++;
+		}
+	}
+	return true;
+}
+
+/// Expand the nonzeros per node to a system with dof unknowns per node
+static void setNonZerosPerRow(PETScLinearSolver* eqs, const int dof, const vector<PetscInt>& node_d_nnz,
+                              const vector<PetscInt>& node_o_nnz)
+{
+	vector<PetscInt> d_nnz(node_d_nnz.size() * dof);
+	vector<PetscInt> o_nnz(node_o_nnz.size() * dof);
+	for (size_t i = 0; i < node_d_nnz.size(); i++)
+	{
+		for (int k = 0; k < dof; k++)
+		{
+			d_nnz[i * dof + k] = node_d_nnz[i] * dof;
+			o_nnz[i * dof + k] = node_o_nnz[i] * dof;
+		}
+	}
+	eqs->setPreallocation(d_nnz, o_nnz);
 }
 //------------------------------------------------------------
 /*!
@@ -683,11 +761,15 @@ void CreateEQS_LinearSolver()
 	CRFProcess* a_pcs = NULL;
 	FiniteElement::ProcessType pcs_type = MULTI_PHASE_FLOW;
 	MeshLib::CFEMesh* mesh = fem_msh_vector[0];
+	vector<PetscInt> node_d_nnz;
+	vector<PetscInt> node_o_nnz;
 
 	MPI_Comm_rank(PETSC_COMM_WORLD, &rank_p);
 	MPI_Comm_size(PETSC_COMM_WORLD, &size_p);
 
 	max_cnct_nodes = mesh->calMaximumConnectedNodes();
+	// Exact preallocation for the processes with unknowns at the linear nodes
+	const bool exact_nnz = calNonZerosPerNode(mesh, node_d_nnz, node_o_nnz);
 
 	const int nn = mesh->getNumNodesGlobal();
 	const int nn_q = mesh->getNumNodesGlobal_Q();
@@ -736,6 +818,8 @@ void CreateEQS_LinearSolver()
 			sparse_info[3] = mesh->getNumNodesLocal() * 2;
 
 			eqs = new PETScLinearSolver(2 * nn);
+			if (exact_nnz)
+				setNonZerosPerRow(eqs, 2, node_d_nnz, node_o_nnz);
 			eqs->Init(sparse_info);
 			eqs->set_rank_size(rank_p, size_p);
 		}
@@ -747,6 +831,8 @@ void CreateEQS_LinearSolver()
 			sparse_info[3] = mesh->getNumNodesLocal() * 3;
 
 			eqs = new PETScLinearSolver(3 * nn);
+			if (exact_nnz)
+				setNonZerosPerRow(eqs, 3, node_d_nnz, node_o_nnz);
 			eqs->Init(sparse_info);
 			eqs->set_rank_size(rank_p, size_p);
 		}
@@ -759,6 +845,8 @@ void CreateEQS_LinearSolver()
 			sparse_info[3] = mesh->getNumNodesLocal();
 
 			eqs = new PETScLinearSolver(nn);
+			if (exact_nnz)
+				setNonZerosPerRow(eqs, 1, node_d_nnz, node_o_nnz);
 			eqs->Init(sparse_info);
 			eqs->set_rank_size(rank_p, size_p);
 		}
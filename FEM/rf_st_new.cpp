@@ -75,6 +75,7 @@ last modified
 #include "InterpolationAlgorithms/PiecewiseLinearInterpolation.h"
 
 // FileIO
+#include "FEMIO/BinaryFieldIO.h"
 #include "FEMIO/GeoIO.h"
 #include "FEMIO/ProcessIO.h"
 #include "readNonBlankLineFromInputStream.h"
@@ -4197,6 +4198,27 @@ void CSourceTerm::DirectAssign(CRFProcess* m_pcs, long ShiftInNodeVector)
 		long n_index;
 		double n_val;
 
+		// Binary field file
+		if (FileIO::BinaryFieldIO::isBinaryFieldFile(fname))
+		{
+			std::vector<long> node_ids;
+			std::vector<double> node_values;
+			if (!FileIO::BinaryFieldIO::readNodeValues(fname, node_ids, node_values))
+				abort();
+			for (size_t i = 0; i < node_ids.size(); i++)
+			{
+				CNodeValue* m_nod_val(new CNodeValue());
+				m_nod_val->msh_node_number = node_ids[i] + ShiftInNodeVector;
+				m_nod_val->geo_node_number = node_ids[i];
+				m_nod_val->setProcessDistributionType(getProcessDistributionType());
+				m_nod_val->node_value = node_values[i];
+				m_nod_val->CurveIndex = CurveIndex;
+				m_pcs->st_node_value.push_back(m_nod_val);
+				m_pcs->st_node.push_back(this);
+			}
+			return;
+		}
+
 		//========================================================================
 		// File handling
 		std::ifstream d_file(fname.c_str(), std::ios::in);
@@ -110,9 +110,9 @@ int Signum(double x)
 **************************************************************************/
 double GetCurveValue(int kurve, int methode, double punkt, int* gueltig)
 {
-	static long anz;
+	long anz;
 	register long i;
-	static StuetzStellen* s;
+	StuetzStellen* s;
 
 	if (kurve == 0)
 	{
@@ -195,9 +195,9 @@ double GetCurveValue(int kurve, int methode, double punkt, int* gueltig)
 **************************************************************************/
 double GetCurveValueInverse(int kurve, int methode, double wert, int* gueltig)
 {
-	static long anz;
+	long anz;
 	register long i;
-	static StuetzStellen* s;
+	StuetzStellen* s;
 
 #ifdef ERROR_CONTROL
 	if ((kurve < 0) || (kurve >= anz_kurven))
@@ -293,10 +293,10 @@ double GetCurveValueInverse(int kurve, int methode, double wert, int* gueltig)
 **************************************************************************/
 double GetCurveDerivative(int kurve, int methode, double punkt, int* gueltig)
 {
-	static long anz;
+	long anz;
 	register long i;
-	static StuetzStellen* s;
-	static double w, s1, s2;
+	StuetzStellen* s;
+	double w, s1, s2;
 
 	if (kurve == 0)
 	{
@@ -397,10 +397,10 @@ double GetCurveDerivative(int kurve, int methode, double punkt, int* gueltig)
 **************************************************************************/
 double GetCurveInverseDerivative(int kurve, int methode, double wert, int* gueltig)
 {
-	static long anz;
+	long anz;
 	register long i;
-	static StuetzStellen* s;
-	static double w, s1, s2;
+	StuetzStellen* s;
+	double w, s1, s2;
 
 	if (kurve == 0)
 	{
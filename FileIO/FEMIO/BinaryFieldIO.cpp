@@ -0,0 +1,215 @@
+/*
+ * BinaryFieldIO.cpp
+ *
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+// STL
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// FileIO
+#include "BinaryFieldIO.h"
+
+namespace
+{
+const char field_magic[8] = {'O', 'G', 'S', 'F', 'I', 'E', 'L', 'D'};
+const uint32_t byte_order_mark = 0x01020304;
+const uint32_t field_version = 2;
+const uint32_t has_ids_flag = 1;
+
+template <class T>
+void swapBytes(T* data, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; i++)
+	{
+		unsigned char* bytes = reinterpret_cast<unsigned char*>(data + i);
+		std::reverse(bytes, bytes + sizeof(T));
+	}
+}
+
+template <class T>
+void writeBlock(std::ostream& os, T const* data, std::size_t n)
+{
+	if (n > 0)
+		os.write(reinterpret_cast<const char*>(data), n * sizeof(T));
+}
+
+/// Reads n entries and converts them to the byte order of the host
+class BlockReader
+{
+public:
+	BlockReader(std::istream& is, bool swap) : _is(is), _swap(swap) {}
+
+	template <class T>
+	bool operator()(T* data, std::size_t n)
+	{
+		if (n == 0)
+			return true;
+		_is.read(reinterpret_cast<char*>(data), n * sizeof(T));
+		if (static_cast<std::size_t>(_is.gcount()) != n * sizeof(T))
+			return false;
+		if (_swap)
+			swapBytes(data, n);
+		return true;
+	}
+
+private:
+	std::istream& _is;
+	const bool _swap;
+};
+}
+
+namespace FileIO
+{
+bool BinaryFieldIO::isBinaryFieldFile(std::string const& fname)
+{
+	std::ifstream is(fname.c_str(), std::ios::in | std::ios::binary);
+	char magic[8];
+	if (!is.read(magic, 8))
+		return false;
+	return std::memcmp(magic, field_magic, 8) == 0;
+}
+
+bool BinaryFieldIO::read(std::string const& fname, Association& association, std::string& name,
+                         std::vector<uint32_t>& ids, std::vector<double>& values)
+{
+	ids.clear();
+	values.clear();
+	std::ifstream is(fname.c_str(), std::ios::in | std::ios::binary);
+	if (!is.good())
+	{
+		std::cout << "Error in BinaryFieldIO::read: could not open file " << fname << "\n";
+		return false;
+	}
+
+	char magic[8];
+	uint32_t mark = 0;
+	if (!is.read(magic, 8) || std::memcmp(magic, field_magic, 8) != 0
+	    || !is.read(reinterpret_cast<char*>(&mark), sizeof(mark)))
+	{
+		std::cout << "Error in BinaryFieldIO::read: " << fname << " is not a binary field file"
+		          << "\n";
+		return false;
+	}
+	uint32_t swapped_mark = mark;
+	swapBytes(&swapped_mark, 1);
+	if (mark != byte_order_mark && swapped_mark != byte_order_mark)
+	{
+		std::cout << "Error in BinaryFieldIO::read: unknown byte order in " << fname << "\n";
+		return false;
+	}
+	BlockReader readBlock(is, mark != byte_order_mark);
+
+	uint32_t header[4]; // version, association, flags, name length
+	uint64_t n = 0;
+	if (!readBlock(header, 4) || !readBlock(&n, 1))
+	{
+		std::cout << "Error in BinaryFieldIO::read: " << fname << " is truncated"
+		          << "\n";
+		return false;
+	}
+	if (header[0] != field_version || header[1] > ELEMENT)
+	{
+		std::cout << "Error in BinaryFieldIO::read: unsupported version or association in " << fname << "\n";
+		return false;
+	}
+
+	// The payload has to fill the rest of the file exactly. This also
+	// rejects counts that would overflow the allocation below.
+	const std::streampos payload_begin(is.tellg());
+	is.seekg(0, std::ios::end);
+	const uint64_t remaining = static_cast<uint64_t>(is.tellg() - payload_begin);
+	is.seekg(payload_begin);
+	const uint64_t value_size = sizeof(double) + ((header[2] & has_ids_flag) ? sizeof(uint32_t) : 0);
+	if (remaining < header[3] || (remaining - header[3]) % value_size != 0
+	    || (remaining - header[3]) / value_size != n)
+	{
+		std::cout << "Error in BinaryFieldIO::read: size of " << fname << " does not match its header ("
+		          << n << " values)"
+		          << "\n";
+		return false;
+	}
+	association = static_cast<Association>(header[1]);
+
+	std::vector<char> name_buffer(header[3]);
+	values.resize(static_cast<std::size_t>(n));
+	bool ok = readBlock(name_buffer.empty() ? NULL : &name_buffer[0], name_buffer.size());
+	if (ok && (header[2] & has_ids_flag))
+	{
+		ids.resize(values.size());
+		ok = readBlock(ids.empty() ? NULL : &ids[0], ids.size());
+	}
+	if (ok)
+		ok = readBlock(values.empty() ? NULL : &values[0], values.size());
+	if (!ok)
+	{
+		std::cout << "Error in BinaryFieldIO::read: " << fname << " is truncated"
+		          << "\n";
+		ids.clear();
+		values.clear();
+		return false;
+	}
+	name.assign(name_buffer.begin(), name_buffer.end());
+	return true;
+}
+
+bool BinaryFieldIO::readNodeValues(std::string const& fname, std::vector<long>& node_ids,
+                                   std::vector<double>& values)
+{
+	Association association;
+	std::string name;
+	std::vector<uint32_t> ids;
+	if (!read(fname, association, name, ids, values))
+		return false;
+	if (association != NODE)
+	{
+		std::cout << "Error in BinaryFieldIO::readNodeValues: " << fname << " does not hold node values"
+		          << "\n";
+		values.clear();
+		return false;
+	}
+	node_ids.resize(values.size());
+	for (std::size_t i = 0; i < node_ids.size(); i++)
+		node_ids[i] = ids.empty() ? static_cast<long>(i) : static_cast<long>(ids[i]);
+	return true;
+}
+
+bool BinaryFieldIO::write(std::string const& fname, Association association, std::string const& name,
+                          std::vector<uint32_t> const& ids, std::vector<double> const& values)
+{
+	if (!ids.empty() && ids.size() != values.size())
+	{
+		std::cout << "Error in BinaryFieldIO::write: number of ids and values differ"
+		          << "\n";
+		return false;
+	}
+	std::ofstream os(fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!os.good())
+	{
+		std::cout << "Error in BinaryFieldIO::write: could not open file " << fname << "\n";
+		return false;
+	}
+
+	uint32_t header[4];
+	header[0] = field_version;
+	header[1] = association;
+	header[2] = ids.empty() ? 0 : has_ids_flag;
+	header[3] = static_cast<uint32_t>(name.size());
+	const uint64_t n = values.size();
+	os.write(field_magic, 8);
+	writeBlock(os, &byte_order_mark, 1);
+	writeBlock(os, header, 4);
+	writeBlock(os, &n, 1);
+	os.write(name.data(), name.size());
+	writeBlock(os, ids.empty() ? NULL : &ids[0], ids.size());
+	writeBlock(os, values.empty() ? NULL : &values[0], values.size());
+	return os.good();
+}
+}
@@ -0,0 +1,83 @@
+/*
+ * BinaryFieldIO.h
+ *
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#ifndef BINARYFIELDIO_H_
+#define BINARYFIELDIO_H_
+
+// STL
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+namespace FileIO
+{
+/**
+ * Reader and writer for binary field files, i.e. one scalar value per mesh
+ * node or element. Such files can be given wherever an ASCII distribution
+ * file is accepted: heterogeneous medium properties, DIRECT initial
+ * conditions, and DIRECT boundary conditions and source terms.
+ *
+ * Layout (all integers have a fixed width, double is IEEE 754):
+ * \code
+ *  char[8]      magic "OGSFIELD"
+ *  uint32_t     byte order mark 0x01020304
+ *  uint32_t     version (2)
+ *  uint32_t     association (0: nodes, 1: elements)
+ *  uint32_t     flags (bit 0: explicit ids are stored)
+ *  uint32_t     length L of the field name
+ *  uint64_t     number of values N
+ *  char[L]      field name, e.g. PERMEABILITY
+ *  uint32_t[N]  node or element ids, only if flag bit 0 is set
+ *  double[N]    values
+ * \endcode
+ * Without explicit ids the i-th value belongs to the node/element with id i.
+ * The file is written in the byte order of the host, the byte order mark
+ * tells the reader whether it has to swap the bytes. The payload is read
+ * with one block read per array after N has been checked against the size
+ * of the file.
+ */
+class BinaryFieldIO
+{
+public:
+	enum Association
+	{
+		NODE = 0,
+		ELEMENT = 1
+	};
+
+	/// checks the magic of the file, returns false if the file is not readable
+	static bool isBinaryFieldFile(std::string const& fname);
+
+	/**
+	 * Reads a binary field file.
+	 * @param ids is cleared if the file does not store explicit ids
+	 * @return false (with a message on std::cout) if the file is missing or
+	 * corrupt, or if its size does not match the header
+	 */
+	static bool read(std::string const& fname, Association& association, std::string& name,
+	                 std::vector<uint32_t>& ids, std::vector<double>& values);
+
+	/**
+	 * Reads a node field as (node id, value) pairs, the form used by DIRECT
+	 * initial and boundary conditions and source terms. Ids are filled in
+	 * for densely stored fields.
+	 * @return false (with a message on std::cout) if the file cannot be read
+	 * or does not hold node values
+	 */
+	static bool readNodeValues(std::string const& fname, std::vector<long>& node_ids, std::vector<double>& values);
+
+	/// Writes a binary field file. If ids is empty the values are stored densely.
+	static bool write(std::string const& fname, Association association, std::string const& name,
+	                  std::vector<uint32_t> const& ids, std::vector<double> const& values);
+};
+}
+
+#endif /* BINARYFIELDIO_H_ */
@@ -0,0 +1,201 @@
+/*
+ * BinaryRestartIO.cpp
+ *
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+// STL
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// FileIO
+#include "BinaryRestartIO.h"
+
+namespace
+{
+const char restart_magic[8] = {'O', 'G', 'S', 'R', 'S', 'T', 'R', 'T'};
+const uint32_t byte_order_mark = 0x01020304;
+const uint32_t restart_version = 2;
+
+template <class T>
+void swapBytes(T* data, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; i++)
+	{
+		unsigned char* bytes = reinterpret_cast<unsigned char*>(data + i);
+		std::reverse(bytes, bytes + sizeof(T));
+	}
+}
+
+template <class T>
+void writeBlock(std::ostream& os, T const* data, std::size_t n)
+{
+	if (n > 0)
+		os.write(reinterpret_cast<const char*>(data), n * sizeof(T));
+}
+
+/// Reads n entries and converts them to the byte order of the host
+class BlockReader
+{
+public:
+	BlockReader(std::istream& is, bool swap) : _is(is), _swap(swap) {}
+
+	template <class T>
+	bool operator()(T* data, std::size_t n)
+	{
+		if (n == 0)
+			return true;
+		_is.read(reinterpret_cast<char*>(data), n * sizeof(T));
+		if (static_cast<std::size_t>(_is.gcount()) != n * sizeof(T))
+			return false;
+		if (_swap)
+			swapBytes(data, n);
+		return true;
+	}
+
+private:
+	std::istream& _is;
+	const bool _swap;
+};
+}
+
+namespace FileIO
+{
+bool BinaryRestartIO::write(std::string const& fname, Header const& header,
+                            std::vector<double const*> const& node_values, std::vector<double> const& element_values)
+{
+	if (node_values.size() != header.node_value_names.size()
+	    || element_values.size() != header.n_elements * header.n_element_values)
+	{
+		std::cout << "Error in BinaryRestartIO::write: sizes of the data and the header differ"
+		          << "\n";
+		return false;
+	}
+	std::ofstream os(fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!os.good())
+	{
+		std::cout << "Error in BinaryRestartIO::write: could not open file " << fname << "\n";
+		return false;
+	}
+
+	os.write(restart_magic, 8);
+	writeBlock(os, &byte_order_mark, 1);
+	writeBlock(os, &restart_version, 1);
+	writeBlock(os, &header.time_step, 1);
+	writeBlock(os, &header.time, 1);
+	writeBlock(os, &header.time_step_size, 1);
+
+	writeBlock(os, &header.n_nodes, 1);
+	const uint32_t n_node_values = static_cast<uint32_t>(header.node_value_names.size());
+	writeBlock(os, &n_node_values, 1);
+	for (uint32_t i = 0; i < n_node_values; i++)
+	{
+		const uint32_t length = static_cast<uint32_t>(header.node_value_names[i].size());
+		writeBlock(os, &length, 1);
+		os.write(header.node_value_names[i].data(), length);
+	}
+	writeBlock(os, &header.n_elements, 1);
+	writeBlock(os, &header.n_element_values, 1);
+
+	// One contiguous array per node value
+	for (uint32_t i = 0; i < n_node_values; i++)
+		writeBlock(os, node_values[i], header.n_nodes);
+	writeBlock(os, element_values.empty() ? NULL : &element_values[0], element_values.size());
+	return os.good();
+}
+
+bool BinaryRestartIO::read(std::string const& fname, Header& header, std::vector<double*> const& node_values,
+                           std::vector<double>& element_values)
+{
+	std::ifstream is(fname.c_str(), std::ios::in | std::ios::binary);
+	if (!is.good())
+	{
+		std::cout << "Error in BinaryRestartIO::read: could not open file " << fname << "\n";
+		return false;
+	}
+
+	char magic[8];
+	uint32_t mark = 0;
+	if (!is.read(magic, 8) || std::memcmp(magic, restart_magic, 8) != 0
+	    || !is.read(reinterpret_cast<char*>(&mark), sizeof(mark)))
+	{
+		std::cout << "Error in BinaryRestartIO::read: " << fname << " is not a restart file"
+		          << "\n";
+		return false;
+	}
+	uint32_t swapped_mark = mark;
+	swapBytes(&swapped_mark, 1);
+	if (mark != byte_order_mark && swapped_mark != byte_order_mark)
+	{
+		std::cout << "Error in BinaryRestartIO::read: unknown byte order in " << fname << "\n";
+		return false;
+	}
+	BlockReader readBlock(is, mark != byte_order_mark);
+
+	uint32_t version = 0;
+	if (!readBlock(&version, 1) || version != restart_version)
+	{
+		std::cout << "Error in BinaryRestartIO::read: " << fname << " is not a restart file of version "
+		          << restart_version << "\n";
+		return false;
+	}
+
+	Header stored;
+	uint32_t n_node_values = 0;
+	bool ok = readBlock(&stored.time_step, 1) && readBlock(&stored.time, 1) && readBlock(&stored.time_step_size, 1)
+	          && readBlock(&stored.n_nodes, 1) && readBlock(&n_node_values, 1);
+	for (uint32_t i = 0; ok && i < n_node_values; i++)
+	{
+		uint32_t length = 0;
+		ok = readBlock(&length, 1);
+		std::vector<char> name(length);
+		ok = ok && readBlock(name.empty() ? NULL : &name[0], length);
+		stored.node_value_names.push_back(std::string(name.begin(), name.end()));
+	}
+	ok = ok && readBlock(&stored.n_elements, 1) && readBlock(&stored.n_element_values, 1);
+	if (!ok)
+	{
+		std::cout << "Error in BinaryRestartIO::read: " << fname << " is truncated"
+		          << "\n";
+		return false;
+	}
+
+	if (stored.n_nodes != header.n_nodes || stored.node_value_names != header.node_value_names
+	    || node_values.size() != header.node_value_names.size())
+	{
+		std::cout << "Error in BinaryRestartIO::read: node data in " << fname
+		          << " do not match the mesh or the process"
+		          << "\n";
+		return false;
+	}
+	if (stored.n_elements != header.n_elements || stored.n_element_values != header.n_element_values)
+	{
+		std::cout << "Error in BinaryRestartIO::read: element data in " << fname
+		          << " do not match the mesh or the process"
+		          << "\n";
+		return false;
+	}
+
+	for (std::size_t i = 0; ok && i < node_values.size(); i++)
+		ok = readBlock(node_values[i], header.n_nodes);
+	element_values.resize(header.n_elements * header.n_element_values);
+	ok = ok && readBlock(element_values.empty() ? NULL : &element_values[0], element_values.size());
+	if (!ok)
+	{
+		std::cout << "Error in BinaryRestartIO::read: " << fname << " is truncated"
+		          << "\n";
+		return false;
+	}
+
+	header.time_step = stored.time_step;
+	header.time = stored.time;
+	header.time_step_size = stored.time_step_size;
+	return true;
+}
+}
@@ -0,0 +1,82 @@
+/*
+ * BinaryRestartIO.h
+ *
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#ifndef BINARYRESTARTIO_H_
+#define BINARYRESTARTIO_H_
+
+// STL
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+namespace FileIO
+{
+/**
+ * Reader and writer for the binary restart file of a process, i.e. all node
+ * values (both time levels, primary and secondary variables), the element
+ * values and the time stepping state.
+ *
+ * Layout (all integers have a fixed width, double is IEEE 754):
+ * \code
+ *  char[8]       magic "OGSRSTRT"
+ *  uint32_t      byte order mark 0x01020304
+ *  uint32_t      version (2)
+ *  int64_t       time step
+ *  double        time
+ *  double        time step size
+ *  uint64_t      number of nodes N
+ *  uint32_t      number of node values V
+ *  V times:      uint32_t name length L, char[L] name
+ *  uint64_t      number of elements E
+ *  uint32_t      number of values per element W
+ *  V times:      double[N]
+ *  double[E*W]   element values, element by element
+ * \endcode
+ * The file is written in the byte order of the host. The byte order mark
+ * tells the reader whether it has to swap the bytes.
+ */
+class BinaryRestartIO
+{
+public:
+	struct Header
+	{
+		Header() : time_step(0), time(0.0), time_step_size(0.0), n_nodes(0), n_elements(0), n_element_values(0) {}
+
+		int64_t time_step;
+		double time;
+		double time_step_size;
+		uint64_t n_nodes;
+		std::vector<std::string> node_value_names;
+		uint64_t n_elements;
+		uint32_t n_element_values;
+	};
+
+	/**
+	 * Writes a restart file.
+	 * @param node_values one array of header.n_nodes values per node value name
+	 * @param element_values header.n_elements * header.n_element_values values
+	 */
+	static bool write(std::string const& fname, Header const& header, std::vector<double const*> const& node_values,
+	                  std::vector<double> const& element_values);
+
+	/**
+	 * Reads a restart file into the given arrays. The sizes and names in
+	 * header describe the expected layout, the time stepping state is set
+	 * from the file.
+	 * @return false (with a message on std::cout) if the file is missing,
+	 * corrupt or does not match the expected layout
+	 */
+	static bool read(std::string const& fname, Header& header, std::vector<double*> const& node_values,
+	                 std::vector<double>& element_values);
+};
+}
+
+#endif /* BINARYRESTARTIO_H_ */
@@ -0,0 +1,243 @@
+/*
+ * KDTree.h
+ *
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#ifndef KDTREE_H_
+#define KDTREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace GEOLIB
+{
+/**
+ * \brief Static, balanced kd-tree over a set of points.
+ *
+ * The tree is built once from the given points (the coordinates are copied,
+ * the points themselves are not referenced afterwards) and answers nearest,
+ * k-nearest, sphere and box queries. All queries return indices into the
+ * point vector handed to the constructor. If several points have the same
+ * distance to the query point, the point with the smallest index wins, i.e.
+ * the results are the same as the ones of a linear search.
+ * The queries do not modify the tree and may be called concurrently.
+ *
+ * POINT has to provide read access to the coordinates via operator[].
+ */
+template <typename POINT>
+class KDTree
+{
+public:
+	explicit KDTree(std::vector<POINT*> const& pnts) : _coords(3 * pnts.size()), _ids(pnts.size()), _axis(pnts.size())
+	{
+		for (std::size_t k(0); k < pnts.size(); k++)
+		{
+			for (std::size_t i(0); i < 3; i++)
+				_coords[3 * k + i] = (*pnts[k])[i];
+			_ids[k] = k;
+		}
+		build(0, _ids.size());
+	}
+
+	std::size_t size() const { return _ids.size(); }
+
+	/**
+	 * Returns the index of the point nearest to pnt. The tree must not be empty.
+	 */
+	std::size_t getNearestPoint(double const* const pnt) const
+	{
+		std::pair<double, std::size_t> nearest(sqrDist(pnt, _ids[0]), _ids[0]);
+		searchNearest(0, _ids.size(), pnt, nearest);
+		return nearest.second;
+	}
+
+	/**
+	 * Computes the indices of the k points nearest to pnt, ordered by increasing distance.
+	 */
+	void getKNearestPoints(double const* const pnt, std::size_t k, std::vector<std::size_t>& ids) const
+	{
+		ids.clear();
+		if (k == 0)
+			return;
+		std::vector<std::pair<double, std::size_t> > heap;
+		heap.reserve(k + 1);
+		searchKNearest(0, _ids.size(), pnt, k, heap);
+		std::sort_heap(heap.begin(), heap.end());
+		for (std::size_t i(0); i < heap.size(); i++)
+			ids.push_back(heap[i].second);
+	}
+
+	/**
+	 * Computes the indices, in ascending order, of all points with distance
+	 * to pnt not larger than radius.
+	 */
+	void getPointsInSphere(double const* const pnt, double radius, std::vector<std::size_t>& ids) const
+	{
+		ids.clear();
+		searchSphere(0, _ids.size(), pnt, radius * radius, ids);
+		std::sort(ids.begin(), ids.end());
+	}
+
+	/**
+	 * Computes the indices, in ascending order, of all points within the
+	 * axis aligned box [min_pnt, max_pnt].
+	 */
+	void getPointsInBox(double const* const min_pnt, double const* const max_pnt, std::vector<std::size_t>& ids) const
+	{
+		ids.clear();
+		searchBox(0, _ids.size(), min_pnt, max_pnt, ids);
+		std::sort(ids.begin(), ids.end());
+	}
+
+private:
+	class CoordinateLess
+	{
+	public:
+		CoordinateLess(std::vector<double> const& coords, std::size_t axis) : _coords(coords), _axis(axis) {}
+		bool operator()(std::size_t a, std::size_t b) const
+		{
+			return _coords[3 * a + _axis] < _coords[3 * b + _axis];
+		}
+
+	private:
+		std::vector<double> const& _coords;
+		std::size_t _axis;
+	};
+
+	/// The median of the range [lo, hi) is the node, it splits along the axis of largest extent.
+	void build(std::size_t lo, std::size_t hi)
+	{
+		if (hi - lo < 2)
+		{
+			if (hi > lo)
+				_axis[lo] = 0;
+			return;
+		}
+		double min_pnt[3] = {_coords[3 * _ids[lo]], _coords[3 * _ids[lo] + 1], _coords[3 * _ids[lo] + 2]};
+		double max_pnt[3] = {min_pnt[0], min_pnt[1], min_pnt[2]};
+		for (std::size_t k(lo + 1); k < hi; k++)
+			for (std::size_t i(0); i < 3; i++)
+			{
+				const double c(_coords[3 * _ids[k] + i]);
+				min_pnt[i] = std::min(min_pnt[i], c);
+				max_pnt[i] = std::max(max_pnt[i], c);
+			}
+		std::size_t axis(0);
+		for (std::size_t i(1); i < 3; i++)
+			if (max_pnt[i] - min_pnt[i] > max_pnt[axis] - min_pnt[axis])
+				axis = i;
+
+		const std::size_t mid((lo + hi) / 2);
+		std::nth_element(_ids.begin() + lo, _ids.begin() + mid, _ids.begin() + hi, CoordinateLess(_coords, axis));
+		_axis[mid] = static_cast<unsigned char>(axis);
+		build(lo, mid);
+		build(mid + 1, hi);
+	}
+
+	double sqrDist(double const* const pnt, std::size_t id) const
+	{
+		double const* const c(&_coords[3 * id]);
+		return (pnt[0] - c[0]) * (pnt[0] - c[0]) + (pnt[1] - c[1]) * (pnt[1] - c[1]) + (pnt[2] - c[2]) * (pnt[2] - c[2]);
+	}
+
+	void searchNearest(std::size_t lo, std::size_t hi, double const* const pnt,
+	                   std::pair<double, std::size_t>& nearest) const
+	{
+		if (lo >= hi)
+			return;
+		const std::size_t mid((lo + hi) / 2);
+		const std::size_t id(_ids[mid]);
+		const std::pair<double, std::size_t> cand(sqrDist(pnt, id), id);
+		if (cand < nearest)
+			nearest = cand;
+		const double diff(pnt[_axis[mid]] - _coords[3 * id + _axis[mid]]);
+		if (diff < 0.0)
+		{
+			searchNearest(lo, mid, pnt, nearest);
+			if (diff * diff <= nearest.first)
+				searchNearest(mid + 1, hi, pnt, nearest);
+		}
+		else
+		{
+			searchNearest(mid + 1, hi, pnt, nearest);
+			if (diff * diff <= nearest.first)
+				searchNearest(lo, mid, pnt, nearest);
+		}
+	}
+
+	void searchKNearest(std::size_t lo, std::size_t hi, double const* const pnt, std::size_t k,
+	                    std::vector<std::pair<double, std::size_t> >& heap) const
+	{
+		if (lo >= hi)
+			return;
+		const std::size_t mid((lo + hi) / 2);
+		const std::size_t id(_ids[mid]);
+		const std::pair<double, std::size_t> cand(sqrDist(pnt, id), id);
+		if (heap.size() < k)
+		{
+			heap.push_back(cand);
+			std::push_heap(heap.begin(), heap.end());
+		}
+		else if (cand < heap.front())
+		{
+			std::pop_heap(heap.begin(), heap.end());
+			heap.back() = cand;
+			std::push_heap(heap.begin(), heap.end());
+		}
+		const double diff(pnt[_axis[mid]] - _coords[3 * id + _axis[mid]]);
+		const std::size_t first_lo(diff < 0.0 ? lo : mid + 1), first_hi(diff < 0.0 ? mid : hi);
+		const std::size_t second_lo(diff < 0.0 ? mid + 1 : lo), second_hi(diff < 0.0 ? hi : mid);
+		searchKNearest(first_lo, first_hi, pnt, k, heap);
+		if (heap.size() < k || diff * diff <= heap.front().first)
+			searchKNearest(second_lo, second_hi, pnt, k, heap);
+	}
+
+	void searchSphere(std::size_t lo, std::size_t hi, double const* const pnt, double sqr_radius,
+	                  std::vector<std::size_t>& ids) const
+	{
+		if (lo >= hi)
+			return;
+		const std::size_t mid((lo + hi) / 2);
+		const std::size_t id(_ids[mid]);
+		if (sqrDist(pnt, id) <= sqr_radius)
+			ids.push_back(id);
+		const double diff(pnt[_axis[mid]] - _coords[3 * id + _axis[mid]]);
+		if (diff <= 0.0 || diff * diff <= sqr_radius)
+			searchSphere(lo, mid, pnt, sqr_radius, ids);
+		if (diff >= 0.0 || diff * diff <= sqr_radius)
+			searchSphere(mid + 1, hi, pnt, sqr_radius, ids);
+	}
+
+	void searchBox(std::size_t lo, std::size_t hi, double const* const min_pnt, double const* const max_pnt,
+	               std::vector<std::size_t>& ids) const
+	{
+		if (lo >= hi)
+			return;
+		const std::size_t mid((lo + hi) / 2);
+		const std::size_t id(_ids[mid]);
+		double const* const c(&_coords[3 * id]);
+		if (min_pnt[0] <= c[0] && c[0] <= max_pnt[0] && min_pnt[1] <= c[1] && c[1] <= max_pnt[1]
+		    && min_pnt[2] <= c[2] && c[2] <= max_pnt[2])
+			ids.push_back(id);
+		const std::size_t axis(_axis[mid]);
+		if (min_pnt[axis] <= c[axis])
+			searchBox(lo, mid, min_pnt, max_pnt, ids);
+		if (max_pnt[axis] >= c[axis])
+			searchBox(mid + 1, hi, min_pnt, max_pnt, ids);
+	}
+
+	std::vector<double> _coords;
+	std::vector<std::size_t> _ids;
+	std::vector<unsigned char> _axis;
+};
+
+} // end namespace GEOLIB
+
+#endif /* KDTREE_H_ */
@@ -10,6 +10,7 @@
  *              http://www.opengeosys.org/project/license
  */
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib> // for exit
 
@@ -30,13 +31,13 @@
 
 namespace GEOLIB
 {
-Polygon::Polygon(const Polyline& ply, bool init) : Polyline(ply)
+Polygon::Polygon(const Polyline& ply, bool init) : Polyline(ply), _slab_y0(0.0), _slab_inv_height(0.0)
 {
 	if (init)
 		initialise();
 }
 
-Polygon::Polygon(const std::vector<Point*>& pnt_vec) : Polyline(pnt_vec)
+Polygon::Polygon(const std::vector<Point*>& pnt_vec) : Polyline(pnt_vec), _slab_y0(0.0), _slab_inv_height(0.0)
 {
 }
 
@@ -55,6 +56,7 @@ bool Polygon::initialise()
 	{
 		calculateAxisAlignedBoundingBox();
 		ensureCWOrientation();
+		buildSlabIndex();
 		return true;
 	}
 	else
@@ -78,9 +80,17 @@ bool Polygon::isPntInPolygon(GEOLIB::Point const& pnt) const
 
 	if (_simple_polygon_list.empty())
 	{
-		const size_t n_nodes(getNumberOfPoints() - 1);
-		for (size_t k(0); k < n_nodes; k++)
+		// all segments or only the segments of the slab containing the point
+		size_t j(0), j_end(getNumberOfPoints() - 1);
+		if (!_slab_offsets.empty())
+		{
+			const size_t slab(getSlab(pnt[1]));
+			j = _slab_offsets[slab];
+			j_end = _slab_offsets[slab + 1];
+		}
+		for (; j < j_end; j++)
 		{
+			const size_t k(_slab_offsets.empty() ? j : _slab_segments[j]);
 			if (((*(getPoint(k)))[1] <= pnt[1] && pnt[1] <= (*(getPoint(k + 1)))[1])
 			    || ((*(getPoint(k + 1)))[1] <= pnt[1] && pnt[1] <= (*(getPoint(k)))[1]))
 			{
@@ -121,6 +131,22 @@ bool Polygon::isPntInPolygon(double x, double y, double z) const
 	return isPntInPolygon(pnt);
 }
 
+void Polygon::getPntsInPolygon(std::vector<double const*> const& pnts, std::vector<std::size_t>& pnt_ids) const
+{
+	const long n_pnts(static_cast<long>(pnts.size()));
+	std::vector<char> is_inside(n_pnts, 0);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (long k = 0; k < n_pnts; k++)
+		is_inside[k] = isPntInPolygon(GEOLIB::Point(pnts[k]));
+
+	pnt_ids.clear();
+	for (long k = 0; k < n_pnts; k++)
+		if (is_inside[k])
+			pnt_ids.push_back(k);
+}
+
 bool Polygon::isPolylineInPolygon(const Polyline& ply) const
 {
 	size_t ply_size(ply.getNumberOfPoints()), cnt(0);
@@ -264,6 +290,63 @@ void Polygon::calculateAxisAlignedBoundingBox()
 		_aabb.update((*(getPoint(k))));
 }
 
+size_t Polygon::getSlab(double y) const
+{
+	const double s((y - _slab_y0) * _slab_inv_height);
+	if (!(s > 0.0))
+		return 0;
+	const size_t n_slabs(_slab_offsets.size() - 1);
+	return std::min(static_cast<size_t>(s), n_slabs - 1);
+}
+
+void Polygon::buildSlabIndex()
+{
+	_slab_offsets.clear();
+	_slab_segments.clear();
+	// a linear search is fast enough for small polygons
+	const size_t n_segments(getNumberOfPoints() - 1);
+	if (n_segments < 32)
+		return;
+
+	const double y_min(_aabb.getMinPoint()[1]);
+	const double height(_aabb.getMaxPoint()[1] - y_min);
+	if (!(height > 0.0))
+		return;
+	// the number of slabs is bounded such that the index has about 4 entries per segment
+	double sum_heights(0.0);
+	for (size_t k(0); k < n_segments; k++)
+		sum_heights += fabs((*(getPoint(k + 1)))[1] - (*(getPoint(k)))[1]);
+	const double max_slabs(3.0 * n_segments * height / std::max(sum_heights, height));
+	const size_t n_slabs(std::max(static_cast<size_t>(1), std::min(n_segments / 2, static_cast<size_t>(max_slabs))));
+	_slab_y0 = y_min;
+	_slab_inv_height = n_slabs / height;
+	_slab_offsets.assign(n_slabs + 1, 0);
+
+	// count, then fill the segments of every slab that overlap it in y
+	for (int pass(0); pass < 2; pass++)
+	{
+		std::vector<size_t> pos(_slab_offsets.begin(), _slab_offsets.end() - 1);
+		for (size_t k(0); k < n_segments; k++)
+		{
+			const double y0((*(getPoint(k)))[1]), y1((*(getPoint(k + 1)))[1]);
+			const size_t first(getSlab(std::min(y0, y1))), last(getSlab(std::max(y0, y1)));
+			for (size_t slab(first); slab <= last; slab++)
+			{
+				if (pass == 0)
+					_slab_offsets[slab + 1]++;
+				else
+					_slab_segments[pos[slab]++] = k;
+			}
+		}
+		if (pass == 0)
+		{
+			for (size_t slab(0); slab < n_slabs; slab++)
+				_slab_offsets[slab + 1] += _slab_offsets[slab];
+			_slab_segments.resize(_slab_offsets[n_slabs]);
+		}
+	}
+}
+
 void Polygon::ensureCWOrientation()
 {
 	// *** pre processing: rotate points to xy-plan
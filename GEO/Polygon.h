@@ -15,6 +15,7 @@
 
 // STL
 #include <list>
+#include <vector>
 
 // GEOLIB
 #include "AxisAlignedBoundingBox.h"
@@ -80,6 +81,13 @@ public:
 	 * @return if point is inside the polygon true, else false
 	 */
 	bool isPntInPolygon(double x, double y, double z) const;
+	/**
+	 * Batched version of isPntInPolygon() for many points, e.g. the nodes of a
+	 * mesh. The points are checked in parallel if OpenMP is enabled.
+	 * @param pnts coordinates of the points
+	 * @param pnt_ids (output) ascending indices of the points inside the polygon
+	 */
+	void getPntsInPolygon(std::vector<double const*> const& pnts, std::vector<std::size_t>& pnt_ids) const;
 	/**
 	 * Method checks if all points of the polyline ply are inside of the polygon.
 	 * @param ply the polyline that should be checked
@@ -125,11 +133,21 @@ private:
 
 	void calculateAxisAlignedBoundingBox();
 	void ensureCWOrientation();
+	/**
+	 * sorts the line segments into horizontal slabs of the bounding box, such
+	 * that a point query only has to look at the segments of its slab
+	 */
+	void buildSlabIndex();
+	std::size_t getSlab(double y) const;
 
 	void splitPolygonAtIntersection(std::list<Polygon*>::iterator polygon_it);
 	void splitPolygonAtPoint(std::list<Polygon*>::iterator polygon_it);
 	std::list<Polygon*> _simple_polygon_list;
 	AABB _aabb;
+	double _slab_y0; //!< lower bound of the first slab
+	double _slab_inv_height; //!< inverse of the slab height
+	std::vector<std::size_t> _slab_offsets; //!< range of the segments of slab k in _slab_segments
+	std::vector<std::size_t> _slab_segments; //!< segment numbers per slab
 };
 
 /**
@@ -16,6 +16,7 @@
 
 #include "math.h"
 // C++
+#include <set>
 #include <string>
 #include <vector>
 
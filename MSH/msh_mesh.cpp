@@ -14,12 +14,14 @@
    08/2005 WW/OK Encapsulation from rf_ele_msh
    last modified
 **************************************************************************/
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <climits>
 #include <fstream>
 #include <iomanip> //WW
 #include <iostream>
+#include <set>
 #include <sstream>
 #include <vector>
 
@@ -126,7 +128,7 @@ CFEMesh::CFEMesh(GEOLIB::GEOObjects* geo_obj, std::string* geo_name)
     : max_mmp_groups(0), msh_max_dim(0), _geo_obj(geo_obj), _geo_name(geo_name), _ele_type(MshElemType::INVALID),
       _n_msh_layer(0), _cross_section(false), _msh_n_lines(0), _msh_n_quads(0), _msh_n_hexs(0), _msh_n_tris(0),
       _msh_n_tets(0), _msh_n_prisms(0), _msh_n_pyras(0), _min_edge_length(1e-3), _search_length(0.0),
-      NodesNumber_Linear(0), NodesNumber_Quadratic(0), useQuadratic(false), _axisymmetry(false), ncols(0), nrows(0),
+      NodesNumber_Linear(0), NodesNumber_Quadratic(0), useQuadratic(false), _axisymmetry(false), _eqs_renumbering(false), ncols(0), nrows(0),
       x0(0.0), y0(0.0), csize(0.0), ndata_v(0.0), _mesh_grid(NULL)
 {
 	coordinate_system = 1;
@@ -180,6 +182,7 @@ CFEMesh::CFEMesh(CFEMesh const& old_mesh) : PT(NULL), _search_length(old_mesh._s
 
 	pcs_name = "NotSpecified";
 	this->setNumberOfMeshLayers(old_mesh.getNumberOfMeshLayers());
+	_eqs_renumbering = old_mesh._eqs_renumbering;
 	this->ConstructGrid();
 
 	std::cout << "done."
@@ -467,6 +470,16 @@ bool CFEMesh::Read(std::ifstream* fem_file)
 		}
 		else if (line_string.find("$LAYER") != std::string::npos)
 			*fem_file >> _n_msh_layer >> std::ws;
+		else if (line_string.find("$EQS_RENUMBERING") != std::string::npos)
+		{
+			std::string method;
+			*fem_file >> method >> std::ws;
+			if (method.find("RCM") != std::string::npos)
+				_eqs_renumbering = true;
+			else
+				std::cout << "Warning: unknown equation renumbering " << method << ", ignored"
+				          << "\n";
+		}
 	}
 
 	return more_mesh;
@@ -482,10 +495,28 @@ bool CFEMesh::Read(std::ifstream* fem_file)
 void CFEMesh::ConnectedElements2Node(bool quadratic)
 {
 	size_t nNodes(nod_vector.size());
+	size_t nElems(ele_vector.size());
+
+	// Count first so that every list is allocated with its exact size
+	std::vector<size_t> n_connected(nNodes, 0);
+	for (size_t e = 0; e < nElems; e++)
+	{
+		CElem* elem = ele_vector[e];
+		if (!elem->GetMark())
+			continue;
+
+		size_t nElemNodes(static_cast<size_t>(elem->GetNodesNumber(quadratic)));
+		for (size_t i = 0; i < nElemNodes; i++)
+			n_connected[elem->GetNodeIndex(i)]++;
+	}
+
 	for (size_t e = 0; e < nNodes; e++)
-		nod_vector[e]->getConnectedElementIDs().clear();
+	{
+		std::vector<size_t> connected_elements;
+		connected_elements.reserve(n_connected[e]);
+		nod_vector[e]->getConnectedElementIDs().swap(connected_elements);
+	}
 
-	size_t nElems(ele_vector.size());
 	for (size_t e = 0; e < nElems; e++)
 	{
 		CElem* elem = ele_vector[e];
@@ -866,6 +897,10 @@ void CFEMesh::ConstructGrid()
 	// TEST WW
 	// For sparse matrix
 	ConnectedNodes(false);
+#if !defined(USE_PETSC)
+	if (_eqs_renumbering)
+		RenumberEquationsRCM();
+#endif
 	//
 	e_nodes0.resize(0);
 	//	node_index_glb.resize(0);
@@ -1161,6 +1196,10 @@ void CFEMesh::GenerateHighOrderNodes()
 	// For sparse matrix
 	ConnectedNodes(true);
 	ConnectedElements2Node(true);
+#if !defined(USE_PETSC)
+	if (_eqs_renumbering)
+		RenumberEquationsRCM();
+#endif
 	//
 	e_nodes0.resize(0);
 
@@ -1285,6 +1324,79 @@ void CFEMesh::RenumberNodesForGlobalAssembly()
 	NodesNumber_Quadratic = el;
 }
 
+/**************************************************************************
+   MSHLib-Method: RenumberEquationsRCM
+   Task: Reverse Cuthill-McKee ordering of the equation indices. Each
+         connected component starts from a node of minimum degree, the
+         neighbours are visited in order of increasing degree.
+**************************************************************************/
+void CFEMesh::RenumberEquationsRCM()
+{
+	const size_t n_linear(NodesNumber_Linear);
+	const size_t n_nodes(nod_vector.size() > NodesNumber_Quadratic ? NodesNumber_Quadratic : nod_vector.size());
+	std::vector<long> new2old;
+	new2old.reserve(n_nodes);
+	std::vector<bool> visited(n_nodes, false);
+	std::vector<size_t> degree(n_nodes, 0);
+	std::vector<std::pair<size_t, size_t> > neighbors;
+
+	// Linear nodes first, then the additional nodes of quadratic elements
+	const size_t range_begin[2] = {0, n_linear};
+	const size_t range_end[2] = {n_linear, n_nodes};
+	for (int r = 0; r < 2; r++)
+	{
+		const size_t begin(range_begin[r]), end(range_end[r]);
+		for (size_t i = begin; i < end; i++)
+		{
+			const std::vector<size_t>& connected(nod_vector[i]->getConnectedNodes());
+			for (size_t k = 0; k < connected.size(); k++)
+				if (connected[k] >= begin && connected[k] < end && connected[k] != i)
+					degree[i]++;
+		}
+
+		const size_t offset(new2old.size());
+		for (;;)
+		{
+			// Start node of the next component: unvisited node of minimum degree
+			size_t start(end);
+			for (size_t i = begin; i < end; i++)
+				if (!visited[i] && (start == end || degree[i] < degree[start]))
+					start = i;
+			if (start == end)
+				break;
+
+			size_t head(new2old.size());
+			new2old.push_back(start);
+			visited[start] = true;
+			while (head < new2old.size())
+			{
+				const std::vector<size_t>& connected(nod_vector[new2old[head++]]->getConnectedNodes());
+				neighbors.clear();
+				for (size_t k = 0; k < connected.size(); k++)
+				{
+					const size_t j(connected[k]);
+					if (j >= begin && j < end && !visited[j])
+					{
+						visited[j] = true;
+						neighbors.push_back(std::make_pair(degree[j], j));
+					}
+				}
+				std::sort(neighbors.begin(), neighbors.end());
+				for (size_t k = 0; k < neighbors.size(); k++)
+					new2old.push_back(neighbors[k].second);
+			}
+		}
+		std::reverse(new2old.begin() + offset, new2old.end());
+	}
+
+	Eqs2Global_NodeIndex.resize(n_nodes);
+	for (size_t i = 0; i < n_nodes; i++)
+	{
+		nod_vector[new2old[i]]->SetEquationIndex(i);
+		Eqs2Global_NodeIndex[i] = nod_vector[new2old[i]]->GetIndex();
+	}
+}
+
 /**************************************************************************
    FEMLib-Method:
    Task:
@@ -3018,49 +3130,26 @@ bool CFEMesh::NodeExists(size_t node)
 void CFEMesh::ConnectedNodes(bool quadratic) const
 {
 #define noTestConnectedNodes
-	bool exist = false;
-
+	// Collect the candidates in a scratch buffer, then sort, remove duplicates
+	// and store an exactly sized copy, so that no node keeps the slack of a
+	// push_back grown vector.
+	std::vector<size_t> candidates;
 	for (size_t i = 0; i < nod_vector.size(); i++)
 	{
 		CNode* nod = nod_vector[i];
+		std::vector<size_t>& connected_nodes(nod->getConnectedNodes());
+		candidates.assign(connected_nodes.begin(), connected_nodes.end());
 		size_t n_connected_elements(nod->getConnectedElementIDs().size());
 		for (size_t j = 0; j < n_connected_elements; j++)
 		{
 			CElem* ele = ele_vector[nod->getConnectedElementIDs()[j]];
 			size_t n_quadratic_node(static_cast<size_t>(ele->GetNodesNumber(quadratic)));
 			for (size_t l = 0; l < n_quadratic_node; l++)
-			{
-				exist = false;
-				size_t n_connected_nodes(nod->getConnectedNodes().size());
-				// WW
-				for (size_t k = 0; k < n_connected_nodes; k++)
-					if (nod->getConnectedNodes()[k] == static_cast<size_t>(ele->nodes_index[l]))
-					{
-						exist = true;
-						break;
-					}
-				if (!exist) // WW
-					nod->getConnectedNodes().push_back(ele->nodes_index[l]);
-			}
-		}
-	}
-
-	// Sorting. WW
-	// WW
-	for (size_t i = 0; i < nod_vector.size(); i++)
-	{
-		CNode* nod = nod_vector[i];
-		size_t n_connected_nodes = nod->getConnectedNodes().size();
-		for (size_t k = 0; k < n_connected_nodes; k++)
-		{
-			for (size_t l = k; l < n_connected_nodes; l++)
-				if (nod->getConnectedNodes()[l] < nod->getConnectedNodes()[k])
-				{
-					const size_t n(nod->getConnectedNodes()[k]);
-					nod->getConnectedNodes()[k] = nod->getConnectedNodes()[l];
-					nod->getConnectedNodes()[l] = n;
-				}
+				candidates.push_back(static_cast<size_t>(ele->nodes_index[l]));
 		}
+		std::sort(candidates.begin(), candidates.end());
+		candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+		std::vector<size_t>(candidates.begin(), candidates.end()).swap(connected_nodes);
 	}
 //----------------------------------------------------------------------
 #ifdef TestConnectedNodes
@@ -406,6 +406,14 @@ public:
 	void FillTransformMatrix();
 
 	void RenumberNodesForGlobalAssembly();
+	/**
+	 * Reorders the equation indices of the nodes by the reverse Cuthill-McKee
+	 * algorithm to reduce the bandwidth of the global matrix. The node indices,
+	 * and therefore input and output, are not changed. Linear and quadratic
+	 * nodes are reordered separately, i.e. the linear nodes keep the first
+	 * NodesNumber_Linear equation indices.
+	 */
+	void RenumberEquationsRCM();
 	/**
 	 * returns the vector storing pointers to all nodes (class CNode) of the mesh
 	 * @return
@@ -433,8 +441,10 @@ public:
 	// OK
 	void PrismRefine(int Layer, int subdivision);
 
+	/// Sets the sorted, exactly sized list of connected nodes of every node
 	void ConnectedNodes(bool quadratic) const;
 	// WW
+	/// Sets the exactly sized list of connected elements of every node
 	void ConnectedElements2Node(bool quadratic = false);
 	// OK
 	std::vector<std::string> mat_names_vector;
@@ -550,6 +560,8 @@ private:
 #endif
 	bool useQuadratic;
 	bool _axisymmetry;
+	/// Equation indices are reordered by RCM (keyword $EQS_RENUMBERING)
+	bool _eqs_renumbering;
 	bool top_surface_checked; // 07.06.2010.  WW
 
 	// Coordinate indicator
@@ -300,14 +300,10 @@ void ExtractMeshNodes::writeMesh2DNodeIDAndArea(std::ostream& os, std::ostream&
 
 	// store node id
 	std::vector<size_t> node_ids;
-
+	std::vector<double const*> node_coords(msh_nodes.size());
 	for (size_t j(0); j < msh_nodes.size(); j++)
-	{
-		GEOLIB::Point pnt(msh_nodes[j]->getData());
-		if (polygon.isPntInPolygon(pnt))
-			node_ids.push_back(j);
-	}
-	std::sort(node_ids.begin(), node_ids.end());
+		node_coords[j] = msh_nodes[j]->getData();
+	polygon.getPntsInPolygon(node_coords, node_ids);
 
 	size_t n_nodes(node_ids.size());
 	std::vector<double> areas(n_nodes, 0.0);
@@ -454,13 +450,12 @@ void ExtractMeshNodes::getMeshNodeIDsWithinPolygon(GEOLIB::Polygon const& polygo
 
 	// check if nodes (projected to x-y-plane) are inside the polygon
 	const size_t number_of_mesh_nodes(mesh_nodes.size());
+	std::vector<double const*> node_coords(number_of_mesh_nodes);
 	for (size_t j(0); j < number_of_mesh_nodes; j++)
-	{
-		if (polygon.isPntInPolygon(mesh_nodes[j]->getData()))
-		{
-			node_ids.push_back(j);
-		}
-	}
+		node_coords[j] = mesh_nodes[j]->getData();
+	std::vector<size_t> ids_in_polygon;
+	polygon.getPntsInPolygon(node_coords, ids_in_polygon);
+	node_ids.insert(node_ids.end(), ids_in_polygon.begin(), ids_in_polygon.end());
 }
 
 } // end namespace MeshLib
@@ -31,6 +31,10 @@ PETScLinearSolver::PETScLinearSolver(const int size)
 	m_size_loc = PETSC_DECIDE;
 	mpi_size = 0;
 	rank = 0;
+	pc_reuse_max = 0;
+	pc_reuse_growth = 0.0;
+	pc_solves = 0;
+	pc_ref_its = 0;
 }
 
 PETScLinearSolver::~PETScLinearSolver()
@@ -58,6 +62,8 @@ void PETScLinearSolver::Init(const int* sparse_index)
 		nz = sparse_index[2];
 		m_size_loc = sparse_index[3];
 	}
+	if (!d_nnz.empty())
+		m_size_loc = static_cast<PetscInt>(d_nnz.size());
 
 	VectorCreate(m_size);
 	MatrixCreate(m_size, m_size);
@@ -65,6 +71,19 @@ void PETScLinearSolver::Init(const int* sparse_index)
 	global_x = new PetscScalar[m_size];
 }
 
+void PETScLinearSolver::setPreallocation(const std::vector<PetscInt>& d_nnz_in, const std::vector<PetscInt>& o_nnz_in)
+{
+	d_nnz = d_nnz_in;
+	o_nnz = o_nnz_in;
+}
+
+void PETScLinearSolver::setPreconditionerReuse(const int max_reuse, const double growth)
+{
+	pc_reuse_max = max_reuse;
+	pc_reuse_growth = growth;
+	pc_solves = 0;
+}
+
 /*!
   \brief KSP and PC type
 
@@ -182,7 +201,8 @@ void PETScLinearSolver::VectorCreate(PetscInt m)
 	VecCreate(PETSC_COMM_WORLD, &b);
 	////VecCreateMPI(PETSC_COMM_WORLD,m_size_loc, m, &b);
 	// VecSetSizes(b, m_size_loc, m);
-	VecSetSizes(b, PETSC_DECIDE, m);
+	// With exact preallocation the rows are distributed like the mesh nodes
+	VecSetSizes(b, d_nnz.empty() ? PETSC_DECIDE : m_size_loc, m);
 	VecSetFromOptions(b);
 	VecSetOption(b, VEC_IGNORE_NEGATIVE_INDICES, PETSC_TRUE);
 	VecSetUp(b); // kg44 for PETSC 3.3
@@ -198,20 +218,35 @@ void PETScLinearSolver::MatrixCreate(PetscInt m, PetscInt n)
 {
 	MatCreate(PETSC_COMM_WORLD, &A);
 	// TEST  MatSetSizes(A, m_size_loc, PETSC_DECIDE, m, n);
-	MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, m, n);
-	// MatSetSizes(A, m_size_loc, PETSC_DECIDE, m,  n);
+	if (d_nnz.empty())
+		MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, m, n);
+	else
+		MatSetSizes(A, m_size_loc, m_size_loc, m, n);
 
 	MatSetType(A, MATMPIAIJ);
 	MatSetFromOptions(A);
 
-	MatSeqAIJSetPreallocation(A, d_nz, PETSC_NULL);
-	MatMPIAIJSetPreallocation(A, d_nz, PETSC_NULL, o_nz, PETSC_NULL);
-	MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+	if (d_nnz.empty())
+	{
+		MatSeqAIJSetPreallocation(A, d_nz, PETSC_NULL);
+		MatMPIAIJSetPreallocation(A, d_nz, PETSC_NULL, o_nz, PETSC_NULL);
+	}
+	else
+	{
+		MatSeqAIJSetPreallocation(A, 0, &d_nnz[0]);
+		MatMPIAIJSetPreallocation(A, 0, &d_nnz[0], 0, &o_nnz[0]);
+	}
+	// The exact counts cover the whole mesh graph, so an entry outside of
+	// them is an assembly error. The uniform estimate may be too small.
+	MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, d_nnz.empty() ? PETSC_FALSE : PETSC_TRUE);
 
 	MatSetUp(A); // KG44 this seems to work with petsc 3.3 ..the commands below result in problems when assembling the
 	// matrix with version 3.3
 
 	MatGetOwnershipRange(A, &i_start, &i_end);
+
+	std::vector<PetscInt>().swap(d_nnz);
+	std::vector<PetscInt>().swap(o_nnz);
 }
 
 void PETScLinearSolver::getLocalRowColumnSizes(int* m, int* n)
@@ -241,7 +276,7 @@ void PETScLinearSolver::Solver()
 	VecView(x, viewer);
 	*/
 
-	int its;
+	PetscInt its;
 	PetscLogDouble v1, v2;
 	KSPConvergedReason reason;
 
@@ -253,15 +288,30 @@ void PETScLinearSolver::Solver()
 	PetscGetTime(&v1);
 #endif
 
-#if (PETSC_VERSION_MAJOR == 3) && (PETSC_VERSION_MINOR > 4)
-	KSPSetOperators(lsolver, A, A);
-#else
-	KSPSetOperators(lsolver, A, A, DIFFERENT_NONZERO_PATTERN);
-#endif
-
+	// Rebuild the preconditioner for the first solve, after pc_reuse_max solves,
+	// or if the last solve indicated that the preconditioner is outdated
+	bool reuse_pc = pc_reuse_max > 0 && pc_solves > 0 && pc_solves < pc_reuse_max;
+	setOperators(reuse_pc);
 	KSPSolve(lsolver, b, x);
-
 	KSPGetConvergedReason(lsolver, &reason); // CHKERRQ(ierr);
+	KSPGetIterationNumber(lsolver, &its);
+	if (reuse_pc && reason < 0)
+	{
+		PetscPrintf(PETSC_COMM_WORLD, "\nNo convergence with the reused preconditioner, rebuild it.\n");
+		reuse_pc = false;
+		setOperators(reuse_pc);
+		KSPSolve(lsolver, b, x);
+		KSPGetConvergedReason(lsolver, &reason);
+		KSPGetIterationNumber(lsolver, &its);
+	}
+	if (!reuse_pc)
+	{
+		pc_solves = 0;
+		pc_ref_its = its;
+	}
+	pc_solves++;
+	if (reuse_pc && pc_reuse_growth > 0.0 && its > pc_reuse_growth * (pc_ref_its > 0 ? pc_ref_its : 1))
+		pc_solves = 0; // convergence rate degraded
 	if (reason == KSP_DIVERGED_INDEFINITE_PC)
 	{
 		PetscPrintf(PETSC_COMM_WORLD, "\nDivergence because of indefinite preconditioner;\n");
@@ -280,7 +330,6 @@ void PETScLinearSolver::Solver()
 
 		PetscPrintf(PETSC_COMM_WORLD, "\n================================================");
 		PetscPrintf(PETSC_COMM_WORLD, "\nLinear solver %s with %s preconditioner", slv_type, prc_type);
-		KSPGetIterationNumber(lsolver, &its); // CHKERRQ(ierr);
 		PetscPrintf(PETSC_COMM_WORLD, "\nConvergence in %d iterations.\n", (int)its);
 		PetscPrintf(PETSC_COMM_WORLD, "\n================================================");
 	}
@@ -331,6 +380,16 @@ if(global_x)
 #endif
 }
 
+void PETScLinearSolver::setOperators(const bool reuse_pc)
+{
+#if (PETSC_VERSION_MAJOR == 3) && (PETSC_VERSION_MINOR > 4)
+	KSPSetOperators(lsolver, A, A);
+	KSPSetReusePreconditioner(lsolver, reuse_pc ? PETSC_TRUE : PETSC_FALSE);
+#else
+	KSPSetOperators(lsolver, A, A, reuse_pc ? SAME_PRECONDITIONER : DIFFERENT_NONZERO_PATTERN);
+#endif
+}
+
 void PETScLinearSolver::AssembleRHS_PETSc()
 {
 	VecAssemblyBegin(b);
@@ -45,6 +45,23 @@ public:
 
 	void Init(const int* sparse_index = NULL);
 
+	/*!
+	   \brief Set the exact number of nonzeros of every local row, must be called before Init().
+	   The local rows are the rows of this rank, i.e. the vectors and the matrix get
+	   d_nnz.size() local rows instead of the PETSc default partition.
+	   \param d_nnz_in nonzeros per local row in the diagonal block (columns of the local rows)
+	   \param o_nnz_in nonzeros per local row in the off-diagonal block
+	*/
+	void setPreallocation(const std::vector<PetscInt>& d_nnz_in, const std::vector<PetscInt>& o_nnz_in);
+
+	/*!
+	   \brief Keep the preconditioner over several solves.
+	   \param max_reuse  maximum number of solves with one preconditioner, 0: rebuild for every solve
+	   \param growth     rebuild as soon as a solve needs more than growth times the
+	                     iterations of the first solve with the current preconditioner, 0: no check
+	*/
+	void setPreconditionerReuse(const int max_reuse, const double growth);
+
 	void Solver();
 	void AssembleRHS_PETSc();
 	void AssembleUnkowns_PETSc();
@@ -119,6 +136,18 @@ private:
 	PetscInt o_nz;
 	// Number of nonzeros per row (same for all rows)
 	PetscInt nz;
+	// Exact number of nonzeros per local row in the DIAGONAL and OFF-DIAGONAL
+	// portion. If given, they replace d_nz and o_nz. Released after MatrixCreate.
+	std::vector<PetscInt> d_nnz;
+	std::vector<PetscInt> o_nnz;
+
+	// Preconditioner reuse
+	int pc_reuse_max;
+	double pc_reuse_growth;
+	// Number of solves with the current preconditioner
+	int pc_solves;
+	// Iterations of the first solve with the current preconditioner
+	PetscInt pc_ref_its;
 
 	int mpi_size;
 	int rank;
@@ -134,6 +163,9 @@ private:
 	void gatherLocalVectors(PetscScalar local_array[], PetscScalar global_array[]);
 
 	void UpdateSolutions(PetscScalar* u);
+
+	/// Set the operators of the KSP, keep the preconditioner if reuse_pc is true
+	void setOperators(const bool reuse_pc);
 };
 
 // extern std::vector<PETScLinearSolver*> EQS_Vector;
@@ -0,0 +1,137 @@
+/*
+ * convertFieldToBinary.cpp
+ *
+ * Converts ASCII distribution files into binary field files
+ * (see FileIO::BinaryFieldIO):
+ *  - #MEDIUM_PROPERTIES_DISTRIBUTED files with $DIS_TYPE ELEMENT, as used by
+ *    $PERMEABILITY_DISTRIBUTION and $POROSITY_DISTRIBUTION in the mmp file
+ *  - DIRECT node files ("node_id value" per line, terminated by #STOP), as
+ *    used by DIRECT initial conditions, boundary conditions and source terms
+ *
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// FileIO
+#include "FEMIO/BinaryFieldIO.h"
+#include "readNonBlankLineFromInputStream.h"
+
+static bool convertMediumPropertiesFile(std::ifstream& in, std::string const& out_fname)
+{
+	std::string name, dis_type;
+	std::vector<uint32_t> ids;
+	std::vector<double> values;
+	std::string line;
+	while (in.good())
+	{
+		line = readNonBlankLineFromInputStream(in);
+		if (line.find("STOP") != std::string::npos)
+			break;
+		if (line.find("$MMP_TYPE") != std::string::npos)
+			in >> name;
+		else if (line.find("$DIS_TYPE") != std::string::npos)
+			in >> dis_type;
+		else if (line.find("$DATA") != std::string::npos)
+		{
+			if (dis_type.empty() || dis_type[0] != 'E')
+			{
+				std::cout << "only $DIS_TYPE ELEMENT can be converted, found " << dis_type << "\n";
+				return false;
+			}
+			// the element ids are ignored by the ASCII reader as well, values
+			// are assigned to the elements in the order of the file
+			double id, value;
+			while (in >> id >> value)
+				values.push_back(value);
+			break;
+		}
+	}
+	if (name.empty() || values.empty())
+	{
+		std::cout << "no $MMP_TYPE or no element data found"
+		          << "\n";
+		return false;
+	}
+	std::cout << "writing " << values.size() << " element values of " << name << "\n";
+	return FileIO::BinaryFieldIO::write(out_fname, FileIO::BinaryFieldIO::ELEMENT, name, ids, values);
+}
+
+static bool convertDirectNodeFile(std::ifstream& in, std::string const& out_fname, std::string const& name)
+{
+	std::vector<uint32_t> ids;
+	std::vector<double> values;
+	std::string line;
+	std::stringstream ss;
+	while (in.good())
+	{
+		line = readNonBlankLineFromInputStream(in);
+		if (line.empty() || line.find("#STOP") != std::string::npos)
+			break;
+		long id;
+		double value;
+		ss.str(line);
+		ss >> id >> value;
+		if (ss.fail() || id < 0)
+		{
+			std::cout << "could not read line: " << line << "\n";
+			return false;
+		}
+		ss.clear();
+		ids.push_back(static_cast<uint32_t>(id));
+		values.push_back(value);
+	}
+
+	// store densely if the file lists every node in order
+	bool dense(true);
+	for (size_t i = 0; i < ids.size() && dense; i++)
+		dense = (ids[i] == i);
+	if (dense)
+		ids.clear();
+
+	std::cout << "writing " << values.size() << " node values"
+	          << "\n";
+	return FileIO::BinaryFieldIO::write(out_fname, FileIO::BinaryFieldIO::NODE, name, ids, values);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: " << argv[0] << " ascii_input binary_output [field_name]"
+		          << "\n";
+		std::cout << "\tascii_input is a #MEDIUM_PROPERTIES_DISTRIBUTED file with element data"
+		          << "\n";
+		std::cout << "\tor a DIRECT node file (node_id value per line)"
+		          << "\n";
+		std::cout << "\tfield_name is stored for node files only, default: DIRECT"
+		          << "\n";
+		return -1;
+	}
+
+	std::ifstream in(argv[1]);
+	if (!in.good())
+	{
+		std::cout << "could not open file " << argv[1] << "\n";
+		return -1;
+	}
+
+	std::string first_line(readNonBlankLineFromInputStream(in));
+	bool ok;
+	if (first_line.find("#MEDIUM_PROPERTIES_DISTRIBUTED") != std::string::npos)
+		ok = convertMediumPropertiesFile(in, argv[2]);
+	else
+	{
+		in.clear();
+		in.seekg(0, std::ios::beg);
+		ok = convertDirectNodeFile(in, argv[2], argc > 3 ? argv[3] : "DIRECT");
+	}
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,79 @@
+/*
+ * TestKDTree.cpp
+ *
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+#include "gtest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+// GEOLIB
+#include "KDTree.h"
+#include "Point.h"
+
+namespace
+{
+double sqrDist(GEOLIB::Point const& p, double const* q)
+{
+	return (p[0] - q[0]) * (p[0] - q[0]) + (p[1] - q[1]) * (p[1] - q[1]) + (p[2] - q[2]) * (p[2] - q[2]);
+}
+}
+
+TEST(GEO, KDTreeQueriesMatchLinearSearch)
+{
+	// coarse integer coordinates in a plane produce many equal distances
+	std::srand(4711);
+	std::vector<GEOLIB::Point*> pnts;
+	for (std::size_t k(0); k < 500; k++)
+		pnts.push_back(new GEOLIB::Point(std::rand() % 20, std::rand() % 20, 0.0));
+	GEOLIB::KDTree<GEOLIB::Point> tree(pnts);
+	ASSERT_EQ(pnts.size(), tree.size());
+
+	std::vector<std::size_t> ids;
+	for (std::size_t q(0); q < 100; q++)
+	{
+		const double pnt[3] = {(std::rand() % 250) * 0.1 - 2.5, (std::rand() % 250) * 0.1 - 2.5, 0.5};
+
+		std::vector<std::pair<double, std::size_t> > sorted;
+		for (std::size_t k(0); k < pnts.size(); k++)
+			sorted.push_back(std::make_pair(sqrDist(*pnts[k], pnt), k));
+		std::sort(sorted.begin(), sorted.end());
+
+		ASSERT_EQ(sorted[0].second, tree.getNearestPoint(pnt));
+
+		tree.getKNearestPoints(pnt, 7, ids);
+		ASSERT_EQ(7u, ids.size());
+		for (std::size_t k(0); k < ids.size(); k++)
+			ASSERT_EQ(sorted[k].second, ids[k]);
+
+		const double radius(2.5);
+		std::vector<std::size_t> expected;
+		for (std::size_t k(0); k < pnts.size(); k++)
+			if (sqrDist(*pnts[k], pnt) <= radius * radius)
+				expected.push_back(k);
+		tree.getPointsInSphere(pnt, radius, ids);
+		ASSERT_TRUE(expected == ids);
+
+		const double min_pnt[3] = {pnt[0] - 3.0, pnt[1] - 1.0, 0.0};
+		const double max_pnt[3] = {pnt[0] + 1.0, pnt[1] + 3.0, 0.0};
+		expected.clear();
+		for (std::size_t k(0); k < pnts.size(); k++)
+		{
+			GEOLIB::Point const& p(*pnts[k]);
+			if (min_pnt[0] <= p[0] && p[0] <= max_pnt[0] && min_pnt[1] <= p[1] && p[1] <= max_pnt[1])
+				expected.push_back(k);
+		}
+		tree.getPointsInBox(min_pnt, max_pnt, ids);
+		ASSERT_TRUE(expected == ids);
+	}
+
+	for (std::size_t k(0); k < pnts.size(); k++)
+		delete pnts[k];
+}
@@ -0,0 +1,93 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#include "gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// GEOLIB
+#include "Point.h"
+#include "Polygon.h"
+
+namespace
+{
+/// Star shaped polygon (non-convex) with many segments, as a basin outline
+GEOLIB::Polygon* createStar(std::vector<GEOLIB::Point*>& pnts, std::size_t n)
+{
+	const double pi(3.14159265358979323846);
+	for (std::size_t k(0); k < n; k++)
+	{
+		const double r((k % 2 == 0) ? 1.0 : 0.5);
+		pnts.push_back(new GEOLIB::Point(r * std::cos(2.0 * pi * k / n), r * std::sin(2.0 * pi * k / n), 0.0));
+	}
+	GEOLIB::Polygon* polygon(new GEOLIB::Polygon(pnts));
+	for (std::size_t k(0); k < n; k++)
+		polygon->addPoint(k);
+	polygon->addPoint(0);
+	polygon->initialise();
+	return polygon;
+}
+
+/// Ray casting reference for the star polygon
+bool isInsideReference(std::vector<GEOLIB::Point*> const& pnts, double x, double y)
+{
+	bool inside(false);
+	const std::size_t n(pnts.size());
+	for (std::size_t i(0), j(n - 1); i < n; j = i++)
+	{
+		const double xi((*pnts[i])[0]), yi((*pnts[i])[1]), xj((*pnts[j])[0]), yj((*pnts[j])[1]);
+		if ((yi > y) != (yj > y) && x < (xj - xi) * (y - yi) / (yj - yi) + xi)
+			inside = !inside;
+	}
+	return inside;
+}
+}
+
+TEST(GEO, PointInPolygonSlabIndex)
+{
+	std::vector<GEOLIB::Point*> pnts;
+	GEOLIB::Polygon* polygon(createStar(pnts, 2000));
+
+	std::vector<GEOLIB::Point*> query;
+	std::vector<double const*> query_coords;
+	for (std::size_t j(0); j < 211; j++)
+		for (std::size_t k(0); k < 211; k++)
+		{
+			query.push_back(new GEOLIB::Point(-1.05 + 0.01 * k + 1e-7, -1.05 + 0.01 * j + 3e-7, 0.0));
+			query_coords.push_back(query.back()->getData());
+		}
+
+	std::vector<std::size_t> ids;
+	polygon->getPntsInPolygon(query_coords, ids);
+
+	std::size_t n_inside(0);
+	for (std::size_t k(0); k < query.size(); k++)
+	{
+		const bool inside(polygon->isPntInPolygon(*query[k]));
+		ASSERT_EQ(isInsideReference(pnts, (*query[k])[0], (*query[k])[1]), inside);
+		if (inside)
+		{
+			ASSERT_LT(n_inside, ids.size());
+			ASSERT_EQ(k, ids[n_inside]);
+			n_inside++;
+		}
+	}
+	ASSERT_EQ(n_inside, ids.size());
+	ASSERT_GT(n_inside, 0u);
+
+	// vertices are on the boundary
+	for (std::size_t k(0); k < pnts.size(); k++)
+		ASSERT_TRUE(polygon->isPntInPolygon(*pnts[k]));
+
+	delete polygon;
+	for (std::size_t k(0); k < query.size(); k++)
+		delete query[k];
+	for (std::size_t k(0); k < pnts.size(); k++)
+		delete pnts[k];
+}
@@ -17,10 +17,18 @@
 
 #include <../gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <string>
 #include <vector>
 
 #include "matrix_class.h"
+#ifdef NEW_EQS
+#include "MeshIO/OGSMeshIO.h"
+#include "msh_mesh.h"
+#endif
 
 using Math_Group::Matrix;
 using Math_Group::SymMatrix;
@@ -204,3 +212,107 @@ TEST(MATRIX, test_class_Vec)
 	b -= a;
 	ASSERT_EQ(7., b[2]);
 }
+
+#ifdef NEW_EQS
+using Math_Group::CSparseMatrix;
+using Math_Group::SparseTable;
+
+namespace
+{
+/// 3 x 3 quadrilaterals on the unit square
+MeshLib::CFEMesh* createQuadMesh(std::string const& fname)
+{
+	{
+		std::ofstream os(fname.c_str());
+		os << "#FEM_MSH\n $PCS_TYPE\n  NO_PCS\n $NODES\n  16\n";
+		for (int j = 0; j < 4; j++)
+			for (int i = 0; i < 4; i++)
+				os << "  " << j * 4 + i << " " << i / 3. << " " << j / 3. << " 0\n";
+		os << " $ELEMENTS\n  9\n";
+		for (int j = 0; j < 3; j++)
+			for (int i = 0; i < 3; i++)
+			{
+				const int a = j * 4 + i;
+				os << "  " << j * 3 + i << " 0 quad " << a << " " << a + 1 << " " << a + 5 << " " << a + 4 << "\n";
+			}
+		os << "#STOP\n";
+	}
+	FileIO::OGSMeshIO mesh_io;
+	MeshLib::CFEMesh* mesh = mesh_io.loadMeshFromFile(fname);
+	std::remove(fname.c_str());
+	return mesh;
+}
+
+/// Dirichlet values on three nodes (one of them set twice) of a symmetric matrix
+void checkSymmetricDirichletElimination(MeshLib::CFEMesh* mesh, Math_Group::StorageType storage, int dof)
+{
+	SparseTable table(mesh, false, false, storage);
+	CSparseMatrix A(table, dof);
+	const long n = A.Dim();
+
+	// symmetric entries on the sparse pattern
+	A = 1.0;
+	std::vector<double> A0(n * n, 0.0);
+	for (long i = 0; i < n; i++)
+		for (long j = 0; j < n; j++)
+			if (A(i, j) != 0.0)
+			{
+				A(i, j) = (i == j) ? 10.0 + i : -1.0 / (1.0 + i + j);
+				A0[i * n + j] = A(i, j);
+			}
+
+	std::vector<double> b(n), b0(n);
+	for (long i = 0; i < n; i++)
+		b0[i] = b[i] = std::sin(1.0 + i);
+
+	std::vector<long> fixed;
+	std::vector<double> given;
+	fixed.push_back(0);
+	given.push_back(2.0);
+	fixed.push_back(5);
+	given.push_back(-1.0);
+	fixed.push_back(n - 1);
+	given.push_back(3.0);
+	fixed.push_back(5); // same unknown again, the last value wins
+	given.push_back(0.5);
+	std::vector<double> x(n);
+	for (long i = 0; i < n; i++)
+		x[i] = std::cos(2.0 + i);
+	for (size_t k = 0; k < fixed.size(); k++)
+	{
+		A.Diagonize(fixed[k], given[k], &b[0]);
+		x[fixed[k]] = given[k];
+	}
+
+	for (long i = 0; i < n; i++)
+		for (long j = 0; j < n; j++)
+			ASSERT_EQ(A(i, j), A(j, i));
+
+	// Same residual as the original system for every x with the given values
+	std::vector<double> Ax(n, 0.0);
+	A.multiVec(&x[0], &Ax[0]);
+	for (long i = 0; i < n; i++)
+	{
+		const bool is_fixed = std::find(fixed.begin(), fixed.end(), i) != fixed.end();
+		double r0 = -b0[i];
+		for (long j = 0; j < n; j++)
+			r0 += A0[i * n + j] * x[j];
+		if (is_fixed)
+			ASSERT_NEAR(0.0, Ax[i] - b[i], 1.e-12);
+		else
+			ASSERT_NEAR(r0, Ax[i] - b[i], 1.e-12);
+	}
+}
+}
+
+TEST(MATRIX, test_CSparseMatrix_DirichletKeepsSymmetry)
+{
+	MeshLib::CFEMesh* mesh = createQuadMesh("test_sparse_dirichlet.msh");
+	ASSERT_TRUE(mesh != NULL);
+	checkSymmetricDirichletElimination(mesh, Math_Group::JDS, 1);
+	checkSymmetricDirichletElimination(mesh, Math_Group::CRS, 1);
+	checkSymmetricDirichletElimination(mesh, Math_Group::JDS, 2);
+	checkSymmetricDirichletElimination(mesh, Math_Group::CRS, 2);
+	delete mesh;
+}
+#endif
@@ -0,0 +1,161 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "FEMIO/BinaryFieldIO.h"
+
+using FileIO::BinaryFieldIO;
+
+TEST(FileIO, BinaryFieldDenseElementRoundTrip)
+{
+	const std::string fname("test_binary_field_dense.bin");
+	std::vector<double> values;
+	for (std::size_t i = 0; i < 1000; i++)
+		values.push_back(1.0e-12 * (i + 1));
+	ASSERT_TRUE(BinaryFieldIO::write(fname, BinaryFieldIO::ELEMENT, "PERMEABILITY", std::vector<uint32_t>(), values));
+	ASSERT_TRUE(BinaryFieldIO::isBinaryFieldFile(fname));
+
+	BinaryFieldIO::Association association;
+	std::string name;
+	std::vector<uint32_t> ids(3, 7);
+	std::vector<double> read_values;
+	ASSERT_TRUE(BinaryFieldIO::read(fname, association, name, ids, read_values));
+	ASSERT_EQ(BinaryFieldIO::ELEMENT, association);
+	ASSERT_EQ("PERMEABILITY", name);
+	ASSERT_TRUE(ids.empty());
+	ASSERT_EQ(values, read_values);
+
+	// element fields are rejected where node values are expected
+	std::vector<long> node_ids;
+	ASSERT_FALSE(BinaryFieldIO::readNodeValues(fname, node_ids, read_values));
+	std::remove(fname.c_str());
+}
+
+TEST(FileIO, BinaryFieldNodeValuesWithIds)
+{
+	const std::string fname("test_binary_field_ids.bin");
+	std::vector<uint32_t> ids;
+	std::vector<double> values;
+	ids.push_back(42);
+	values.push_back(1.5);
+	ids.push_back(3);
+	values.push_back(-2.0);
+	ASSERT_TRUE(BinaryFieldIO::write(fname, BinaryFieldIO::NODE, "HEAD", ids, values));
+
+	std::vector<long> node_ids;
+	std::vector<double> node_values;
+	ASSERT_TRUE(BinaryFieldIO::readNodeValues(fname, node_ids, node_values));
+	ASSERT_EQ(2u, node_ids.size());
+	ASSERT_EQ(42, node_ids[0]);
+	ASSERT_EQ(3, node_ids[1]);
+	ASSERT_EQ(1.5, node_values[0]);
+	ASSERT_EQ(-2.0, node_values[1]);
+	std::remove(fname.c_str());
+}
+
+TEST(FileIO, BinaryFieldRejectsAsciiAndTruncatedFiles)
+{
+	const std::string fname("test_binary_field_bad.bin");
+	{
+		std::ofstream os(fname.c_str());
+		os << "0 1.0\n1 2.0\n#STOP\n";
+	}
+	ASSERT_FALSE(BinaryFieldIO::isBinaryFieldFile(fname));
+
+	std::vector<double> values(10, 1.0);
+	ASSERT_TRUE(BinaryFieldIO::write(fname, BinaryFieldIO::NODE, "", std::vector<uint32_t>(), values));
+	{
+		// drop the last value
+		std::ifstream is(fname.c_str(), std::ios::binary);
+		std::vector<char> bytes((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+		is.close();
+		std::ofstream os(fname.c_str(), std::ios::binary | std::ios::trunc);
+		os.write(&bytes[0], bytes.size() - sizeof(double));
+	}
+	ASSERT_TRUE(BinaryFieldIO::isBinaryFieldFile(fname));
+	std::vector<long> node_ids;
+	ASSERT_FALSE(BinaryFieldIO::readNodeValues(fname, node_ids, values));
+	ASSERT_TRUE(values.empty());
+	std::remove(fname.c_str());
+}
+
+TEST(FileIO, BinaryFieldRejectsCorruptCount)
+{
+	const std::string fname("test_binary_field_count.bin");
+	std::vector<double> values(4, 1.0);
+	ASSERT_TRUE(BinaryFieldIO::write(fname, BinaryFieldIO::ELEMENT, "POROSITY", std::vector<uint32_t>(), values));
+	std::vector<char> bytes;
+	{
+		std::ifstream is(fname.c_str(), std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+	}
+	// the value count follows magic, byte order mark and four header entries
+	const std::size_t count_offset = 8 + 5 * sizeof(uint32_t);
+	const uint64_t counts[2] = {5, uint64_t(1) << 60};
+	for (std::size_t k = 0; k < 2; k++)
+	{
+		std::memcpy(&bytes[count_offset], &counts[k], sizeof(uint64_t));
+		{
+			std::ofstream os(fname.c_str(), std::ios::binary | std::ios::trunc);
+			os.write(&bytes[0], bytes.size());
+		}
+		BinaryFieldIO::Association association;
+		std::string name;
+		std::vector<uint32_t> ids;
+		std::vector<double> read_values;
+		ASSERT_FALSE(BinaryFieldIO::read(fname, association, name, ids, read_values));
+		ASSERT_TRUE(read_values.empty());
+	}
+	std::remove(fname.c_str());
+}
+
+TEST(FileIO, BinaryFieldReadsForeignByteOrder)
+{
+	// a node field with ids {2} and values {0.25}, written on a host of the
+	// other byte order
+	const std::string fname("test_binary_field_swapped.bin");
+	std::vector<char> bytes(8 + 5 * sizeof(uint32_t) + sizeof(uint64_t));
+	std::memcpy(&bytes[0], "OGSFIELD", 8);
+	const uint32_t header[5] = {0x01020304, 2, BinaryFieldIO::NODE, 1, 0};
+	const uint64_t n = 1;
+	std::memcpy(&bytes[8], header, sizeof(header));
+	std::memcpy(&bytes[8 + sizeof(header)], &n, sizeof(n));
+	const uint32_t id = 2;
+	const double value = 0.25;
+	bytes.insert(bytes.end(), reinterpret_cast<const char*>(&id), reinterpret_cast<const char*>(&id) + sizeof(id));
+	bytes.insert(bytes.end(), reinterpret_cast<const char*>(&value),
+	             reinterpret_cast<const char*>(&value) + sizeof(value));
+	std::reverse(&bytes[8], &bytes[12]);
+	for (std::size_t offset = 12; offset < 8 + sizeof(header); offset += sizeof(uint32_t))
+		std::reverse(&bytes[offset], &bytes[offset + sizeof(uint32_t)]);
+	std::reverse(&bytes[8 + sizeof(header)], &bytes[8 + sizeof(header) + sizeof(n)]);
+	std::reverse(&bytes[bytes.size() - 12], &bytes[bytes.size() - 8]);
+	std::reverse(bytes.end() - 8, bytes.end());
+	{
+		std::ofstream os(fname.c_str(), std::ios::binary | std::ios::trunc);
+		os.write(&bytes[0], bytes.size());
+	}
+
+	std::vector<long> node_ids;
+	std::vector<double> values;
+	ASSERT_TRUE(BinaryFieldIO::readNodeValues(fname, node_ids, values));
+	ASSERT_EQ(1u, node_ids.size());
+	ASSERT_EQ(2, node_ids[0]);
+	ASSERT_EQ(0.25, values[0]);
+	std::remove(fname.c_str());
+}
@@ -0,0 +1,121 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "FEMIO/BinaryRestartIO.h"
+
+using FileIO::BinaryRestartIO;
+
+namespace
+{
+BinaryRestartIO::Header testHeader()
+{
+	BinaryRestartIO::Header header;
+	header.time_step = 12;
+	header.time = 3.5;
+	header.time_step_size = 0.25;
+	header.n_nodes = 101;
+	header.node_value_names.push_back("PRESSURE1");
+	header.node_value_names.push_back("PRESSURE1");
+	header.node_value_names.push_back("VELOCITY_X1");
+	header.n_elements = 40;
+	header.n_element_values = 3;
+	return header;
+}
+}
+
+TEST(FileIO, BinaryRestartRoundTrip)
+{
+	const std::string fname("test_binary_restart.bin");
+	const BinaryRestartIO::Header header(testHeader());
+	std::vector<std::vector<double> > nodes(3, std::vector<double>(header.n_nodes));
+	std::vector<double const*> node_values;
+	for (std::size_t i = 0; i < nodes.size(); i++)
+	{
+		for (std::size_t j = 0; j < nodes[i].size(); j++)
+			nodes[i][j] = 1.0e5 * i + 0.125 * j;
+		node_values.push_back(&nodes[i][0]);
+	}
+	std::vector<double> elements(header.n_elements * header.n_element_values);
+	for (std::size_t i = 0; i < elements.size(); i++)
+		elements[i] = -1.0e-3 * i;
+	ASSERT_TRUE(BinaryRestartIO::write(fname, header, node_values, elements));
+
+	// The expected layout without the time stepping state
+	BinaryRestartIO::Header read_header(testHeader());
+	read_header.time_step = 0;
+	read_header.time = read_header.time_step_size = 0.0;
+	std::vector<std::vector<double> > read_nodes(3, std::vector<double>(header.n_nodes));
+	std::vector<double*> read_node_values;
+	for (std::size_t i = 0; i < read_nodes.size(); i++)
+		read_node_values.push_back(&read_nodes[i][0]);
+	std::vector<double> read_elements;
+	ASSERT_TRUE(BinaryRestartIO::read(fname, read_header, read_node_values, read_elements));
+
+	ASSERT_EQ(12, read_header.time_step);
+	ASSERT_EQ(3.5, read_header.time);
+	ASSERT_EQ(0.25, read_header.time_step_size);
+	ASSERT_EQ(nodes, read_nodes);
+	ASSERT_EQ(elements, read_elements);
+	std::remove(fname.c_str());
+}
+
+TEST(FileIO, BinaryRestartRejectsOtherLayout)
+{
+	const std::string fname("test_binary_restart_layout.bin");
+	const BinaryRestartIO::Header header(testHeader());
+	std::vector<double> nodes(header.n_nodes, 1.0);
+	std::vector<double const*> node_values(3, &nodes[0]);
+	std::vector<double> elements(header.n_elements * header.n_element_values, 2.0);
+	ASSERT_TRUE(BinaryRestartIO::write(fname, header, node_values, elements));
+
+	std::vector<double> read_nodes(header.n_nodes);
+	std::vector<double*> read_node_values(3, &read_nodes[0]);
+	std::vector<double> read_elements;
+
+	BinaryRestartIO::Header other_mesh(testHeader());
+	other_mesh.n_nodes = 100;
+	ASSERT_FALSE(BinaryRestartIO::read(fname, other_mesh, read_node_values, read_elements));
+
+	BinaryRestartIO::Header other_names(testHeader());
+	other_names.node_value_names[2] = "VELOCITY_Y1";
+	ASSERT_FALSE(BinaryRestartIO::read(fname, other_names, read_node_values, read_elements));
+
+	BinaryRestartIO::Header other_elements(testHeader());
+	other_elements.n_element_values = 2;
+	ASSERT_FALSE(BinaryRestartIO::read(fname, other_elements, read_node_values, read_elements));
+
+	// Truncated file
+	std::string content;
+	{
+		std::ifstream is(fname.c_str(), std::ios::binary);
+		content.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream os(fname.c_str(), std::ios::binary | std::ios::trunc);
+		os.write(content.data(), content.size() - 8);
+	}
+	BinaryRestartIO::Header same(testHeader());
+	ASSERT_FALSE(BinaryRestartIO::read(fname, same, read_node_values, read_elements));
+
+	// Not a restart file
+	{
+		std::ofstream os(fname.c_str(), std::ios::binary | std::ios::trunc);
+		os << "#FEM_MSH\n";
+	}
+	ASSERT_FALSE(BinaryRestartIO::read(fname, same, read_node_values, read_elements));
+	std::remove(fname.c_str());
+}
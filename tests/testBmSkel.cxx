@@ -27,6 +27,7 @@ using namespace std;
 #include <sstream>   // are these needed?
 #include <iostream>  // are these needed?
 #include <stdio.h>   // for remove()
+#include <vector>
 
 #include <unistd.h> // also used for rmdir
 
@@ -290,6 +291,188 @@ protected:
     EXPECT_EQ( ans, gfs);
   }
 
+  TEST_F(MinBMTest, DeformationStiffnessReuse)
+  {
+    /** Linear elastic model loaded by a time dependent displacement. With
+	$STIFFNESS_REUSE the global stiffness matrix of the first time step is
+	kept and only the RHS is assembled in the later steps. The solution
+	must be the same as with the full reassembly.
+    */
+    char result[256];
+    strcpy(result,(BuildInfo::SOURCEPATH).c_str());
+    strcat(result,"/tests/data/bmskel_dm");
+    copyModelToTmpDir( result );
+
+    std::string TmpDirectory = tmpDirectory;
+    const std::string runStr = "cd " + TmpDirectory + "; "
+	+ BuildInfo::OGS_EXECUTABLE + " a > /dev/null";
+    const std::string toFpath = TmpDirectory + "/a_time_POINT2_DEFORMATION.tec";
+
+    std::string solution[2];
+    for (int reuse = 0; reuse < 2; reuse++)
+      {
+	const std::string numFpath = TmpDirectory + "/a.num";
+	std::ofstream num( numFpath.c_str(), std::fstream::trunc );
+	num << "#NUMERICS\n $PCS_TYPE\n  DEFORMATION\n"
+	    << " $NON_LINEAR_ITERATION\n  PICARD ERNORM 1 0.0 1e-6\n"
+	    << " $LINEAR_SOLVER\n  2 1 1.e-014 5000 1.0 100 4\n"
+	    << " $ELE_GAUSS_POINTS\n  3\n"
+	    << " $STIFFNESS_REUSE\n  " << reuse << "\n#STOP\n";
+	num.close();
+
+	remove( toFpath.c_str() );
+	system( runStr.c_str() );  // call ogs here
+
+	std::ifstream ifs( toFpath.c_str() );
+	solution[reuse].assign( ( std::istreambuf_iterator< char > ( ifs ) ),
+				std::istreambuf_iterator< char > () );
+      }
+
+    // initial state and three loading steps
+    ASSERT_FALSE( solution[0].empty() );
+    EXPECT_NE( std::string::npos, solution[0].find( "\n3.000000000000e+00 " ) );
+    EXPECT_EQ( solution[0], solution[1] );
+  }
+
+  TEST_F(MinBMTest, GroundwaterFlowOperatorReuse)
+  {
+    /** Linear transient groundwater flow with a change of the time step
+	size. With $OPERATOR_REUSE the element loop runs once and the later
+	systems are formed from the cached mass and Laplace matrices. The
+	solution must be the same as with the full reassembly.
+    */
+    char result[256];
+    strcpy(result,(BuildInfo::SOURCEPATH).c_str());
+    strcat(result,"/tests/data/bmskel_gw");
+    copyModelToTmpDir( result );
+
+    std::string TmpDirectory = tmpDirectory;
+    const std::string runStr = "cd " + TmpDirectory + "; "
+	+ BuildInfo::OGS_EXECUTABLE + " a > /dev/null";
+    const std::string toFpath = TmpDirectory + "/a_time_POINT4_GROUNDWATER_FLOW.tec";
+
+    std::vector<double> solution[2];
+    for (int reuse = 0; reuse < 2; reuse++)
+      {
+	const std::string numFpath = TmpDirectory + "/a.num";
+	std::ofstream num( numFpath.c_str(), std::fstream::trunc );
+	num << "#NUMERICS\n $PCS_TYPE\n  GROUNDWATER_FLOW\n"
+	    << " $LINEAR_SOLVER\n  2 1 1.e-014 5000 1.0 100 4\n"
+	    << " $OPERATOR_REUSE\n  " << reuse << "\n#STOP\n";
+	num.close();
+
+	remove( toFpath.c_str() );
+	system( runStr.c_str() );  // call ogs here
+
+	// skip the three header lines, then read time and head
+	std::ifstream ifs( toFpath.c_str() );
+	std::string line;
+	for (int i = 0; i < 3; i++)
+	  getline( ifs, line );
+	double value;
+	while ( ifs >> value )
+	  solution[reuse].push_back( value );
+      }
+
+    // initial state and five time steps
+    ASSERT_EQ( 12u, solution[0].size() );
+    ASSERT_EQ( solution[0].size(), solution[1].size() );
+    for (std::size_t i = 0; i < solution[0].size(); i++)
+      EXPECT_NEAR( solution[0][i], solution[1][i], 1e-12 );
+  }
+
+  TEST_F(MinBMTest, MassTransportFCTEquationRenumbering)
+  {
+    /** Advective transport with the flux corrected transport (FCT)
+	stabilization, which adds the artificial diffusion and the limited
+	antidiffusive fluxes directly into the global system. With
+	$EQS_RENUMBERING the equation indices differ from the node indices,
+	and the solution must be the same as with the original order.
+    */
+    char result[256];
+    strcpy(result,(BuildInfo::SOURCEPATH).c_str());
+    strcat(result,"/tests/data/bmskel_fct");
+    copyModelToTmpDir( result );
+
+    std::string TmpDirectory = tmpDirectory;
+    const std::string runStr = "cd " + TmpDirectory + "; "
+	+ BuildInfo::OGS_EXECUTABLE + " a > /dev/null";
+    const std::string toFpath = TmpDirectory + "/a_time_POINT4_MASS_TRANSPORT.tec";
+    const std::string mshFpath = TmpDirectory + "/a.msh";
+    std::string mesh;
+    {
+      std::ifstream ifs( mshFpath.c_str() );
+      mesh.assign( ( std::istreambuf_iterator< char > ( ifs ) ),
+		   std::istreambuf_iterator< char > () );
+    }
+
+    std::vector<double> solution[2];
+    for (int renumbering = 0; renumbering < 2; renumbering++)
+      {
+	std::ofstream msh( mshFpath.c_str(), std::fstream::trunc );
+	if (renumbering)
+	  msh << "#FEM_MSH\n $EQS_RENUMBERING\n  RCM\n"
+	      << mesh.substr( mesh.find( '\n' ) + 1 );
+	else
+	  msh << mesh;
+	msh.close();
+
+	remove( toFpath.c_str() );
+	system( runStr.c_str() );  // call ogs here
+
+	// skip the three header lines, then read time and concentration
+	std::ifstream ifs( toFpath.c_str() );
+	std::string line;
+	for (int i = 0; i < 3; i++)
+	  getline( ifs, line );
+	double value;
+	while ( ifs >> value )
+	  solution[renumbering].push_back( value );
+      }
+
+    // initial state and ten time steps, the front passes the point
+    ASSERT_EQ( 22u, solution[0].size() );
+    ASSERT_EQ( solution[0].size(), solution[1].size() );
+    EXPECT_GT( solution[0][21], 0.9 );
+    for (std::size_t i = 0; i < solution[0].size(); i++)
+      EXPECT_NEAR( solution[0][i], solution[1][i], 1e-10 );
+  }
+
+  TEST_F(MinBMTest, HeatTransportExponentialDensityLaw)
+  {
+    /** Liquid flow coupled with heat transport, with the exponential
+	density law (density model 14) and the vapour diffusion model. Heat
+	transport evaluates the density without explicit arguments, from the
+	process values at the Gauss points.
+    */
+    char result[256];
+    strcpy(result,(BuildInfo::SOURCEPATH).c_str());
+    strcat(result,"/tests/data/bmskel_th");
+    copyModelToTmpDir( result );
+
+    std::string TmpDirectory = tmpDirectory;
+    const std::string runStr = "cd " + TmpDirectory + "; "
+	+ BuildInfo::OGS_EXECUTABLE + " a > /dev/null";
+    const std::string toFpath = TmpDirectory + "/a_time_POINT4_HEAT_TRANSPORT.tec";
+    system( runStr.c_str() );  // call ogs here
+
+    // skip the three header lines, then read time and temperature
+    std::ifstream ifs( toFpath.c_str() );
+    std::string line;
+    for (int i = 0; i < 3; i++)
+      getline( ifs, line );
+    std::vector<double> solution;
+    double value;
+    while ( ifs >> value )
+      solution.push_back( value );
+
+    // initial state and ten time steps, the heat front passes the point
+    ASSERT_EQ( 22u, solution.size() );
+    EXPECT_EQ( 5000.0, solution[20] );
+    EXPECT_GT( solution[21], 340.0 );
+    EXPECT_LT( solution[21], 353.0 );
+  }
+
 }  // namespace
 /*
 int main(int argc, char **argv)
@@ -0,0 +1,148 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "ElementGeometryCache.h"
+#include "msh_elem.h"
+
+using FiniteElement::ElementGeometryCache;
+
+namespace
+{
+// Sizes of a 2D element with 4 nodes and 2x2 integration points
+const int n_gp = 4;
+const std::size_t n_inv = n_gp * 4;
+const std::size_t n_grad = n_gp * 2 * 4;
+const std::size_t n_values = n_gp + n_inv + n_grad;
+
+/// Element geometry as computed by CElement, distinct for every element,
+/// order and array
+struct Geometry
+{
+	Geometry(const std::size_t id, const int order) : det(n_gp), inv(n_inv), grad(n_grad)
+	{
+		const double s = 1.0 + id + 0.1 * order;
+		for (int i = 0; i < n_gp; i++)
+			det[i] = s * std::sqrt(2.0 + i);
+		for (std::size_t i = 0; i < n_inv; i++)
+			inv[i] = -s / (3.0 + i);
+		for (std::size_t i = 0; i < n_grad; i++)
+			grad[i] = s * std::sin(1.0 + i);
+	}
+	std::vector<double> det, inv, grad;
+};
+
+void store(ElementGeometryCache& cache, const MeshLib::CElem& elem, const int order)
+{
+	const Geometry g(elem.GetIndex(), order);
+	cache.store(&elem, order, n_gp, &g.det[0], &g.inv[0], n_inv, &g.grad[0], n_grad);
+}
+
+bool restore(const ElementGeometryCache& cache, const MeshLib::CElem& elem, const int order, Geometry& g)
+{
+	return cache.restore(&elem, order, n_gp, &g.det[0], &g.inv[0], n_inv, &g.grad[0], n_grad);
+}
+}
+
+TEST(FEM, ElementGeometryCacheStoreRestore)
+{
+	MeshLib::CElem e0(0), e1(1), e2(2);
+	ElementGeometryCache cache(3, false, 0.0);
+	const std::size_t empty_size = cache.getMemorySize();
+
+	store(cache, e0, 1);
+	store(cache, e1, 1);
+	store(cache, e1, 2);
+	ASSERT_EQ(3u, cache.getNumberOfEntries());
+	// An entry is stored once
+	store(cache, e1, 2);
+	ASSERT_EQ(3u, cache.getNumberOfEntries());
+	ASSERT_EQ(empty_size + 3 * n_values * sizeof(double), cache.getMemorySize());
+
+	// Double precision restores the stored values exactly
+	Geometry g(99, 0);
+	ASSERT_TRUE(restore(cache, e0, 1, g));
+	const Geometry g01(0, 1);
+	ASSERT_EQ(g01.det, g.det);
+	ASSERT_EQ(g01.inv, g.inv);
+	ASSERT_EQ(g01.grad, g.grad);
+	ASSERT_TRUE(restore(cache, e1, 2, g));
+	const Geometry g12(1, 2);
+	ASSERT_EQ(g12.det, g.det);
+	ASSERT_EQ(g12.inv, g.inv);
+	ASSERT_EQ(g12.grad, g.grad);
+
+	// Not stored: other order, other element, other number of integration points
+	ASSERT_FALSE(restore(cache, e0, 2, g));
+	ASSERT_FALSE(restore(cache, e2, 1, g));
+	ASSERT_FALSE(cache.restore(&e0, 1, n_gp - 1, &g.det[0], &g.inv[0], n_inv, &g.grad[0], n_grad));
+	// An element of another mesh with the same index
+	MeshLib::CElem other_e0(0);
+	ASSERT_FALSE(restore(cache, other_e0, 1, g));
+	store(cache, other_e0, 2);
+	ASSERT_EQ(3u, cache.getNumberOfEntries());
+	// An element index beyond the size of the cache
+	MeshLib::CElem e5(5);
+	store(cache, e5, 1);
+	ASSERT_FALSE(restore(cache, e5, 1, g));
+	ASSERT_EQ(3u, cache.getNumberOfEntries());
+}
+
+TEST(FEM, ElementGeometryCacheSinglePrecision)
+{
+	MeshLib::CElem e0(0);
+	ElementGeometryCache cache(1, true, 0.0);
+	store(cache, e0, 1);
+	ASSERT_EQ(1u, cache.getNumberOfEntries());
+
+	Geometry g(99, 0);
+	ASSERT_TRUE(restore(cache, e0, 1, g));
+	const Geometry ref(0, 1);
+	for (int i = 0; i < n_gp; i++)
+		ASSERT_EQ(static_cast<double>(static_cast<float>(ref.det[i])), g.det[i]);
+	for (std::size_t i = 0; i < n_inv; i++)
+		ASSERT_EQ(static_cast<double>(static_cast<float>(ref.inv[i])), g.inv[i]);
+	for (std::size_t i = 0; i < n_grad; i++)
+		ASSERT_EQ(static_cast<double>(static_cast<float>(ref.grad[i])), g.grad[i]);
+}
+
+TEST(FEM, ElementGeometryCacheMemoryLimit)
+{
+	std::vector<MeshLib::CElem*> elems;
+	for (std::size_t i = 0; i < 4; i++)
+		elems.push_back(new MeshLib::CElem(i));
+
+	for (int single = 0; single < 2; single++)
+	{
+		// Room for two and a half entries
+		const std::size_t value_size = single ? sizeof(float) : sizeof(double);
+		const double max_megabytes = 2.5 * n_values * value_size / (1024.0 * 1024.0);
+		ElementGeometryCache cache(elems.size(), single == 1, max_megabytes);
+		const std::size_t empty_size = cache.getMemorySize();
+
+		for (std::size_t i = 0; i < elems.size(); i++)
+			store(cache, *elems[i], 1);
+		ASSERT_EQ(2u, cache.getNumberOfEntries());
+		ASSERT_EQ(empty_size + 2 * n_values * value_size, cache.getMemorySize());
+
+		Geometry g(99, 0);
+		ASSERT_TRUE(restore(cache, *elems[0], 1, g));
+		ASSERT_TRUE(restore(cache, *elems[1], 1, g));
+		// The elements beyond the limit are computed as without the cache
+		ASSERT_FALSE(restore(cache, *elems[2], 1, g));
+		ASSERT_FALSE(restore(cache, *elems[3], 1, g));
+	}
+
+	for (std::size_t i = 0; i < elems.size(); i++)
+		delete elems[i];
+}
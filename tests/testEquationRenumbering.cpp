@@ -0,0 +1,119 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "msh_elem.h"
+#include "msh_mesh.h"
+#include "msh_node.h"
+
+namespace
+{
+const int n_cells = 12;
+const int n_points = n_cells + 1;
+
+/// Node ID of the grid point k. A multiplicative permutation scatters the
+/// neighbours of a grid point over the whole index range.
+long nodeID(const long k)
+{
+	return (k * 37) % (n_points * n_points);
+}
+
+/// Read a quad grid with scattered node IDs
+void readScatteredGrid(MeshLib::CFEMesh& mesh, const bool renumbering)
+{
+	const long n_nodes = n_points * n_points;
+	std::vector<long> grid_point(n_nodes);
+	for (long k = 0; k < n_nodes; k++)
+		grid_point[nodeID(k)] = k;
+
+	const std::string fname("test_equation_renumbering.msh");
+	{
+		std::ofstream out(fname.c_str());
+		if (renumbering)
+			out << " $EQS_RENUMBERING\n  RCM\n";
+		out << " $NODES\n  " << n_nodes << "\n";
+		for (long i = 0; i < n_nodes; i++)
+			out << "  " << i << " " << grid_point[i] % n_points << " " << grid_point[i] / n_points << " 0\n";
+		out << " $ELEMENTS\n  " << n_cells * n_cells << "\n";
+		for (int j = 0; j < n_cells; j++)
+			for (int i = 0; i < n_cells; i++)
+			{
+				const long k = j * n_points + i;
+				out << "  " << j * n_cells + i << " 0 quad " << nodeID(k) << " " << nodeID(k + 1) << " "
+				    << nodeID(k + n_points + 1) << " " << nodeID(k + n_points) << "\n";
+			}
+		out << "#STOP\n";
+	}
+	std::ifstream in(fname.c_str());
+	mesh.Read(&in);
+	in.close();
+	std::remove(fname.c_str());
+	mesh.ConstructGrid();
+}
+
+/// Largest difference of the equation indices within one element
+long bandwidth(const MeshLib::CFEMesh& mesh)
+{
+	long width = 0;
+	for (size_t e = 0; e < mesh.ele_vector.size(); e++)
+	{
+		const MeshLib::CElem* elem = mesh.ele_vector[e];
+		for (size_t i = 0; i < elem->GetNodesNumber(false); i++)
+			for (size_t j = 0; j < elem->GetNodesNumber(false); j++)
+			{
+				const long d = elem->GetNode(i)->GetEquationIndex() - elem->GetNode(j)->GetEquationIndex();
+				if (std::labs(d) > width)
+					width = std::labs(d);
+			}
+	}
+	return width;
+}
+}
+
+TEST(MSH, EquationRenumberingRCM)
+{
+	MeshLib::CFEMesh original, renumbered;
+	readScatteredGrid(original, false);
+	readScatteredGrid(renumbered, true);
+
+	const size_t n_nodes = renumbered.nod_vector.size();
+	ASSERT_EQ(static_cast<size_t>(n_points * n_points), n_nodes);
+	ASSERT_EQ(n_nodes, renumbered.Eqs2Global_NodeIndex.size());
+
+	// Eqs2Global_NodeIndex is a permutation and the inverse of the equation
+	// indices, i.e. equation -> node -> equation is the identity
+	std::vector<bool> found(n_nodes, false);
+	for (size_t i = 0; i < n_nodes; i++)
+	{
+		const long node = renumbered.Eqs2Global_NodeIndex[i];
+		ASSERT_TRUE(node >= 0 && node < static_cast<long>(n_nodes));
+		ASSERT_FALSE(found[node]);
+		found[node] = true;
+		ASSERT_EQ(static_cast<long>(i), renumbered.nod_vector[node]->GetEquationIndex());
+		// node indices and coordinates are not touched
+		ASSERT_EQ(static_cast<size_t>(node), renumbered.nod_vector[node]->GetIndex());
+		ASSERT_EQ(original.nod_vector[node]->getData()[0], renumbered.nod_vector[node]->getData()[0]);
+		ASSERT_EQ(original.nod_vector[node]->getData()[1], renumbered.nod_vector[node]->getData()[1]);
+	}
+
+	// Without the keyword the equation index is the node index
+	for (size_t i = 0; i < n_nodes; i++)
+		ASSERT_EQ(static_cast<long>(i), original.nod_vector[i]->GetEquationIndex());
+
+	// A grid of n x n points has an RCM bandwidth of about n
+	ASSERT_LE(bandwidth(renumbered), 2 * n_points);
+	ASSERT_LT(bandwidth(renumbered), bandwidth(original));
+}
@@ -0,0 +1,125 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest.h"
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "FixedPointAccelerator.h"
+
+using FiniteElement::FixedPointAccelerator;
+
+namespace
+{
+double nonlinearity = 0.05;
+
+/// Slowly converging contraction G(x) = A x + c sin(x) + b
+void applyMap(std::vector<double> const& x, std::vector<double>& g)
+{
+	const std::size_t n = x.size();
+	for (std::size_t i = 0; i < n; i++)
+	{
+		g[i] = 0.9 * x[i] + nonlinearity * std::sin(x[i]) + 1.0 + 0.1 * i;
+		if (i > 0)
+			g[i] += 0.04 * x[i - 1];
+		if (i + 1 < n)
+			g[i] += 0.04 * x[i + 1];
+	}
+}
+
+/// Number of iterations until |G(x) - x| < tol
+std::size_t iterate(FixedPointAccelerator& accelerator, std::vector<double>& x, double tol, std::size_t max_iter)
+{
+	std::vector<double> g(x.size());
+	for (std::size_t k = 0; k < max_iter; k++)
+	{
+		applyMap(x, g);
+		double res = 0.0;
+		for (std::size_t i = 0; i < x.size(); i++)
+			res = std::max(res, std::fabs(g[i] - x[i]));
+		if (res < tol)
+			return k;
+		accelerator.update(x, g);
+		x = g;
+	}
+	return max_iter;
+}
+}
+
+TEST(FEM, FixedPointAcceleratorReducesIterations)
+{
+	const std::size_t n = 30, max_iter = 5000;
+	const double tol = 1e-6;
+	nonlinearity = 0.05;
+
+	FixedPointAccelerator picard(FixedPointAccelerator::NONE, 1, 1.0);
+	std::vector<double> x_picard(n, 0.0);
+	const std::size_t n_picard = iterate(picard, x_picard, tol, max_iter);
+	ASSERT_LT(n_picard, max_iter);
+
+	FixedPointAccelerator aitken(FixedPointAccelerator::AITKEN, 1, 1.0);
+	std::vector<double> x_aitken(n, 0.0);
+	const std::size_t n_aitken = iterate(aitken, x_aitken, tol, max_iter);
+
+	FixedPointAccelerator anderson(FixedPointAccelerator::ANDERSON, 5, 1.0);
+	std::vector<double> x_anderson(n, 0.0);
+	const std::size_t n_anderson = iterate(anderson, x_anderson, tol, max_iter);
+
+	ASSERT_LT(4 * n_aitken, n_picard);
+	ASSERT_LT(4 * n_anderson, n_picard);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		ASSERT_NEAR(x_picard[i], x_aitken[i], 1e-3);
+		ASSERT_NEAR(x_picard[i], x_anderson[i], 1e-3);
+	}
+
+	// The history is restarted, the same problem needs the same number of iterations again
+	anderson.reset();
+	std::vector<double> x_again(n, 0.0);
+	ASSERT_EQ(n_anderson, iterate(anderson, x_again, tol, max_iter));
+}
+
+TEST(FEM, FixedPointAcceleratorAndersonLinear)
+{
+	// For a linear map and a history at least as long as the number of
+	// unknowns Anderson mixing is equivalent to GMRES: it converges in
+	// about n iterations.
+	const std::size_t n = 30;
+	nonlinearity = 0.0;
+	FixedPointAccelerator anderson(FixedPointAccelerator::ANDERSON, n + 5, 1.0);
+	std::vector<double> x(n, 0.0);
+	ASSERT_LE(iterate(anderson, x, 1e-8, 1000), n + 5);
+}
+
+TEST(FEM, FixedPointAcceleratorReadType)
+{
+	FixedPointAccelerator::Type type;
+	std::size_t depth;
+	const char* valid[] = {"ANDERSON 7", " AITKEN", "NONE", ""};
+	const FixedPointAccelerator::Type types[]
+	    = {FixedPointAccelerator::ANDERSON, FixedPointAccelerator::AITKEN, FixedPointAccelerator::NONE,
+	       FixedPointAccelerator::NONE};
+	const std::size_t depths[] = {7, 1, 1, 1};
+	for (int k = 0; k < 4; k++)
+	{
+		std::istringstream in(valid[k]);
+		ASSERT_TRUE(FixedPointAccelerator::readType(in, type, depth));
+		ASSERT_EQ(types[k], type);
+		ASSERT_EQ(depths[k], depth);
+	}
+
+	const char* invalid[] = {"ANDERSON", "ANDERSON 0", "BROYDEN 3"};
+	for (int k = 0; k < 3; k++)
+	{
+		std::istringstream in(invalid[k]);
+		ASSERT_FALSE(FixedPointAccelerator::readType(in, type, depth));
+	}
+}
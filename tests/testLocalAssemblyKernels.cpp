@@ -0,0 +1,88 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "LocalAssemblyKernels.h"
+
+using namespace FiniteElement;
+
+namespace
+{
+double value(const int i)
+{
+	return std::sin(0.7 * i + 0.3);
+}
+
+/// Compare the kernels with the loops of CFiniteElementStd for n nodes in d dimensions
+void checkKernels(const int n, const int d)
+{
+	// Block at (1, 2) of a larger matrix to check the leading dimension
+	const std::size_t ld = n + 3;
+	const std::size_t offset = 1 * ld + 2;
+	std::vector<double> dN(d * n), K(d * d), N(n), v(d);
+	for (int i = 0; i < d * n; i++)
+		dN[i] = value(i);
+	for (int i = 0; i < d * d; i++)
+		K[i] = 1.0 + value(3 * i + 1);
+	for (int i = 0; i < n; i++)
+		N[i] = 0.5 + 0.5 * value(5 * i + 2);
+	for (int i = 0; i < d; i++)
+		v[i] = value(7 * i + 4);
+	const double fkt = 0.37;
+
+	std::vector<double> laplace(ld * (n + 1), 1.0), mass(laplace), advection(laplace);
+	LocalAssemblyKernels::gradKGrad(n, d, fkt, &dN[0], &K[0], &laplace[offset], ld);
+	LocalAssemblyKernels::outerProduct(n, fkt, &N[0], &N[0], &mass[offset], ld);
+	LocalAssemblyKernels::shapeVelocityGrad(n, d, fkt, &N[0], &v[0], &dN[0], &advection[offset], ld);
+
+	for (int i = 0; i < n; i++)
+		for (int j = 0; j < n; j++)
+		{
+			double l = 1.0, a = 1.0;
+			for (int k = 0; k < d; k++)
+			{
+				for (int m = 0; m < d; m++)
+					l += fkt * dN[k * n + i] * K[d * k + m] * dN[m * n + j];
+				a += fkt * N[i] * v[k] * dN[k * n + j];
+			}
+			const std::size_t ij = offset + i * ld + j;
+			ASSERT_NEAR(l, laplace[ij], 1e-14);
+			ASSERT_NEAR(1.0 + fkt * N[i] * N[j], mass[ij], 1e-14);
+			ASSERT_NEAR(a, advection[ij], 1e-14);
+		}
+
+	// Entries outside of the block are untouched
+	for (std::size_t j = 0; j < ld; j++)
+		ASSERT_EQ(1.0, laplace[j]);
+	ASSERT_EQ(1.0, laplace[offset - 1]);
+	ASSERT_EQ(1.0, mass[offset + n]);
+}
+}
+
+TEST(FEM, LocalAssemblyKernelsFixedSizes)
+{
+	checkKernels(2, 1);
+	checkKernels(3, 2);
+	checkKernels(4, 2);
+	checkKernels(3, 3);
+	checkKernels(4, 3);
+	checkKernels(6, 3);
+	checkKernels(8, 3);
+}
+
+TEST(FEM, LocalAssemblyKernelsVariableSizes)
+{
+	checkKernels(9, 2);
+	checkKernels(5, 3);
+	checkKernels(20, 3);
+}
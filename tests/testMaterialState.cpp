@@ -0,0 +1,289 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+#include "MaterialState.h"
+#include "rf_mfp_new.h"
+#include "rf_mmp_new.h"
+
+namespace
+{
+/// Read the keywords of a material from a temporary file
+template <typename T>
+void readMaterial(T& material, const std::string& keywords)
+{
+	const std::string fname("test_material_state.txt");
+	{
+		std::ofstream out(fname.c_str());
+		out << keywords << "#STOP\n";
+	}
+	std::ifstream in(fname.c_str());
+	material.Read(&in);
+	in.close();
+	std::remove(fname.c_str());
+}
+
+/// Fluid with models that only depend on the given state
+void readFluid(CFluidProperties& fluid)
+{
+	readMaterial(fluid,
+	             "$DENSITY\n 5 1000.0 0.0 0.2 20.0 -2.0e-4\n"
+	             "$VISCOSITY\n 4\n"
+	             "$SPECIFIC_HEAT_CAPACITY\n 1 4200.0\n"
+	             "$HEAT_CONDUCTIVITY\n 1 0.6\n");
+}
+
+void state(const int i, double* variables)
+{
+	variables[0] = 1.0e5 * (1 + i % 7); // p
+	variables[1] = 10.0 + 0.5 * i; // T
+	variables[2] = 0.01 * (i % 11); // C
+}
+
+#if defined(__linux__)
+const int n_threads = 4;
+
+/// The states first, first + n_threads, ... evaluated by one thread
+struct FluidTask
+{
+	const CFluidProperties* fluid;
+	int first;
+	int n;
+	double* values;
+};
+
+void* evaluateFluid(void* arg)
+{
+	const FluidTask& task = *static_cast<FluidTask*>(arg);
+	for (int i = task.first; i < task.n; i += n_threads)
+	{
+		double variables[3];
+		state(i, variables);
+		const MaterialState s(variables);
+		task.values[2 * i] = task.fluid->Density(s);
+		task.values[2 * i + 1] = task.fluid->Viscosity(s);
+	}
+	return NULL;
+}
+
+struct MediumTask
+{
+	const CMediumProperties* medium;
+	int first;
+	int n;
+	const double* capillary_pressure;
+	double* values;
+};
+
+void* evaluateMedium(void* arg)
+{
+	const MediumTask& task = *static_cast<MediumTask*>(arg);
+	for (int i = task.first; i < task.n; i += n_threads)
+	{
+		const double sw = task.medium->SaturationCapillaryPressureFunction(task.capillary_pressure[i]);
+		task.values[2 * i] = sw;
+		task.values[2 * i + 1] = task.medium->PermeabilitySaturationFunction(sw, 0);
+	}
+	return NULL;
+}
+#endif
+}
+
+TEST(FEM, MaterialStateFluidProperties)
+{
+	CFluidProperties fluid;
+	readFluid(fluid);
+	ASSERT_TRUE(fluid.isReentrant());
+
+	const int n = 200;
+	std::vector<double> density(n), viscosity(n), capacity(n), conductivity(n);
+	for (int i = 0; i < n; i++)
+	{
+		double variables[3];
+		state(i, variables);
+		const MaterialState s(variables);
+		density[i] = fluid.Density(s);
+		viscosity[i] = fluid.Viscosity(s);
+		capacity[i] = fluid.SpecificHeatCapacity(s);
+		conductivity[i] = fluid.HeatConductivity(s);
+
+		// The classic functions give the same values
+		ASSERT_EQ(density[i], fluid.Density(variables));
+		ASSERT_EQ(viscosity[i], fluid.Viscosity(variables));
+		ASSERT_EQ(capacity[i], fluid.SpecificHeatCapacity(variables));
+		ASSERT_EQ(conductivity[i], fluid.HeatConductivity(variables));
+	}
+	ASSERT_NEAR(1000.0 * (1.0 + 0.2 * 0.03 - 2.0e-4 * (17.0 - 20.0)), density[14], 1e-10);
+	ASSERT_EQ(4200.0, capacity[0]);
+	ASSERT_EQ(0.6, conductivity[0]);
+
+#if defined(__linux__)
+	// Concurrent evaluation of the same object
+	std::vector<double> concurrent(2 * n, -1.0);
+	pthread_t threads[n_threads];
+	FluidTask tasks[n_threads];
+	for (int t = 0; t < n_threads; t++)
+	{
+		tasks[t].fluid = &fluid;
+		tasks[t].first = t;
+		tasks[t].n = n;
+		tasks[t].values = &concurrent[0];
+		ASSERT_EQ(0, pthread_create(&threads[t], NULL, evaluateFluid, &tasks[t]));
+	}
+	for (int t = 0; t < n_threads; t++)
+		ASSERT_EQ(0, pthread_join(threads[t], NULL));
+	for (int i = 0; i < n; i++)
+	{
+		ASSERT_EQ(density[i], concurrent[2 * i]);
+		ASSERT_EQ(viscosity[i], concurrent[2 * i + 1]);
+	}
+#endif
+}
+
+TEST(FEM, MaterialStateMediumProperties)
+{
+	const bool H_Process_old = H_Process;
+	H_Process = true; // one phase in $PERMEABILITY_SATURATION
+
+	CMediumProperties medium;
+	readMaterial(medium,
+	             "$POROSITY\n 1 0.3\n"
+	             "$PERMEABILITY_SATURATION\n 4 0.05 1.0 0.5 1.0e-9\n"
+	             "$CAPILLARY_PRESSURE\n 4 5000.0 0.05 1.0 0.5 1.0e6 0\n");
+	ASSERT_TRUE(medium.isReentrant());
+	ASSERT_EQ(0.3, medium.Porosity(MaterialState()));
+
+	const int n = 200;
+	std::vector<double> pc(n), values(2 * n);
+	for (int i = 0; i < n; i++)
+	{
+		pc[i] = 50.0 * (i % 101);
+		values[2 * i] = medium.SaturationCapillaryPressureFunction(pc[i]);
+		values[2 * i + 1] = medium.PermeabilitySaturationFunction(values[2 * i], 0);
+	}
+
+#if defined(__linux__)
+	// Concurrent evaluation of the same object
+	std::vector<double> concurrent(2 * n, -1.0);
+	pthread_t threads[n_threads];
+	MediumTask tasks[n_threads];
+	for (int t = 0; t < n_threads; t++)
+	{
+		tasks[t].medium = &medium;
+		tasks[t].first = t;
+		tasks[t].n = n;
+		tasks[t].capillary_pressure = &pc[0];
+		tasks[t].values = &concurrent[0];
+		ASSERT_EQ(0, pthread_create(&threads[t], NULL, evaluateMedium, &tasks[t]));
+	}
+	for (int t = 0; t < n_threads; t++)
+		ASSERT_EQ(0, pthread_join(threads[t], NULL));
+	ASSERT_EQ(values, concurrent);
+#endif
+
+	// Models which read other objects
+	const char* not_reentrant[] = {"$POROSITY\n 13 0.3\n",
+	                               "$POROSITY\n 1 0.3\n"
+	                               "$CAPILLARY_PRESSURE\n 4 0.5 0.05 1.0 0.5 1.0e6 1\n"};
+	for (int k = 0; k < 2; k++)
+	{
+		CMediumProperties other;
+		readMaterial(other, not_reentrant[k]);
+		ASSERT_FALSE(other.isReentrant());
+	}
+	H_Process = H_Process_old;
+}
+
+TEST(FEM, MaterialStateBatchedFluidProperties)
+{
+	const int n = 27;
+	std::vector<double> p(n), T(n), C(n), batch(n);
+	for (int i = 0; i < n; i++)
+	{
+		double variables[3];
+		state(i, variables);
+		p[i] = variables[0];
+		T[i] = variables[1];
+		C[i] = variables[2];
+	}
+
+	const char* densities[] = {"$DENSITY\n 5 1000.0 0.0 0.2 20.0 -2.0e-4\n$VISCOSITY\n 4\n",
+	                           "$DENSITY\n 6 1000.0 1.0e5 4.5e-10 20.0 -2.0e-4\n$VISCOSITY\n 2 1.0e-3 1.0e5 1.0e-9\n",
+	                           "$DENSITY\n 3 1000.0 0.0 0.2\n$VISCOSITY\n 4\n",
+	                           "$DENSITY\n 14 1000.0 1.0e5 4.5e-10 20.0 -2.0e-4\n$VISCOSITY\n 4\n"};
+	for (int k = 0; k < 4; k++)
+	{
+		CFluidProperties fluid;
+		readMaterial(fluid, densities[k]);
+
+		fluid.Density(&p[0], &T[0], &C[0], n, &batch[0]);
+		for (int i = 0; i < n; i++)
+		{
+			double variables[3] = {p[i], T[i], C[i]};
+			ASSERT_EQ(fluid.Density(MaterialState(variables)), batch[i]);
+		}
+		// Without concentrations C = 0
+		fluid.Density(&p[0], &T[0], NULL, n, &batch[0]);
+		for (int i = 0; i < n; i++)
+		{
+			double variables[3] = {p[i], T[i], 0.0};
+			ASSERT_EQ(fluid.Density(MaterialState(variables)), batch[i]);
+		}
+		fluid.Viscosity(&p[0], &T[0], &C[0], n, &batch[0]);
+		for (int i = 0; i < n; i++)
+		{
+			double variables[3] = {p[i], T[i], C[i]};
+			ASSERT_EQ(fluid.Viscosity(MaterialState(variables)), batch[i]);
+		}
+	}
+}
+
+TEST(FEM, MaterialStateBatchedMediumProperties)
+{
+	const bool H_Process_old = H_Process;
+	H_Process = true; // one phase in $PERMEABILITY_SATURATION
+
+	const int n = 27;
+	std::vector<double> pc(n), sw(n), kr(n);
+	for (int i = 0; i < n; i++)
+		pc[i] = 1.0e3 * (i - 3) * (i - 3);
+
+	const char* models[] = {"$PERMEABILITY_SATURATION\n 4 0.05 1.0 0.5 1.0e-9\n"
+	                        "$CAPILLARY_PRESSURE\n 4 5000.0 0.05 1.0 0.5 1.0e6 0\n",
+	                        "$PERMEABILITY_SATURATION\n 6 0.1 0.95 2.0 1.0e-9\n"
+	                        "$CAPILLARY_PRESSURE\n 6 5000.0 0.1 0.95 2.0 1.0e6\n",
+	                        "$PERMEABILITY_SATURATION\n 3 0.05 1.0 2.0 0.9 1.0e-9\n"
+	                        "$CAPILLARY_PRESSURE\n 4 5000.0 0.05 1.0 0.5 1.0e6 0\n"};
+	for (int k = 0; k < 3; k++)
+	{
+		CMediumProperties medium;
+		readMaterial(medium, models[k]);
+
+		medium.SaturationCapillaryPressureFunction(&pc[0], n, &sw[0]);
+		medium.PermeabilitySaturationFunction(&sw[0], n, 0, &kr[0]);
+		for (int i = 0; i < n; i++)
+		{
+			ASSERT_EQ(medium.SaturationCapillaryPressureFunction(pc[i]), sw[i]);
+			ASSERT_EQ(medium.PermeabilitySaturationFunction(sw[i], 0), kr[i]);
+		}
+		ASSERT_LT(sw[n - 1], sw[0]);
+		ASSERT_LT(kr[n - 1], kr[0]);
+	}
+	H_Process = H_Process_old;
+}
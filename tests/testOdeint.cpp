@@ -0,0 +1,94 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest.h"
+
+#include <cmath>
+
+#include "rf_kinreact.h"
+
+namespace
+{
+/// Decay chain c1 -> c2 -> ... with rate k_i = i
+void decayChain(double /*t*/, double c[], double dcdt[], int n, long /*node*/, double /*steplength*/)
+{
+	for (int i = 1; i <= n; i++)
+	{
+		dcdt[i] = -i * c[i];
+		if (i > 1)
+			dcdt[i] += (i - 1) * c[i - 1];
+	}
+}
+}
+
+TEST(FEM, OdeintRungeKuttaDecay)
+{
+	double c[2] = {0.0, 1.0};
+	double nexth = 0.0;
+	int nok = 0, nbad = 0;
+	ASSERT_TRUE(odeint(c, 1, 0.0, 2.0, 1.0e-10, 1.0e-3, 1.0e-12, &nexth, &nok, &nbad, decayChain, stifbs, rkqs, 0, 2));
+	ASSERT_NEAR(std::exp(-2.0), c[1], 1.0e-9);
+	ASSERT_GT(nok, 0);
+}
+
+TEST(FEM, OdeintRungeKuttaChangingSize)
+{
+	// The work arrays are kept between the calls and follow the number of equations
+	for (int n = 1; n <= 3; n++)
+	{
+		double c[4] = {0.0, 1.0, 0.0, 0.0};
+		double nexth = 0.0;
+		int nok = 0, nbad = 0;
+		ASSERT_TRUE(
+		    odeint(c, n, 0.0, 1.0, 1.0e-10, 1.0e-3, 1.0e-12, &nexth, &nok, &nbad, decayChain, stifbs, rkqs, 0, 2));
+		ASSERT_NEAR(std::exp(-1.0), c[1], 1.0e-9);
+		if (n > 1) // c2 = e^-t - e^-2t
+		{
+			ASSERT_NEAR(std::exp(-1.0) - std::exp(-2.0), c[2], 1.0e-9);
+		}
+		if (n > 2) // c3 = e^-t (1 - e^-t)^2
+		{
+			ASSERT_NEAR(std::exp(-1.0) * std::pow(1.0 - std::exp(-1.0), 2), c[3], 1.0e-9);
+		}
+	}
+}
+
+TEST(FEM, OdeintStiffExtrapolationDecay)
+{
+	// SolverType 1, the default, uses the Jacobian of the kinetic reactions
+	// from jacobn(). Without any reaction it is zero, so stifbs reduces to
+	// the explicit extrapolation. This checks the extrapolation tableau, the
+	// order and step size control and the workspace of stifbs.
+	CKinReactData reaction_data;
+	KinReactData_vector.push_back(&reaction_data);
+	for (int n = 3; n >= 1; n--)
+	{
+		double c[4] = {0.0, 1.0, 0.0, 0.0};
+		double nexth = 0.0;
+		int nok = 0, nbad = 0;
+		const bool ok
+		    = odeint(c, n, 0.0, 1.0, 1.0e-10, 1.0e-3, 1.0e-12, &nexth, &nok, &nbad, decayChain, stifbs, rkqs, 0, 1);
+		EXPECT_TRUE(ok);
+		EXPECT_NEAR(std::exp(-1.0), c[1], 1.0e-9);
+		if (n > 1)
+		{
+			EXPECT_NEAR(std::exp(-1.0) - std::exp(-2.0), c[2], 1.0e-9);
+		}
+		if (n > 2)
+		{
+			EXPECT_NEAR(std::exp(-1.0) * std::pow(1.0 - std::exp(-1.0), 2), c[3], 1.0e-9);
+		}
+		// Extrapolation needs far fewer steps than the Runge-Kutta method
+		double c_rk[4] = {0.0, 1.0, 0.0, 0.0};
+		int nok_rk = 0, nbad_rk = 0;
+		odeint(c_rk, n, 0.0, 1.0, 1.0e-10, 1.0e-3, 1.0e-12, &nexth, &nok_rk, &nbad_rk, decayChain, stifbs, rkqs, 0, 2);
+		EXPECT_LT(nok + nbad, nok_rk + nbad_rk);
+	}
+	KinReactData_vector.pop_back();
+}
@@ -422,6 +422,38 @@ TEST(SolidProps, TensorInversion)
 		ASSERT_NEAR(inv_t(i), inv(i), 1.e-10);
 }
 
+TEST(SolidProps, StridedKelvinMapping)
+{
+	// 2D stresses of three Gauss points stored column-wise (components x Gauss points)
+	const int ns(4), ngp(3), gp(1);
+	double storage[ns * ngp];
+	for (int i = 0; i < ns * ngp; i++)
+		storage[i] = 0.1 * (i + 1);
+
+	Eigen::Matrix<double, 6, 1> sig(SolidMath::Voigt_to_Kelvin_Stress(storage + gp, ns, ngp));
+	ASSERT_NEAR(sig(0), 0.2, 1.e-12);
+	ASSERT_NEAR(sig(2), 0.8, 1.e-12);
+	ASSERT_NEAR(sig(3), 1.1 * std::sqrt(2.), 1.e-12);
+	ASSERT_NEAR(sig(4), 0., 1.e-12);
+	ASSERT_NEAR(sig(5), 0., 1.e-12);
+
+	// write back into another Gauss point column, the others remain untouched
+	SolidMath::Kelvin_to_Voigt_Stress(sig, storage + 2, ns, ngp);
+	for (int i = 0; i < ns; i++)
+	{
+		ASSERT_NEAR(storage[i * ngp + 2], storage[i * ngp + gp], 1.e-12);
+		ASSERT_NEAR(storage[i * ngp], 0.1 * (i * ngp + 1), 1.e-12);
+	}
+
+	// strains carry the doubled shear components in Voigt notation
+	Eigen::Matrix<double, 6, 1> eps(SolidMath::Voigt_to_Kelvin_Strain(storage + gp, ns, ngp));
+	ASSERT_NEAR(eps(3), 1.1 / std::sqrt(2.), 1.e-12);
+	double voigt[ns];
+	SolidMath::Kelvin_to_Voigt_Strain(eps, voigt, ns);
+	for (int i = 0; i < ns; i++)
+		ASSERT_NEAR(voigt[i], storage[i * ngp + gp], 1.e-12);
+}
+
 TEST(SolidProps, MinkleyFullResidual)
 {
 	Math_Group::Matrix* data;
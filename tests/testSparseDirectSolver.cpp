@@ -0,0 +1,101 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#if defined(NEW_EQS) && !defined(USE_MPI)
+
+#include "gtest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "EigenDirectSolver.h"
+#include "matrix_class.h"
+#include "msh_mesh.h"
+#include "msh_node.h"
+
+namespace
+{
+/// Read a grid of n x n quads
+void readGrid(MeshLib::CFEMesh& mesh, const int n)
+{
+	const std::string fname("test_sparse_direct_solver.msh");
+	{
+		std::ofstream out(fname.c_str());
+		out << " $NODES\n  " << (n + 1) * (n + 1) << "\n";
+		for (int j = 0; j <= n; j++)
+			for (int i = 0; i <= n; i++)
+				out << "  " << j * (n + 1) + i << " " << i << " " << j << " 0\n";
+		out << " $ELEMENTS\n  " << n * n << "\n";
+		for (int j = 0; j < n; j++)
+			for (int i = 0; i < n; i++)
+			{
+				const int k = j * (n + 1) + i;
+				out << "  " << j * n + i << " 0 quad " << k << " " << k + 1 << " " << k + n + 2 << " " << k + n + 1
+				    << "\n";
+			}
+		out << "#STOP\n";
+	}
+	std::ifstream in(fname.c_str());
+	mesh.Read(&in);
+	in.close();
+	std::remove(fname.c_str());
+	mesh.ConstructGrid();
+}
+
+/// Non-symmetric, diagonally dominant entries on the pattern of the mesh
+void fillMatrix(const MeshLib::CFEMesh& mesh, Math_Group::CSparseMatrix& A, const double shift)
+{
+	for (size_t i = 0; i < mesh.nod_vector.size(); i++)
+	{
+		const std::vector<size_t>& connected(mesh.nod_vector[i]->getConnectedNodes());
+		for (size_t k = 0; k < connected.size(); k++)
+		{
+			const long j = static_cast<long>(connected[k]);
+			if (j == static_cast<long>(i))
+				A(i, j) = 10.0 + 0.1 * i + shift;
+			else
+				A(i, j) = (j > static_cast<long>(i)) ? -1.0 : -0.5;
+		}
+	}
+}
+}
+
+TEST(MathLib, SparseDirectSolverKnownSolution)
+{
+	MeshLib::CFEMesh mesh;
+	readGrid(mesh, 4);
+	Math_Group::SparseTable table(&mesh, false);
+	Math_Group::CSparseMatrix A(table, 1);
+	const long n = A.Dim();
+	ASSERT_EQ(25, n);
+
+	std::vector<double> x_exact(n), b(n), x(n);
+	for (long i = 0; i < n; i++)
+		x_exact[i] = 0.5 * i - 3.0;
+
+	Math_Group::EigenDirectSolver solver;
+	for (int step = 0; step < 3; step++)
+	{
+		// The second solution uses the same matrix
+		fillMatrix(mesh, A, (step < 2) ? 0.0 : 1.0);
+		A.multiVec(&x_exact[0], &b[0]);
+		std::fill(x.begin(), x.end(), 0.0);
+		ASSERT_TRUE(solver.solve(A, &b[0], &x[0]));
+		for (long i = 0; i < n; i++)
+			ASSERT_NEAR(x_exact[i], x[i], 1e-12 * std::fabs(x_exact[i]) + 1e-12);
+	}
+	// The factorization of the first matrix is reused once
+	ASSERT_EQ(2, solver.numberOfFactorizations());
+	ASSERT_EQ(3, solver.numberOfSolutions());
+}
+
+#endif
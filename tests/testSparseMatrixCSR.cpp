@@ -0,0 +1,276 @@
+/**
+ * \copyright
+ * Copyright (c) 2015, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "SparseMatrixCSR.h"
+
+using Math_Group::SparseMatrixCSR;
+
+namespace
+{
+const size_t n = 17;
+
+/// Structurally symmetric pattern of a ring with some long range links, with
+/// duplicate and unsorted column indices
+std::vector<std::vector<size_t> > ringPattern()
+{
+	std::vector<std::vector<size_t> > row_columns(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		const size_t next = (i + 1) % n;
+		row_columns[i].push_back(next);
+		row_columns[i].push_back(i);
+		row_columns[next].push_back(i);
+		row_columns[next].push_back(i); // duplicate
+		if (i % 5 == 0)
+		{
+			const size_t far = (i + 7) % n;
+			row_columns[i].push_back(far);
+			row_columns[far].push_back(i);
+		}
+	}
+	return row_columns;
+}
+}
+
+TEST(MathLib, SparseMatrixCSRPattern)
+{
+	std::vector<std::vector<size_t> > row_columns(ringPattern());
+	SparseMatrixCSR A(row_columns);
+	ASSERT_TRUE(row_columns.empty());
+	ASSERT_EQ(n, A.Rows());
+
+	size_t n_entries = 0;
+	for (size_t i = 0; i < n; i++)
+	{
+		for (size_t k = A.RowBegin(i); k < A.RowEnd(i); k++)
+		{
+			// sorted without duplicates
+			if (k > A.RowBegin(i))
+			{
+				ASSERT_LT(A.Column(k - 1), A.Column(k));
+			}
+			// the mirror of (i,j) is (j,i)
+			const size_t kt = A.Transposed(k);
+			ASSERT_EQ(i, A.Column(kt));
+			ASSERT_TRUE(kt >= A.RowBegin(A.Column(k)) && kt < A.RowEnd(A.Column(k)));
+			ASSERT_EQ(k, A.Transposed(kt));
+			ASSERT_EQ(static_cast<long>(k), A.Find(i, A.Column(k)));
+			n_entries++;
+		}
+	}
+	ASSERT_EQ(n_entries, A.Size());
+	// diagonal, two ring neighbours and the long range links of 0, 5, 10, 15
+	ASSERT_EQ(3 * n + 2 * 4, A.Size());
+
+	// entries outside of the pattern
+	ASSERT_EQ(-1, A.Find(0, 3));
+	const SparseMatrixCSR& A_const(A);
+	ASSERT_EQ(0.0, A_const(0, 3));
+	// writing to them is an error
+	::testing::FLAGS_gtest_death_test_style = "threadsafe";
+	ASSERT_DEATH(A(0, 3) = 5.0, "");
+	ASSERT_EQ(-1, A.Find(0, 3));
+}
+
+TEST(MathLib, SparseMatrixCSRMultiVec)
+{
+	std::vector<std::vector<size_t> > row_columns(ringPattern());
+	SparseMatrixCSR A(row_columns);
+
+	// Non-symmetric values, and the same matrix as a dense reference
+	std::vector<double> dense(n * n, 0.0);
+	for (size_t i = 0; i < n; i++)
+	{
+		for (size_t k = A.RowBegin(i); k < A.RowEnd(i); k++)
+		{
+			const size_t j = A.Column(k);
+			const double a_ij = (i == j) ? 4.0 + 0.5 * i : -1.0 / (1.0 + i + 2.0 * j);
+			A.Value(k) = a_ij;
+			dense[i * n + j] = a_ij;
+		}
+	}
+	const SparseMatrixCSR& A_const(A);
+	for (size_t i = 0; i < n; i++)
+		for (size_t j = 0; j < n; j++)
+			ASSERT_EQ(dense[i * n + j], A_const(i, j));
+
+	const int n_vec = 3;
+	std::vector<double> x(n_vec * n), y(n_vec * n, -99.0);
+	for (size_t l = 0; l < x.size(); l++)
+		x[l] = std::sin(0.3 * l) + 0.1 * (l / n);
+
+	for (int m = 1; m <= n_vec; m++)
+	{
+		A.multiVec(&x[0], &y[0], m);
+		for (int c = 0; c < m; c++)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				double y_ref = 0.0;
+				for (size_t j = 0; j < n; j++)
+					y_ref += dense[i * n + j] * x[c * n + j];
+				ASSERT_NEAR(y_ref, y[c * n + i], 1e-14 * (1.0 + std::fabs(y_ref)));
+			}
+		}
+	}
+
+	// Reset of the values keeps the pattern
+	A = 0.0;
+	A.multiVec(&x[0], &y[0], n_vec);
+	for (size_t l = 0; l < y.size(); l++)
+		ASSERT_EQ(0.0, y[l]);
+}
+
+namespace
+{
+/// Consistent mass matrix of bilinear quads on a grid of n_cells x n_cells
+/// cells of size h
+void assembleGridMass(std::vector<std::vector<size_t> >& row_columns, SparseMatrixCSR*& M, const size_t n_cells,
+                      const double h)
+{
+	const size_t n_points = n_cells + 1;
+	const double local_mass[4][4] = {{4, 2, 1, 2}, {2, 4, 2, 1}, {1, 2, 4, 2}, {2, 1, 2, 4}};
+	row_columns.assign(n_points * n_points, std::vector<size_t>());
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (size_t j = 0; j < n_cells; j++)
+			for (size_t i = 0; i < n_cells; i++)
+			{
+				const size_t k = j * n_points + i;
+				const size_t nodes[4] = {k, k + 1, k + n_points + 1, k + n_points};
+				for (int a = 0; a < 4; a++)
+					for (int b = 0; b < 4; b++)
+					{
+						if (pass == 0)
+							row_columns[nodes[a]].push_back(nodes[b]);
+						else
+							(*M)(nodes[a], nodes[b]) += local_mass[a][b] * h * h / 36.0;
+					}
+			}
+		if (pass == 0)
+			M = new SparseMatrixCSR(row_columns);
+	}
+}
+
+/// Gaussian elimination with partial pivoting of the dense n x n system A x = b
+std::vector<double> solveDense(std::vector<double> A, std::vector<double> b)
+{
+	const size_t n = b.size();
+	for (size_t k = 0; k < n; k++)
+	{
+		size_t p = k;
+		for (size_t i = k + 1; i < n; i++)
+			if (std::fabs(A[i * n + k]) > std::fabs(A[p * n + k]))
+				p = i;
+		for (size_t j = 0; j < n; j++)
+			std::swap(A[k * n + j], A[p * n + j]);
+		std::swap(b[k], b[p]);
+		for (size_t i = k + 1; i < n; i++)
+		{
+			const double f = A[i * n + k] / A[k * n + k];
+			for (size_t j = k; j < n; j++)
+				A[i * n + j] -= f * A[k * n + j];
+			b[i] -= f * b[k];
+		}
+	}
+	std::vector<double> x(n);
+	for (size_t i = n; i-- > 0;)
+	{
+		double s = b[i];
+		for (size_t j = i + 1; j < n; j++)
+			s -= A[i * n + j] * x[j];
+		x[i] = s / A[i * n + i];
+	}
+	return x;
+}
+}
+
+TEST(MathLib, SparseMatrixCSRMultiRHSPCG)
+{
+	const size_t n_cells = 8;
+	const double h = 0.25;
+	std::vector<std::vector<size_t> > row_columns;
+	SparseMatrixCSR* M = NULL;
+	assembleGridMass(row_columns, M, n_cells, h);
+	const size_t n_nodes = M->Rows();
+	ASSERT_EQ((n_cells + 1) * (n_cells + 1), n_nodes);
+
+	// Three RHS like the velocity components of a 3D recovery, the last one
+	// is zero
+	const int n_rhs = 3;
+	std::vector<double> b(n_rhs * n_nodes, 0.0);
+	for (size_t i = 0; i < n_nodes; i++)
+	{
+		const double x = h * (i % (n_cells + 1));
+		const double y = h * (i / (n_cells + 1));
+		b[i] = 1.0 + x - 2.0 * y;
+		b[n_nodes + i] = std::sin(3.0 * x) * std::cos(y);
+	}
+
+	std::vector<double> x;
+	const int iterations = Math_Group::solvePCGMultiRHS(*M, n_rhs, b, x, 1e-14, 500);
+	ASSERT_GT(iterations, 0);
+	ASSERT_EQ(n_rhs * n_nodes, x.size());
+
+	// Reference: direct solution of the dense system
+	std::vector<double> dense(n_nodes * n_nodes, 0.0);
+	for (size_t i = 0; i < n_nodes; i++)
+		for (size_t k = M->RowBegin(i); k < M->RowEnd(i); k++)
+			dense[i * n_nodes + M->Column(k)] = M->Value(k);
+	for (int c = 0; c < 2; c++)
+	{
+		const std::vector<double> b_c(b.begin() + c * n_nodes, b.begin() + (c + 1) * n_nodes);
+		const std::vector<double> x_ref(solveDense(dense, b_c));
+		for (size_t i = 0; i < n_nodes; i++)
+			ASSERT_NEAR(x_ref[i], x[c * n_nodes + i], 1e-9 * (1.0 + std::fabs(x_ref[i])));
+	}
+	for (size_t i = 0; i < n_nodes; i++)
+		ASSERT_EQ(0.0, x[2 * n_nodes + i]);
+
+	// Not converged
+	ASSERT_EQ(-1, Math_Group::solvePCGMultiRHS(*M, n_rhs, b, x, 1e-14, 1));
+	delete M;
+}
+
+TEST(MathLib, SparseMatrixCSRLumpedMass)
+{
+	const size_t n_cells = 6;
+	const double h = 0.5;
+	std::vector<std::vector<size_t> > row_columns;
+	SparseMatrixCSR* M = NULL;
+	assembleGridMass(row_columns, M, n_cells, h);
+	const size_t n_nodes = M->Rows();
+
+	std::vector<double> lumped;
+	M->RowSums(lumped);
+	ASSERT_EQ(n_nodes, lumped.size());
+	double area = 0.0;
+	for (size_t i = 0; i < n_nodes; i++)
+		area += lumped[i];
+	ASSERT_NEAR(n_cells * h * n_cells * h, area, 1e-12);
+
+	// A constant field is recovered exactly by the lumped and by the
+	// consistent mass matrix
+	std::vector<double> v(n_nodes, 2.5), b(n_nodes);
+	M->multiVec(&v[0], &b[0]);
+	std::vector<double> x;
+	ASSERT_GT(Math_Group::solvePCGMultiRHS(*M, 1, b, x, 1e-14, 200), 0);
+	for (size_t i = 0; i < n_nodes; i++)
+	{
+		ASSERT_NEAR(2.5, b[i] / lumped[i], 1e-14);
+		ASSERT_NEAR(2.5, x[i], 1e-12);
+	}
+	delete M;
+}